@@ -12,6 +12,8 @@ public:
 
     Message(const std::vector<char> &v) : read_offset(0), blob(v) {}
 
+    Message(const char* begin, const char* end) : read_offset(0), blob(begin, end) {}
+
     char* data() {return blob.data();}
     const char* data() const {return blob.data();}
     size_t size() const {return blob.size();}
@@ -433,8 +433,26 @@ class MessagePasser {
 
     std::map<int, Message> Exchange(std::map<int, Message>& stuff_for_other_ranks) const;
 
+    // Collective MPI-IO on a file opened on this communicator.  Every rank
+    // passes its own offset and byte count (which may be zero).  MPI counts
+    // are ints, so large requests go in several calls; ranks with less to do
+    // make empty calls until every rank is finished.
+    void WriteAtAll(MPI_File f, long offset, const void* data, long bytes) const;
+    void ReadAtAll(MPI_File f, long offset, void* data, long bytes) const;
+
+    // How Exchange moves data.  AllToAll is one MPI_Alltoallv after an
+    // all-to-all of counts.  Sparse discovers senders with non-blocking
+    // synchronous sends and a non-blocking barrier, so no rank handles a count
+    // from every other rank.  Hierarchical aggregates messages through one
+    // leader rank per shared-memory node.  Automatic picks one from the
+    // communication pattern on large communicators.
+    enum class ExchangeAlgorithm { Automatic, AllToAll, Sparse, Hierarchical };
+    void setExchangeAlgorithm(ExchangeAlgorithm algorithm) { exchange_algorithm = algorithm; }
+    ExchangeAlgorithm exchangeAlgorithm() const { return exchange_algorithm; }
+
   private:
     MPI_Comm communicator;
+    ExchangeAlgorithm exchange_algorithm = ExchangeAlgorithm::Automatic;
     static std::stack<MPI_Datatype>& typeStack() {
         static std::stack<MPI_Datatype> ts;
         return ts;
@@ -449,6 +467,29 @@ class MessagePasser {
     template <typename T>
     std::vector<T> getRecvBuffer(const std::vector<int>& recv_counts) const;
     std::vector<int> getDisplacementsFromCounts(const std::vector<int>& counts) const;
+    Message ExchangeBytes(const Message& send_buffer,
+                          const std::vector<int>& send_counts,
+                          std::vector<int>& recv_counts) const;
+    template <typename T>
+    std::vector<T> exchangeBuffer(std::vector<T>&& send_buffer,
+                                  const std::vector<int>& send_counts,
+                                  std::vector<int>& recv_counts) const;
+
+    struct ExchangeState;
+    ExchangeState& exchangeState() const;
+    ExchangeState& nodeTopology() const;
+    ExchangeAlgorithm chooseExchangeAlgorithm(const std::vector<long>& send_bytes) const;
+    Message exchangeBytes(ExchangeAlgorithm algorithm,
+                          const char* send_buffer,
+                          const std::vector<long>& send_bytes,
+                          std::vector<long>& recv_bytes) const;
+    Message exchangeBytesSparse(const char* send_buffer,
+                                const std::vector<long>& send_bytes,
+                                std::vector<long>& recv_bytes) const;
+    Message exchangeBytesHierarchical(const char* send_buffer,
+                                      const std::vector<long>& send_bytes,
+                                      std::vector<long>& recv_bytes) const;
+    Message concatenateInRankOrder(std::vector<std::vector<char>>& from_ranks, std::vector<long>& recv_bytes) const;
     template <typename T>
     std::vector<std::vector<T>> convertToVectorOfVectors(const std::vector<T>& recv_buffer,
                                                          const std::vector<int>& recv_counts) const;
@@ -457,6 +498,9 @@ class MessagePasser {
 
     template <typename Packable>
     struct MapPacker;
+
+    template <typename ChunkIO>
+    void forEachCollectiveChunk(long bytes, ChunkIO chunk_io) const;
 };
 
 #define mp_rootprint(...)        \
@@ -478,3 +522,5 @@ class MessagePasser {
 #include "MessagePasser.hpp"
 #include "MessagePasserGathers.hpp"
 #include "MessagePasserAllToAll.hpp"
+#include "MessagePasserExchangeAlgorithms.hpp"
+#include "MessagePasserFileIO.hpp"
@@ -3,40 +3,43 @@
 template <typename T>
 std::vector<std::vector<T>> MessagePasser::Exchange(std::vector<std::vector<T>>&& stuff_for_other_ranks) const {
     auto send_counts = getSendCounts(stuff_for_other_ranks);
-    auto recv_counts = getRecvCounts(send_counts);
     auto send_buffer = getSendBuffer(stuff_for_other_ranks, send_counts);
     stuff_for_other_ranks.clear();
     stuff_for_other_ranks.shrink_to_fit();
-    auto recv_buffer = getRecvBuffer<T>(recv_counts);
-    auto send_displacements = getDisplacementsFromCounts(send_counts);
-    auto recv_displacements = getDisplacementsFromCounts(recv_counts);
-    auto return_type = Type(T());
-    MPI_Alltoallv(send_buffer.data(),
-                  send_counts.data(),
-                  send_displacements.data(),
-                  return_type,
-                  recv_buffer.data(),
-                  recv_counts.data(),
-                  recv_displacements.data(),
-                  return_type,
-                  communicator);
-    send_buffer.clear();
-    send_buffer.shrink_to_fit();
-    send_counts.clear();
-    send_counts.shrink_to_fit();
-    send_displacements.clear();
-    send_displacements.shrink_to_fit();
-    recv_displacements.clear();
-    recv_displacements.shrink_to_fit();
-    freeIfCustomType(return_type);
+    std::vector<int> recv_counts;
+    auto recv_buffer = exchangeBuffer(std::move(send_buffer), send_counts, recv_counts);
     return convertToVectorOfVectors(recv_buffer, recv_counts);
 }
 
 template <typename T>
 std::vector<std::vector<T>> MessagePasser::Exchange(const std::vector<std::vector<T>>& stuff_for_other_ranks) const {
     auto send_counts = getSendCounts(stuff_for_other_ranks);
-    auto recv_counts = getRecvCounts(send_counts);
     auto send_buffer = getSendBuffer(stuff_for_other_ranks, send_counts);
+    std::vector<int> recv_counts;
+    auto recv_buffer = exchangeBuffer(std::move(send_buffer), send_counts, recv_counts);
+    return convertToVectorOfVectors(recv_buffer, recv_counts);
+}
+
+template <typename T>
+std::vector<T> MessagePasser::exchangeBuffer(std::vector<T>&& send_buffer,
+                                             const std::vector<int>& send_counts,
+                                             std::vector<int>& recv_counts) const {
+    std::vector<long> send_bytes(send_counts.begin(), send_counts.end());
+    for (auto& bytes : send_bytes) bytes *= long(sizeof(T));
+    auto algorithm = chooseExchangeAlgorithm(send_bytes);
+    if (ExchangeAlgorithm::AllToAll != algorithm) {
+        std::vector<long> recv_bytes;
+        auto bytes = exchangeBytes(algorithm, reinterpret_cast<const char*>(send_buffer.data()), send_bytes, recv_bytes);
+        send_buffer.clear();
+        send_buffer.shrink_to_fit();
+        recv_counts.resize(recv_bytes.size());
+        for (size_t rank = 0; rank < recv_bytes.size(); rank++) recv_counts[rank] = bigToInt(recv_bytes[rank] / long(sizeof(T)));
+        std::vector<T> recv_buffer(bytes.size() / sizeof(T));
+        if (not recv_buffer.empty()) memcpy(static_cast<void*>(recv_buffer.data()), bytes.data(), bytes.size());
+        return recv_buffer;
+    }
+
+    recv_counts = getRecvCounts(send_counts);
     auto recv_buffer = getRecvBuffer<T>(recv_counts);
     auto send_displacements = getDisplacementsFromCounts(send_counts);
     auto recv_displacements = getDisplacementsFromCounts(recv_counts);
@@ -52,16 +55,17 @@ std::vector<std::vector<T>> MessagePasser::Exchange(const std::vector<std::vecto
                   communicator);
     send_buffer.clear();
     send_buffer.shrink_to_fit();
-    send_counts.clear();
-    send_counts.shrink_to_fit();
     send_displacements.clear();
     send_displacements.shrink_to_fit();
     recv_displacements.clear();
     recv_displacements.shrink_to_fit();
     freeIfCustomType(return_type);
-    return convertToVectorOfVectors(recv_buffer, recv_counts);
+    return recv_buffer;
 }
 
+// Packers write straight into one send buffer in rank order, and unpackers
+// read each rank's bytes in order from one receive buffer, so an unpacker must
+// consume exactly what its packer wrote.
 template <typename Packable>
 struct MessagePasser::MapPacker {
     template <typename Packer, typename UnPacker>
@@ -69,17 +73,19 @@ struct MessagePasser::MapPacker {
                                             const std::map<int, Packable>& stuff_for_other_ranks,
                                             Packer packer,
                                             UnPacker unpacker) {
-        std::map<int, std::vector<char>> chars_for_ranks;
+        std::vector<int> send_counts(mp.NumberOfProcesses(), 0);
+        MessagePasser::Message send_buffer;
         for (const auto& stuff : stuff_for_other_ranks) {
-            MessagePasser::Message msg(stuff.second, packer);
-            chars_for_ranks[stuff.first] = {msg.data(), msg.data() + msg.size()};
+            size_t start = send_buffer.size();
+            packer(send_buffer, stuff.second);
+            send_counts[stuff.first] = bigToInt(send_buffer.size() - start);
         }
-        auto chars_from_ranks = mp.Exchange(chars_for_ranks);
+        std::vector<int> recv_counts;
+        auto recv_buffer = mp.ExchangeBytes(send_buffer, send_counts, recv_counts);
+        send_buffer = MessagePasser::Message();
         std::map<int, Packable> stuff_from_other_ranks;
-        for (auto& chars : chars_from_ranks) {
-            MessagePasser::Message msg(chars.second);
-            msg.unpack(stuff_from_other_ranks[chars.first], unpacker);
-        }
+        for (int rank = 0; rank < mp.NumberOfProcesses(); rank++)
+            if (recv_counts[rank] > 0) recv_buffer.unpack(stuff_from_other_ranks[rank], unpacker);
         return stuff_from_other_ranks;
     }
 };
@@ -91,29 +97,32 @@ struct MessagePasser::MapPacker<std::vector<Packable>> {
                                                          const std::map<int, std::vector<Packable>>& stuff_to_swap,
                                                          Packer packer,
                                                          UnPacker unpacker) {
-        std::map<int, MessagePasser::Message> messages_to_exchange;
+        std::vector<int> send_counts(mp.NumberOfProcesses(), 0);
+        MessagePasser::Message send_buffer;
         for (auto& pair : stuff_to_swap) {
-            messages_to_exchange[pair.first] = MessagePasser::Message();
-            auto& m = messages_to_exchange[pair.first];
+            size_t start = send_buffer.size();
             unsigned long count = pair.second.size();
-            m.pack(count);
+            send_buffer.pack(count);
             for (const Packable& t : pair.second) {
-                packer(m, t);
+                packer(send_buffer, t);
             }
+            send_counts[pair.first] = bigToInt(send_buffer.size() - start);
         }
-
-        messages_to_exchange = mp.Exchange(messages_to_exchange);
+        std::vector<int> recv_counts;
+        auto recv_buffer = mp.ExchangeBytes(send_buffer, send_counts, recv_counts);
+        send_buffer = MessagePasser::Message();
 
         std::map<int, std::vector<Packable>> out;
-        for (auto& pair : messages_to_exchange) {
-            int rank = pair.first;
-            auto& m = pair.second;
+        for (int rank = 0; rank < mp.NumberOfProcesses(); rank++) {
+            if (0 == recv_counts[rank]) continue;
             unsigned long count = 0;
-            m.unpack(count);
+            recv_buffer.unpack(count);
+            auto& stuff = out[rank];
+            stuff.reserve(count);
             for (unsigned long i = 0; i < count; i++) {
                 Packable t;
-                unpacker(m, t);
-                out[rank].push_back(t);
+                unpacker(recv_buffer, t);
+                stuff.push_back(t);
             }
         }
         return out;
@@ -129,20 +138,54 @@ std::map<int, Packable> MessagePasser::Exchange(const std::map<int, Packable>& s
 
 inline std::map<int, MessagePasser::Message> MessagePasser::Exchange(
     std::map<int, Message>& stuff_for_selected_ranks) const {
-    std::map<int, std::vector<char>> chars_for_ranks;
+    std::vector<int> send_counts(NumberOfProcesses(), 0);
+    Message send_buffer;
     for (const auto& stuff : stuff_for_selected_ranks) {
         auto& msg = stuff.second;
-        chars_for_ranks[stuff.first] = {msg.data(), msg.data() + msg.size()};
+        send_buffer.pack(msg.data(), msg.size());
+        send_counts[stuff.first] = bigToInt(msg.size());
     }
-    auto chars_from_ranks = Exchange(chars_for_ranks);
+    std::vector<int> recv_counts;
+    auto recv_buffer = ExchangeBytes(send_buffer, send_counts, recv_counts);
+    send_buffer = Message();
     std::map<int, Message> stuff_from_other_ranks;
-    for (auto& chars : chars_from_ranks) {
-        MessagePasser::Message msg(chars.second);
-        stuff_from_other_ranks[chars.first] = msg;
+    const char* begin = recv_buffer.data();
+    for (int rank = 0; rank < NumberOfProcesses(); rank++) {
+        if (recv_counts[rank] > 0) stuff_from_other_ranks[rank] = Message(begin, begin + recv_counts[rank]);
+        begin += recv_counts[rank];
     }
     return stuff_from_other_ranks;
 }
 
+inline MessagePasser::Message MessagePasser::ExchangeBytes(const Message& send_buffer,
+                                                           const std::vector<int>& send_counts,
+                                                           std::vector<int>& recv_counts) const {
+    std::vector<long> send_bytes(send_counts.begin(), send_counts.end());
+    auto algorithm = chooseExchangeAlgorithm(send_bytes);
+    if (ExchangeAlgorithm::AllToAll != algorithm) {
+        std::vector<long> recv_bytes;
+        auto recv_buffer = exchangeBytes(algorithm, send_buffer.data(), send_bytes, recv_bytes);
+        recv_counts.resize(recv_bytes.size());
+        for (size_t rank = 0; rank < recv_bytes.size(); rank++) recv_counts[rank] = bigToInt(recv_bytes[rank]);
+        return recv_buffer;
+    }
+    recv_counts = getRecvCounts(send_counts);
+    auto send_displacements = getDisplacementsFromCounts(send_counts);
+    auto recv_displacements = getDisplacementsFromCounts(recv_counts);
+    Message recv_buffer;
+    recv_buffer.resize(size_t(recv_displacements.back()) + recv_counts.back());
+    MPI_Alltoallv(send_buffer.data(),
+                  send_counts.data(),
+                  send_displacements.data(),
+                  MPI_CHAR,
+                  recv_buffer.data(),
+                  recv_counts.data(),
+                  recv_displacements.data(),
+                  MPI_CHAR,
+                  communicator);
+    return recv_buffer;
+}
+
 template <typename Id, typename T>
 std::map<Id, std::vector<T>> MessagePasser::Exchange(
     const std::map<Id, std::vector<T>>& stuff_for_selected_ranks) const {
@@ -0,0 +1,280 @@
+#pragma once
+
+// Per-communicator state for the sparse and hierarchical exchanges, cached on
+// the communicator as an MPI attribute so every MessagePasser built on the same
+// communicator shares it, and it is freed along with the communicator.
+struct MessagePasser::ExchangeState {
+    // Consecutive sparse exchanges alternate between two tags, so a rank that
+    // has already moved on cannot have its messages received by a rank that is
+    // still finishing the previous exchange.
+    int sparse_epoch = 0;
+
+    bool has_node_topology = false;
+    MPI_Comm node_comm = MPI_COMM_NULL;
+    MPI_Comm leader_comm = MPI_COMM_NULL;
+    int node_count = 0;
+    std::vector<int> node_of_rank;
+    std::vector<int> rank_on_node;
+
+    static int deleteAttribute(MPI_Comm comm, int keyval, void* value, void* extra_state) {
+        auto state = static_cast<ExchangeState*>(value);
+        if (MPI_COMM_NULL != state->node_comm) MPI_Comm_free(&state->node_comm);
+        if (MPI_COMM_NULL != state->leader_comm) MPI_Comm_free(&state->leader_comm);
+        delete state;
+        return MPI_SUCCESS;
+    }
+};
+
+inline MessagePasser::ExchangeState& MessagePasser::exchangeState() const {
+    static int keyval = [] {
+        int k = MPI_KEYVAL_INVALID;
+        MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, ExchangeState::deleteAttribute, &k, nullptr);
+        return k;
+    }();
+    void* value = nullptr;
+    int found = 0;
+    MPI_Comm_get_attr(communicator, keyval, &value, &found);
+    if (found) return *static_cast<ExchangeState*>(value);
+    auto state = new ExchangeState;
+    MPI_Comm_set_attr(communicator, keyval, state);
+    return *state;
+}
+
+// Collective.  Splits the communicator into one communicator per shared-memory
+// node and one communicator of node leaders (node rank 0).
+inline MessagePasser::ExchangeState& MessagePasser::nodeTopology() const {
+    auto& state = exchangeState();
+    if (state.has_node_topology) return state;
+    MPI_Comm_split_type(communicator, MPI_COMM_TYPE_SHARED, Rank(), MPI_INFO_NULL, &state.node_comm);
+    int node_rank = 0;
+    MPI_Comm_rank(state.node_comm, &node_rank);
+    MPI_Comm_split(communicator, 0 == node_rank ? 0 : MPI_UNDEFINED, Rank(), &state.leader_comm);
+    int node = 0;
+    if (0 == node_rank) MPI_Comm_rank(state.leader_comm, &node);
+    MPI_Bcast(&node, 1, MPI_INT, 0, state.node_comm);
+
+    int mine[2] = {node, node_rank};
+    std::vector<int> all(2 * NumberOfProcesses());
+    MPI_Allgather(mine, 2, MPI_INT, all.data(), 2, MPI_INT, communicator);
+    state.node_of_rank.resize(NumberOfProcesses());
+    state.rank_on_node.resize(NumberOfProcesses());
+    for (int rank = 0; rank < NumberOfProcesses(); rank++) {
+        state.node_of_rank[rank] = all[2 * rank];
+        state.rank_on_node[rank] = all[2 * rank + 1];
+        state.node_count = std::max(state.node_count, state.node_of_rank[rank] + 1);
+    }
+    state.has_node_topology = true;
+    return state;
+}
+
+// Below a few dozen ranks the flat all-to-all is always cheap, so Automatic
+// does not spend a reduction deciding.  Above that, patterns where every rank
+// talks to at most 1/16 of the others use the sparse exchange, and dense
+// patterns of small messages are aggregated per node.
+inline MessagePasser::ExchangeAlgorithm MessagePasser::chooseExchangeAlgorithm(const std::vector<long>& send_bytes) const {
+    if (ExchangeAlgorithm::Automatic != exchange_algorithm) return exchange_algorithm;
+    const int min_ranks_to_choose = 64;
+    const long sparse_fraction = 16;
+    const long small_message_bytes = 4096;
+    int nranks = NumberOfProcesses();
+    if (nranks < min_ranks_to_choose) return ExchangeAlgorithm::AllToAll;
+
+    long pattern[2] = {0, 0};
+    for (long bytes : send_bytes) {
+        if (bytes > 0) pattern[0]++;
+        pattern[1] = std::max(pattern[1], bytes);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, pattern, 2, MPI_LONG, MPI_MAX, communicator);
+    long max_destinations = pattern[0];
+    long max_message_bytes = pattern[1];
+    if (max_destinations * sparse_fraction <= nranks) return ExchangeAlgorithm::Sparse;
+    if (max_message_bytes <= small_message_bytes) {
+        auto& topology = nodeTopology();
+        if (topology.node_count > 1 and topology.node_count < nranks) return ExchangeAlgorithm::Hierarchical;
+    }
+    return ExchangeAlgorithm::AllToAll;
+}
+
+inline MessagePasser::Message MessagePasser::exchangeBytes(ExchangeAlgorithm algorithm,
+                                                           const char* send_buffer,
+                                                           const std::vector<long>& send_bytes,
+                                                           std::vector<long>& recv_bytes) const {
+    if (ExchangeAlgorithm::Sparse == algorithm) return exchangeBytesSparse(send_buffer, send_bytes, recv_bytes);
+    return exchangeBytesHierarchical(send_buffer, send_bytes, recv_bytes);
+}
+
+inline MessagePasser::Message MessagePasser::concatenateInRankOrder(std::vector<std::vector<char>>& from_ranks,
+                                                                    std::vector<long>& recv_bytes) const {
+    recv_bytes.assign(from_ranks.size(), 0);
+    size_t total = 0;
+    for (auto& bytes : from_ranks) total += bytes.size();
+    Message recv_buffer;
+    recv_buffer.resize(total);
+    size_t offset = 0;
+    for (size_t rank = 0; rank < from_ranks.size(); rank++) {
+        auto& bytes = from_ranks[rank];
+        if (not bytes.empty()) memcpy(recv_buffer.data() + offset, bytes.data(), bytes.size());
+        recv_bytes[rank] = long(bytes.size());
+        offset += bytes.size();
+        std::vector<char>().swap(bytes);
+    }
+    return recv_buffer;
+}
+
+// Sparse data exchange without a count all-to-all (Hoefler, Siebert and
+// Lumsdaine's NBX).  Each rank sends synchronously to its destinations and
+// receives whatever arrives; once its own sends have all been matched it
+// enters a non-blocking barrier, and when the barrier completes every message
+// has been received.
+inline MessagePasser::Message MessagePasser::exchangeBytesSparse(const char* send_buffer,
+                                                                 const std::vector<long>& send_bytes,
+                                                                 std::vector<long>& recv_bytes) const {
+    const int first_sparse_exchange_tag = 31000;
+    auto& state = exchangeState();
+    int tag = first_sparse_exchange_tag + state.sparse_epoch;
+    state.sparse_epoch = 1 - state.sparse_epoch;
+
+    std::vector<MPI_Request> sends;
+    long offset = 0;
+    for (int rank = 0; rank < NumberOfProcesses(); rank++) {
+        if (send_bytes[rank] > 0) {
+            sends.emplace_back();
+            MPI_Issend(send_buffer + offset, bigToInt(send_bytes[rank]), MPI_CHAR, rank, tag, communicator, &sends.back());
+        }
+        offset += send_bytes[rank];
+    }
+
+    std::vector<std::vector<char>> from_ranks(NumberOfProcesses());
+    MPI_Request barrier;
+    bool in_barrier = false;
+    while (true) {
+        int has_message = 0;
+        MPI_Status status;
+        MPI_Iprobe(MPI_ANY_SOURCE, tag, communicator, &has_message, &status);
+        if (has_message) {
+            int n = 0;
+            MPI_Get_count(&status, MPI_CHAR, &n);
+            auto& bytes = from_ranks[status.MPI_SOURCE];
+            bytes.resize(n);
+            MPI_Recv(bytes.data(), n, MPI_CHAR, status.MPI_SOURCE, tag, communicator, MPI_STATUS_IGNORE);
+        }
+        if (in_barrier) {
+            int done = 0;
+            MPI_Test(&barrier, &done, MPI_STATUS_IGNORE);
+            if (done) break;
+        } else {
+            int sent = 0;
+            MPI_Testall(int(sends.size()), sends.data(), &sent, MPI_STATUSES_IGNORE);
+            if (sent) {
+                MPI_Ibarrier(communicator, &barrier);
+                in_barrier = true;
+            }
+        }
+    }
+    return concatenateInRankOrder(from_ranks, recv_bytes);
+}
+
+// Two-level exchange.  Ranks hand their messages to their node leader, leaders
+// exchange one aggregated message per node pair, and each leader hands the
+// messages for its node's ranks back out.  Messages travel as records of
+// (source rank, destination rank, byte count, bytes).
+inline MessagePasser::Message MessagePasser::exchangeBytesHierarchical(const char* send_buffer,
+                                                                       const std::vector<long>& send_bytes,
+                                                                       std::vector<long>& recv_bytes) const {
+    struct Header {
+        int source;
+        int destination;
+        long bytes;
+    };
+    auto append = [](std::vector<char>& records, const Header& header, const char* bytes) {
+        size_t offset = records.size();
+        records.resize(offset + sizeof(Header) + header.bytes);
+        memcpy(records.data() + offset, &header, sizeof(Header));
+        memcpy(records.data() + offset + sizeof(Header), bytes, header.bytes);
+    };
+    auto forEachRecord = [](const std::vector<char>& records, auto f) {
+        size_t offset = 0;
+        while (offset < records.size()) {
+            Header header;
+            memcpy(&header, records.data() + offset, sizeof(Header));
+            f(header, records.data() + offset + sizeof(Header));
+            offset += sizeof(Header) + header.bytes;
+        }
+    };
+    auto gathervBytes = [](const std::vector<char>& mine, MPI_Comm comm) {
+        int size = 0, rank = 0;
+        MPI_Comm_size(comm, &size);
+        MPI_Comm_rank(comm, &rank);
+        int count = bigToInt(mine.size());
+        std::vector<int> counts(size, 0);
+        MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, comm);
+        std::vector<int> displacements(size, 0);
+        for (int i = 1; i < size; i++) displacements[i] = bigToInt(long(displacements[i - 1]) + counts[i - 1]);
+        std::vector<char> all(0 == rank ? size_t(displacements.back()) + counts.back() : 0);
+        MPI_Gatherv(mine.data(), count, MPI_CHAR, all.data(), counts.data(), displacements.data(), MPI_CHAR, 0, comm);
+        return all;
+    };
+    auto scattervBytes = [](const std::vector<std::vector<char>>& for_ranks, MPI_Comm comm) {
+        int size = 0, rank = 0;
+        MPI_Comm_size(comm, &size);
+        MPI_Comm_rank(comm, &rank);
+        std::vector<int> counts(size, 0);
+        std::vector<int> displacements(size, 0);
+        std::vector<char> all;
+        if (0 == rank) {
+            for (int i = 0; i < size; i++) {
+                counts[i] = bigToInt(for_ranks[i].size());
+                if (i > 0) displacements[i] = bigToInt(long(displacements[i - 1]) + counts[i - 1]);
+                all.insert(all.end(), for_ranks[i].begin(), for_ranks[i].end());
+            }
+        }
+        int count = 0;
+        MPI_Scatter(counts.data(), 1, MPI_INT, &count, 1, MPI_INT, 0, comm);
+        std::vector<char> mine(count);
+        MPI_Scatterv(all.data(), counts.data(), displacements.data(), MPI_CHAR, mine.data(), count, MPI_CHAR, 0, comm);
+        return mine;
+    };
+
+    auto& topology = nodeTopology();
+    int rank = Rank();
+
+    std::vector<char> outgoing;
+    long offset = 0;
+    for (int destination = 0; destination < NumberOfProcesses(); destination++) {
+        if (send_bytes[destination] > 0)
+            append(outgoing, {rank, destination, send_bytes[destination]}, send_buffer + offset);
+        offset += send_bytes[destination];
+    }
+    auto from_node = gathervBytes(outgoing, topology.node_comm);
+    std::vector<char>().swap(outgoing);
+
+    std::vector<std::vector<char>> for_local_ranks;
+    if (MPI_COMM_NULL != topology.leader_comm) {
+        std::vector<std::vector<char>> for_nodes(topology.node_count);
+        forEachRecord(from_node, [&](const Header& header, const char* bytes) {
+            append(for_nodes[topology.node_of_rank[header.destination]], header, bytes);
+        });
+        std::vector<char>().swap(from_node);
+        MessagePasser leaders(topology.leader_comm);
+        auto from_nodes = leaders.Exchange(std::move(for_nodes));
+
+        int node_size = 0;
+        MPI_Comm_size(topology.node_comm, &node_size);
+        for_local_ranks.resize(node_size);
+        for (auto& records : from_nodes) {
+            forEachRecord(records, [&](const Header& header, const char* bytes) {
+                append(for_local_ranks[topology.rank_on_node[header.destination]], header, bytes);
+            });
+            std::vector<char>().swap(records);
+        }
+    }
+
+    auto incoming = scattervBytes(for_local_ranks, topology.node_comm);
+    std::vector<std::vector<char>>().swap(for_local_ranks);
+
+    std::vector<std::vector<char>> from_ranks(NumberOfProcesses());
+    forEachRecord(incoming, [&](const Header& header, const char* bytes) {
+        from_ranks[header.source].assign(bytes, bytes + header.bytes);
+    });
+    return concatenateInRankOrder(from_ranks, recv_bytes);
+}
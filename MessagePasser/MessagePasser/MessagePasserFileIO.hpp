@@ -0,0 +1,28 @@
+#pragma once
+#include <algorithm>
+
+// chunk_io(start, n) moves bytes [start, start + n) of this rank's request.
+// Every rank makes the same number of calls.
+template <typename ChunkIO>
+void MessagePasser::forEachCollectiveChunk(long bytes, ChunkIO chunk_io) const {
+    const long max_bytes_per_call = 1l << 30;
+    long calls = ParallelMax((bytes + max_bytes_per_call - 1) / max_bytes_per_call);
+    for (long call = 0; call < calls; call++) {
+        long start = std::min(bytes, call * max_bytes_per_call);
+        chunk_io(start, int(std::min(bytes - start, max_bytes_per_call)));
+    }
+}
+
+inline void MessagePasser::WriteAtAll(MPI_File f, long offset, const void* data, long bytes) const {
+    auto begin = static_cast<const char*>(data);
+    forEachCollectiveChunk(bytes, [&](long start, int n) {
+        MPI_File_write_at_all(f, offset + start, begin + start, n, MPI_BYTE, MPI_STATUS_IGNORE);
+    });
+}
+
+inline void MessagePasser::ReadAtAll(MPI_File f, long offset, void* data, long bytes) const {
+    auto begin = static_cast<char*>(data);
+    forEachCollectiveChunk(bytes, [&](long start, int n) {
+        MPI_File_read_at_all(f, offset + start, begin + start, n, MPI_BYTE, MPI_STATUS_IGNORE);
+    });
+}
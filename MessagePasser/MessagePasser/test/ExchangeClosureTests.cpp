@@ -55,4 +55,36 @@ TEST_CASE("Exchange messages"){
             REQUIRE(stuff[rank][999].count(rank) == 1);
         }
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Exchange packables of different sizes with every other rank"){
+    MessagePasser mp(MPI_COMM_WORLD);
+    std::map<int, std::set<long>> sets_for_ranks;
+    std::map<int, std::vector<int>> vectors_for_ranks;
+    for(int rank=0;rank<mp.NumberOfProcesses();rank++) {
+        if(rank == mp.Rank() and mp.NumberOfProcesses() > 1) continue;
+        for(int i=0;i<rank+mp.Rank()+1;i++) {
+            sets_for_ranks[rank].insert(1000*mp.Rank()+i);
+            vectors_for_ranks[rank].push_back(1000*mp.Rank()+i);
+        }
+    }
+
+    auto set_packer = [](MessagePasser::Message& msg, const std::set<long>& s){ msg.pack(s); };
+    auto set_unpacker = [](MessagePasser::Message& msg, std::set<long>& s){ msg.unpack(s); };
+    auto sets = mp.Exchange(sets_for_ranks,set_packer,set_unpacker);
+
+    auto int_packer = [](MessagePasser::Message& msg, int i){ msg.pack(i); };
+    auto int_unpacker = [](MessagePasser::Message& msg, int& i){ msg.unpack(i); };
+    auto vectors = mp.Exchange(vectors_for_ranks,int_packer,int_unpacker);
+
+    int expected_sources = mp.NumberOfProcesses() > 1 ? mp.NumberOfProcesses()-1 : 1;
+    REQUIRE(expected_sources == int(sets.size()));
+    REQUIRE(expected_sources == int(vectors.size()));
+    for(auto& pair:sets){
+        int rank = pair.first;
+        REQUIRE(size_t(rank+mp.Rank()+1) == pair.second.size());
+        REQUIRE(1000*rank == *pair.second.begin());
+        REQUIRE(pair.second.size() == vectors.at(rank).size());
+        for(size_t i=0;i<vectors[rank].size();i++)
+            REQUIRE(1000*rank+int(i) == vectors[rank][i]);
+    }
+}
@@ -0,0 +1,28 @@
+#include "../MessagePasser.h"
+#include <RingAssertions.h>
+
+TEST_CASE("Collective write and read at offsets in rank order") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    std::string filename = "message-passer-file-io-test.bin";
+    std::vector<long> mine(mp.Rank() + 1, long(mp.Rank()));
+    long offset = 0;
+    for (int r = 0; r < mp.Rank(); r++) offset += (r + 1) * sizeof(long);
+
+    MPI_File f;
+    MPI_File_open(mp.getCommunicator(), filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &f);
+    MPI_File_set_size(f, 0);
+    mp.WriteAtAll(f, offset, mine.data(), mine.size() * sizeof(long));
+    MPI_File_close(&f);
+
+    std::vector<long> read_back(mine.size(), -1);
+    MPI_File_open(mp.getCommunicator(), filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &f);
+    mp.ReadAtAll(f, offset, read_back.data(), read_back.size() * sizeof(long));
+    long nothing = -1;
+    mp.ReadAtAll(f, 0, &nothing, 0);
+    MPI_File_close(&f);
+    mp.Barrier();
+    if (0 == mp.Rank()) MPI_File_delete(filename.c_str(), MPI_INFO_NULL);
+
+    REQUIRE(mine == read_back);
+    REQUIRE(-1 == nothing);
+}
@@ -114,3 +114,36 @@ TEST_CASE("Exchange arbitrary contiguous data") {
         }
     }
 }
+
+TEST_CASE("Every exchange algorithm delivers the same data") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    int nranks = mp.NumberOfProcesses();
+    auto stuffFor = [&](int round) {
+        std::vector<std::vector<long>> stuff(nranks);
+        for (int rank = 0; rank < nranks; rank++) {
+            if ((mp.Rank() + rank + round) % 3 == 0) continue;
+            for (int i = 0; i < (mp.Rank() * 7 + rank + round) % 5; i++) stuff[rank].push_back(1000 * mp.Rank() + 10 * rank + i);
+        }
+        return stuff;
+    };
+
+    MessagePasser all_to_all(MPI_COMM_WORLD);
+    all_to_all.setExchangeAlgorithm(MessagePasser::ExchangeAlgorithm::AllToAll);
+    for (auto algorithm : {MessagePasser::ExchangeAlgorithm::Sparse, MessagePasser::ExchangeAlgorithm::Hierarchical}) {
+        MessagePasser other(MPI_COMM_WORLD);
+        other.setExchangeAlgorithm(algorithm);
+        for (int round = 0; round < 3; round++) {
+            REQUIRE(all_to_all.Exchange(stuffFor(round)) == other.Exchange(stuffFor(round)));
+        }
+
+        std::map<int, std::string> words;
+        words[(mp.Rank() + 1) % nranks] = "from " + std::to_string(mp.Rank());
+        auto packer = [](MessagePasser::Message& m, const std::string& s) { m.pack(s); };
+        auto unpacker = [](MessagePasser::Message& m, std::string& s) { m.unpack(s); };
+        auto expected = all_to_all.Exchange(words, packer, unpacker);
+        auto actual = other.Exchange(words, packer, unpacker);
+        REQUIRE(expected == actual);
+        int left = calcLeftNeighbor(mp.Rank(), nranks);
+        REQUIRE("from " + std::to_string(left) == actual.at(left));
+    }
+}
@@ -4,11 +4,89 @@
 #include <array>
 #include <stack>
 #include <ostream>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
 
 namespace Linearize {
 
+// How the reverse sweep handles the adjoint of one gradient: a double for a
+// single direction, std::array<double, N> for N directions per pass over the
+// tape (StackSimd.h adds simd::simd).
+template <typename Lane>
+struct AdjointLane {
+    static Lane zero() { return 0.0; }
+    static bool isZero(const Lane& g) { return g == 0.0; }
+    static void accumulate(Lane& sum, double multiplier, const Lane& g) { sum += multiplier * g; }
+};
+
+template <size_t N>
+struct AdjointLane<std::array<double, N>> {
+    static std::array<double, N> zero() { return {}; }
+    static bool isZero(const std::array<double, N>& g) {
+        for (size_t i = 0; i < N; ++i)
+            if (g[i] != 0.0) return false;
+        return true;
+    }
+    static void accumulate(std::array<double, N>& sum, double multiplier, const std::array<double, N>& g) {
+        for (size_t i = 0; i < N; ++i) sum[i] += multiplier * g[i];
+    }
+};
+
+class ThreadBarrier {
+  public:
+    explicit ThreadBarrier(int count) : count(count) {}
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        int arrival_generation = generation;
+        if (++waiting == count) {
+            waiting = 0;
+            generation++;
+            condition.notify_all();
+        } else {
+            condition.wait(lock, [&] { return arrival_generation != generation; });
+        }
+    }
+
+  private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    int count;
+    int waiting = 0;
+    int generation = 0;
+};
+
+// Records statements lhs = sum(multiplier * rhs) and sweeps them in reverse
+// to compute adjoints.
+//
+// Each statement is given a dependency level while it is recorded: one more
+// than the highest level of any statement that touched one of its gradients.
+// Statements on the same level share no gradients, so with setThreadCount the
+// reverse sweep walks the levels from last to first and splits each level
+// over the threads.
+//
+// With enableCheckpoints the tape keeps at most max_statements in memory;
+// earlier parts of the recording are written to files and read back, newest
+// first, during the sweep.
 class Stack {
   public:
+    ~Stack() { removeCheckpointFiles(); }
+
+    void setThreadCount(int n) { thread_count = std::max(1, n); }
+    int threadCount() const { return thread_count; }
+
+    void enableCheckpoints(long max_statements, const std::string& file_prefix) {
+        max_statements_in_memory = max_statements;
+        checkpoint_prefix = file_prefix;
+    }
+    void disableCheckpoints() { max_statements_in_memory = 0; }
+    int checkpointCount() const { return int(checkpoint_files.size()); }
+
     void beginRecording() {
         clearStacks();
         gradients.clear();
@@ -22,53 +100,33 @@ class Stack {
     void clearStacks() {
         statements.lhs_gradient.clear();
         statements.operation.clear();
+        statements.level.clear();
         operations.rhs_gradient.clear();
         operations.multiplier.clear();
+        gradient_level.clear();
+        removeCheckpointFiles();
     }
-    void calcAdjoint(std::vector<double>& dx) const {
-        if (statements.lhs_gradient.empty()) return;
-        if (static_cast<int>(dx.size()) != num_gradients)
-            throw std::runtime_error("gradients not setup before call to calcAdjoint");
-        for (size_t s = statements.size() - 1; s > 0; s--) {
-            double lhs_grad = dx[statements.lhs_gradient[s]];
-            dx[statements.lhs_gradient[s]] = 0.0;
-            if (lhs_grad != 0.0) {
-                for (int i = statements.operation[s - 1]; i < statements.operation[s]; ++i) {
-                    dx[operations.rhs_gradient[i]] += operations.multiplier[i] * lhs_grad;
-                }
-            }
-        }
-    }
-    template <size_t N>
-    void calcAdjoint(std::vector<std::array<double, N>>& dx) const {
+    template <typename Lane>
+    void calcAdjoint(std::vector<Lane>& dx) const {
         if (statements.lhs_gradient.empty()) return;
         if (static_cast<int>(dx.size()) != num_gradients)
             throw std::runtime_error("gradients not setup before call to calcAdjoint");
-        for (size_t s = statements.size() - 1; s > 0; s--) {
-            std::array<double, N> lhs_grad{};
-            bool is_nonzero = false;
-            for (size_t i = 0; i < N; ++i) {
-                auto& grad = dx[statements.lhs_gradient[s]][i];
-                if (grad != 0.0) {
-                    is_nonzero = true;
-                    lhs_grad[i] = grad;
-                    grad = 0.0;
-                }
-            }
-            if (is_nonzero) {
-                for (int op = statements.operation[s - 1]; op < statements.operation[s]; ++op) {
-                    for (size_t i = 0; i < N; ++i) {
-                        dx[operations.rhs_gradient[op]][i] += operations.multiplier[op] * lhs_grad[i];
-                    }
-                }
-            }
+        sweep(statements, operations, dx);
+        for (auto file = checkpoint_files.rbegin(); file != checkpoint_files.rend(); ++file) {
+            Statements checkpoint_statements;
+            Operations checkpoint_operations;
+            readCheckpoint(*file, checkpoint_statements, checkpoint_operations);
+            sweep(checkpoint_statements, checkpoint_operations, dx);
         }
     }
 
     template <typename IndependentIndicies, typename DependentIndicies>
     std::vector<double> calcJacobian(const IndependentIndicies& independent, const DependentIndicies& dependent) {
         std::vector<double> jacobian(independent.size() * dependent.size());
-        calcJacobian(independent, dependent, [&](int row, int col) -> double& { return jacobian[row * 5 + col]; });
+        int num_columns = static_cast<int>(independent.size());
+        calcJacobian(independent, dependent, [&](int row, int col) -> double& {
+            return jacobian[row * num_columns + col];
+        });
         return jacobian;
     }
 
@@ -82,7 +140,8 @@ class Stack {
         auto num_columns = static_cast<int>(independent.size());
         std::array<double, PackSize> zero{};
         std::vector<std::array<double, PackSize>> dx(num_gradients);
-        for (int row = 0; row < num_rows / PackSize; ++row) {
+        for (int pack = 0; pack < num_rows / PackSize; ++pack) {
+            int row = pack * PackSize;
             std::fill(dx.begin(), dx.end(), zero);
             for (int i = 0; i < PackSize; ++i) dx[dependent[row + i]][i] = 1.0;
             calcAdjoint(dx);
@@ -118,8 +177,22 @@ class Stack {
     }
 
     void addStatement(int gradient_index) {
+        int first_operation = statements.operation.empty() ? 0 : statements.operation.back();
+        int last_operation = static_cast<int>(operations.size());
+        if (static_cast<int>(gradient_level.size()) < num_gradients) gradient_level.resize(num_gradients, 0);
+        int level = 0;
+        if (gradient_index >= 0) {
+            level = gradient_level[gradient_index] + 1;
+            for (int op = first_operation; op < last_operation; ++op)
+                level = std::max(level, gradient_level[operations.rhs_gradient[op]] + 1);
+            gradient_level[gradient_index] = level;
+            for (int op = first_operation; op < last_operation; ++op) gradient_level[operations.rhs_gradient[op]] = level;
+        }
         statements.lhs_gradient.emplace_back(gradient_index);
-        statements.operation.emplace_back(operations.size());
+        statements.operation.emplace_back(last_operation);
+        statements.level.emplace_back(level);
+        if (max_statements_in_memory > 0 and static_cast<long>(statements.size()) > max_statements_in_memory)
+            writeCheckpoint();
     }
 
     void addOperation(double multiplier, int gradient_index) {
@@ -150,6 +223,7 @@ class Stack {
         size_t size() const { return lhs_gradient.size(); }
         std::vector<int> lhs_gradient;
         std::vector<int> operation;
+        std::vector<int> level;
     };
     struct Operations {
         size_t size() const { return rhs_gradient.size(); }
@@ -161,6 +235,117 @@ class Stack {
     Operations operations;
     int num_gradients;
     std::vector<double> gradients;
+
+  private:
+    int thread_count = 1;
+    std::vector<int> gradient_level;
+    long max_statements_in_memory = 0;
+    std::string checkpoint_prefix;
+    std::vector<std::string> checkpoint_files;
+
+    template <typename Lane>
+    static void sweepStatement(const Statements& tape_statements,
+                               const Operations& tape_operations,
+                               size_t s,
+                               std::vector<Lane>& dx) {
+        using L = AdjointLane<Lane>;
+        auto& lhs = dx[tape_statements.lhs_gradient[s]];
+        Lane lhs_grad = lhs;
+        lhs = L::zero();
+        if (L::isZero(lhs_grad)) return;
+        for (int op = tape_statements.operation[s - 1]; op < tape_statements.operation[s]; ++op) {
+            L::accumulate(dx[tape_operations.rhs_gradient[op]], tape_operations.multiplier[op], lhs_grad);
+        }
+    }
+
+    // Statement 0 of every tape (and checkpoint) is the empty statement added
+    // by beginRecording, so sweeps stop at statement 1.
+    template <typename Lane>
+    void sweep(const Statements& tape_statements, const Operations& tape_operations, std::vector<Lane>& dx) const {
+        if (tape_statements.size() < 2) return;
+        if (thread_count == 1) {
+            for (size_t s = tape_statements.size() - 1; s > 0; s--)
+                sweepStatement(tape_statements, tape_operations, s, dx);
+            return;
+        }
+        auto level_range = std::minmax_element(tape_statements.level.begin() + 1, tape_statements.level.end());
+        int first_level = *level_range.first;
+        int level_count = *level_range.second - first_level + 1;
+        std::vector<long> level_offsets(level_count + 1, 0);
+        for (size_t s = 1; s < tape_statements.size(); s++) level_offsets[tape_statements.level[s] - first_level + 1]++;
+        for (int l = 0; l < level_count; l++) level_offsets[l + 1] += level_offsets[l];
+        std::vector<int> statements_by_level(level_offsets.back());
+        auto next = level_offsets;
+        for (size_t s = 1; s < tape_statements.size(); s++)
+            statements_by_level[next[tape_statements.level[s] - first_level]++] = int(s);
+
+        int workers = thread_count;
+        ThreadBarrier barrier(workers);
+        auto work = [&](int worker) {
+            for (int l = level_count - 1; l >= 0; l--) {
+                long level_size = level_offsets[l + 1] - level_offsets[l];
+                long begin = level_offsets[l] + level_size * worker / workers;
+                long end = level_offsets[l] + level_size * (worker + 1) / workers;
+                for (long i = begin; i < end; i++)
+                    sweepStatement(tape_statements, tape_operations, statements_by_level[i], dx);
+                barrier.wait();
+            }
+        };
+        std::vector<std::thread> threads;
+        for (int worker = 1; worker < workers; worker++) threads.emplace_back(work, worker);
+        work(0);
+        for (auto& t : threads) t.join();
+    }
+
+    template <typename T>
+    static void writeArray(std::ofstream& f, const std::vector<T>& v) {
+        size_t n = v.size();
+        f.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        f.write(reinterpret_cast<const char*>(v.data()), n * sizeof(T));
+    }
+    template <typename T>
+    static void readArray(std::ifstream& f, std::vector<T>& v) {
+        size_t n = 0;
+        f.read(reinterpret_cast<char*>(&n), sizeof(n));
+        v.resize(n);
+        f.read(reinterpret_cast<char*>(v.data()), n * sizeof(T));
+    }
+
+    // Moves the tape recorded so far to a file, leaving an empty statement
+    // to start the next part of the tape.
+    void writeCheckpoint() {
+        auto filename = checkpoint_prefix + "." + std::to_string(checkpoint_files.size());
+        std::ofstream f(filename, std::ios::binary);
+        writeArray(f, statements.lhs_gradient);
+        writeArray(f, statements.operation);
+        writeArray(f, statements.level);
+        writeArray(f, operations.rhs_gradient);
+        writeArray(f, operations.multiplier);
+        if (not f) throw std::runtime_error("could not write tape checkpoint " + filename);
+        checkpoint_files.push_back(filename);
+        statements.lhs_gradient.assign(1, -1);
+        statements.operation.assign(1, 0);
+        statements.level.assign(1, 0);
+        operations.rhs_gradient.clear();
+        operations.multiplier.clear();
+    }
+
+    static void readCheckpoint(const std::string& filename,
+                               Statements& tape_statements,
+                               Operations& tape_operations) {
+        std::ifstream f(filename, std::ios::binary);
+        readArray(f, tape_statements.lhs_gradient);
+        readArray(f, tape_statements.operation);
+        readArray(f, tape_statements.level);
+        readArray(f, tape_operations.rhs_gradient);
+        readArray(f, tape_operations.multiplier);
+        if (not f) throw std::runtime_error("could not read tape checkpoint " + filename);
+    }
+
+    void removeCheckpointFiles() {
+        for (auto& filename : checkpoint_files) std::remove(filename.c_str());
+        checkpoint_files.clear();
+    }
 };
 inline std::ostream& operator<<(std::ostream& os, const Stack& stack) {
     stack.print(os);
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <simd-math/simd.hpp>
+#include "Stack.h"
+
+namespace Linearize {
+
+// Lets Stack::calcAdjoint sweep simd_t::size() adjoint directions per pass,
+// one direction per lane.
+template <typename T, typename Abi>
+struct AdjointLane<simd::simd<T, Abi>> {
+    using simd_t = simd::simd<T, Abi>;
+    static simd_t zero() { return simd_t(0.0); }
+    static bool isZero(const simd_t& g) {
+        auto lanes = (const T*)&g;
+        for (int i = 0; i < int(simd_t::size()); ++i)
+            if (lanes[i] != 0.0) return false;
+        return true;
+    }
+    static void accumulate(simd_t& sum, double multiplier, const simd_t& g) { sum += simd_t(multiplier) * g; }
+};
+}
@@ -1,3 +1,4 @@
 include(CMakeFindDependencyMacro)
+find_dependency(Threads)
 find_dependency(Kokkos-simd)
 include("${CMAKE_CURRENT_LIST_DIR}/ddata.cmake")
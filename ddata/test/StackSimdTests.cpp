@@ -0,0 +1,23 @@
+#include <RingAssertions.h>
+#include <ddata/ETDStack.h>
+#include <ddata/StackSimd.h>
+
+using namespace Linearize;
+
+TEST_CASE("Stack sweeps one adjoint direction per simd lane") {
+    using simd_t = simd::simd<double, simd::simd_abi::native>;
+    ACTIVE_STACK.reset();
+    std::vector<Var> q;
+    for (int i = 0; i < int(simd_t::size()) + 1; ++i) q.push_back(Var(0.5 + i));
+    ACTIVE_STACK.beginRecording();
+    std::vector<Var> r;
+    for (size_t i = 0; i + 1 < q.size(); ++i) r.push_back(q[i] * q[i + 1]);
+
+    std::vector<simd_t> dx(ACTIVE_STACK.num_gradients, simd_t(0.0));
+    for (size_t lane = 0; lane < r.size(); ++lane) ((double*)&dx[r[lane].gradient_index])[lane] = 1.0;
+    ACTIVE_STACK.calcAdjoint(dx);
+    for (size_t lane = 0; lane < r.size(); ++lane) {
+        REQUIRE(q[lane + 1].f() == Approx(((double*)&dx[q[lane].gradient_index])[lane]));
+        REQUIRE(q[lane].f() == Approx(((double*)&dx[q[lane + 1].gradient_index])[lane]));
+    }
+}
@@ -0,0 +1,89 @@
+#include <RingAssertions.h>
+#include <ddata/ETDStack.h>
+
+using namespace Linearize;
+
+namespace {
+template <typename T>
+std::vector<T> cellFunction(const std::vector<T>& q) {
+    std::vector<T> r;
+    for (size_t i = 0; i + 1 < q.size(); ++i) {
+        T a = q[i] * q[i + 1];
+        a += sin(q[i]);
+        a *= 0.5 * q[i + 1];
+        r.push_back(a);
+    }
+    return r;
+}
+
+std::vector<double> adjointOfSum(const std::vector<Var>& q, const std::vector<Var>& r) {
+    ACTIVE_STACK.gradients.assign(ACTIVE_STACK.num_gradients, 0.0);
+    for (auto& v : r) v.setGradient(1.0);
+    ACTIVE_STACK.calcAdjoint();
+    std::vector<double> dq;
+    for (auto& v : q) dq.push_back(v.getGradient());
+    return dq;
+}
+
+std::vector<Var> inputs() {
+    std::vector<Var> q;
+    for (int i = 0; i < 40; ++i) q.push_back(Var(0.1 * i + 0.3));
+    return q;
+}
+}
+
+TEST_CASE("Threaded reverse sweep matches the serial sweep") {
+    ACTIVE_STACK.reset();
+    auto q = inputs();
+    ACTIVE_STACK.beginRecording();
+    auto r = cellFunction(q);
+    auto expected = adjointOfSum(q, r);
+
+    ACTIVE_STACK.setThreadCount(3);
+    auto actual = adjointOfSum(q, r);
+    ACTIVE_STACK.setThreadCount(1);
+    for (size_t i = 0; i < q.size(); ++i) REQUIRE(expected[i] == Approx(actual[i]).margin(1e-14));
+}
+
+TEST_CASE("Checkpointed tape gives the same adjoint as an in-memory tape") {
+    ACTIVE_STACK.reset();
+    auto q = inputs();
+    ACTIVE_STACK.beginRecording();
+    auto r = cellFunction(q);
+    auto expected = adjointOfSum(q, r);
+
+    ACTIVE_STACK.reset();
+    q = inputs();
+    ACTIVE_STACK.enableCheckpoints(25, "ddata-stack-test-tape");
+    ACTIVE_STACK.beginRecording();
+    r = cellFunction(q);
+    REQUIRE(ACTIVE_STACK.checkpointCount() > 2);
+    REQUIRE(ACTIVE_STACK.statements.size() <= 25);
+    ACTIVE_STACK.setThreadCount(2);
+    auto actual = adjointOfSum(q, r);
+    ACTIVE_STACK.setThreadCount(1);
+    ACTIVE_STACK.disableCheckpoints();
+    ACTIVE_STACK.reset();
+    for (size_t i = 0; i < q.size(); ++i) REQUIRE(expected[i] == Approx(actual[i]).margin(1e-14));
+}
+
+TEST_CASE("Jacobian with more rows than one pack of directions") {
+    ACTIVE_STACK.reset();
+    auto q = inputs();
+    ACTIVE_STACK.beginRecording();
+    auto r = cellFunction(q);
+    std::vector<int> independent, dependent;
+    for (auto& v : q) independent.push_back(v.gradient_index);
+    for (int i = 0; i < 9; ++i) dependent.push_back(r[i].gradient_index);
+    auto jacobian = ACTIVE_STACK.calcJacobian(independent, dependent);
+    for (int row = 0; row < 9; ++row) {
+        double a = q[row].f(), b = q[row + 1].f();
+        for (int col = 0; col < int(q.size()); ++col) {
+            double expected = 0.0;
+            if (col == row) expected = 0.5 * b * (b + cos(a));
+            if (col == row + 1) expected = 0.5 * (a * b + sin(a)) + 0.5 * b * a;
+            INFO("row: " << row << " col: " << col);
+            REQUIRE(expected == Approx(jacobian[row * q.size() + col]).margin(1e-12));
+        }
+    }
+}
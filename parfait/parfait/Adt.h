@@ -11,11 +11,14 @@
 // on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and limitations under the License.
 
+#include <array>
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
 #include <mutex>
+#include <numeric>
+#include <queue>
 #include <set>
 #include <tuple>
 #include <vector>
@@ -47,11 +50,16 @@ template <int ndim>
 class Adt {
   public:
     void store(int tag, const double* x);
+    // Builds a balanced tree from a known batch of objects (ndim values per tag)
+    // by recursive median splits.  Nodes are packed in breadth-first order and
+    // are already tightened, so nothing more can be stored afterward.
+    void bulkLoad(const std::vector<int>& tags, const double* objects);
     std::vector<int> retrieve(const double* extent) const;
     void retrieve(const double* extent, std::vector<int>& ids) const;
     void tighten();
     void reserve(size_t n);
-    size_t size() const { return element_tags.size(); }
+    size_t size() const { return nodes.size(); }
+    int depth() const;
 
   private:
     typedef std::array<double, ndim> Box;
@@ -71,15 +79,21 @@ class Adt {
         bool contains(const Box& object) const;
         ChildType determineChild(int depth, const Box& x);
     };
+    struct Node {
+        HyperBox hyper_box;
+        Box object_extent;
+        int element_tag;
+        int left_child_id;
+        int right_child_id;
+    };
     bool is_tightened = false;
-    std::vector<int> element_tags;
-    std::vector<Box> object_extents;
-    std::vector<int> left_child_ids;
-    std::vector<int> right_child_ids;
-    std::vector<HyperBox> hyper_boxes;
+    bool is_bulk_loaded = false;
+    std::vector<Node> nodes;
 
+    void addNode(int tag, const Box& object, const HyperBox& leaf);
     void store(int id, int tag, int current_depth, HyperBox& current_span, const Box& object, const HyperBox& new_leaf);
     void retrieve(int id, std::vector<int>& tags, const HyperBox& query_region) const;
+    int depth(int id) const;
     int nextIdInPostOrderTraversal(int starting_id) const;
     std::vector<int> buildParentList() const;
     void shrinkElementsToFitTheirObjects();
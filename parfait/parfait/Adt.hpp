@@ -17,17 +17,13 @@ namespace Parfait {
 
 template <int ndim>
 void Adt<ndim>::reserve(size_t n) {
-    element_tags.reserve(n);
-    object_extents.reserve(n);
-    left_child_ids.reserve(n);
-    right_child_ids.reserve(n);
-    hyper_boxes.reserve(n);
+    nodes.reserve(n);
 }
 
 template <int ndim>
 std::vector<int> Adt<ndim>::retrieve(const double* extent) const {
     std::vector<int> tags;
-    if (element_tags.empty()) {
+    if (nodes.empty()) {
         return tags;
     }
     HyperBox query_region(extent);
@@ -38,7 +34,7 @@ std::vector<int> Adt<ndim>::retrieve(const double* extent) const {
 template <int ndim>
 void Adt<ndim>::retrieve(const double* extent, std::vector<int>& ids) const {
     ids.clear();
-    if (element_tags.empty()) {
+    if (nodes.empty()) {
         return;
     }
     HyperBox query_region(extent);
@@ -47,18 +43,17 @@ void Adt<ndim>::retrieve(const double* extent, std::vector<int>& ids) const {
 
 template <int ndim>
 void Adt<ndim>::store(int tag, const double* x) {
+    if (is_bulk_loaded) {
+        throw std::logic_error("ADT ERROR: cannot store into a bulk loaded tree");
+    }
     HyperBox root, new_leaf;
     root.min.fill(0.0);
     root.max.fill(1.0);
     Box object;
     std::copy(x, x + ndim, object.begin());
     new_leaf.shrink(object);
-    if (element_tags.empty()) {
-        element_tags.push_back(tag);
-        object_extents.push_back(object);
-        left_child_ids.push_back(0);
-        right_child_ids.push_back(0);
-        hyper_boxes.push_back(new_leaf);
+    if (nodes.empty()) {
+        addNode(tag, object, new_leaf);
     } else {
         int id = 0;
         int current_depth = 0;
@@ -66,6 +61,89 @@ void Adt<ndim>::store(int tag, const double* x) {
     }
 }
 
+template <int ndim>
+void Adt<ndim>::addNode(int tag, const Box& object, const HyperBox& leaf) {
+    Node node;
+    node.hyper_box = leaf;
+    node.object_extent = object;
+    node.element_tag = tag;
+    node.left_child_id = 0;
+    node.right_child_id = 0;
+    nodes.push_back(node);
+}
+
+template <int ndim>
+void Adt<ndim>::bulkLoad(const std::vector<int>& tags, const double* objects) {
+    if (not nodes.empty()) {
+        throw std::logic_error("ADT ERROR: can only bulk load an empty tree");
+    }
+    int n = tags.size();
+    if (n == 0) return;
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+
+    struct Range {
+        int begin;
+        int end;
+        int depth;
+        int parent;
+        ChildType side;
+    };
+    nodes.reserve(n);
+    std::queue<Range> ranges;
+    ranges.push({0, n, 0, -1, LEFT});
+    while (not ranges.empty()) {
+        auto range = ranges.front();
+        ranges.pop();
+        int split_axis = range.depth % ndim;
+        int median = range.begin + (range.end - range.begin) / 2;
+        std::nth_element(order.begin() + range.begin,
+                         order.begin() + median,
+                         order.begin() + range.end,
+                         [&](int a, int b) { return objects[ndim * a + split_axis] < objects[ndim * b + split_axis]; });
+        Box object;
+        std::copy(objects + ndim * order[median], objects + ndim * (order[median] + 1), object.begin());
+        HyperBox leaf;
+        leaf.shrink(object);
+        int id = nodes.size();
+        addNode(tags[order[median]], object, leaf);
+        if (range.parent >= 0) {
+            if (range.side == LEFT)
+                nodes[range.parent].left_child_id = id;
+            else
+                nodes[range.parent].right_child_id = id;
+        }
+        if (median > range.begin) ranges.push({range.begin, median, range.depth + 1, id, LEFT});
+        if (median + 1 < range.end) ranges.push({median + 1, range.end, range.depth + 1, id, RIGHT});
+    }
+    // breadth-first order puts every child after its parent
+    for (int id = n - 1; id > 0; id--) {
+        auto& node = nodes[id];
+        if (node.left_child_id > 0) node.hyper_box.expand(nodes[node.left_child_id].hyper_box);
+        if (node.right_child_id > 0) node.hyper_box.expand(nodes[node.right_child_id].hyper_box);
+    }
+    auto& root = nodes.front();
+    if (root.left_child_id > 0) root.hyper_box.expand(nodes[root.left_child_id].hyper_box);
+    if (root.right_child_id > 0) root.hyper_box.expand(nodes[root.right_child_id].hyper_box);
+    is_tightened = true;
+    is_bulk_loaded = true;
+}
+
+template <int ndim>
+int Adt<ndim>::depth() const {
+    if (nodes.empty()) return 0;
+    return depth(0);
+}
+
+template <int ndim>
+int Adt<ndim>::depth(int id) const {
+    int left = nodes[id].left_child_id;
+    int right = nodes[id].right_child_id;
+    int left_depth = left > 0 ? depth(left) : 0;
+    int right_depth = right > 0 ? depth(right) : 0;
+    return 1 + std::max(left_depth, right_depth);
+}
+
 template <int ndim>
 void Adt<ndim>::HyperBox::split(int current_depth, int which_child) {
     int split_axis = current_depth % ndim;
@@ -79,45 +157,34 @@ void Adt<ndim>::HyperBox::split(int current_depth, int which_child) {
 template <int ndim>
 void Adt<ndim>::store(
     int id, int tag, int current_depth, HyperBox& current_span, const Box& object, const HyperBox& new_leaf) {
-    hyper_boxes[id].expand(new_leaf);
+    nodes[id].hyper_box.expand(new_leaf);
     auto which_child = current_span.determineChild(current_depth, object);
     current_span.split(current_depth, which_child);
 
-    if (which_child == LEFT) {
-        if (left_child_ids[id] == 0) {
-            left_child_ids[id] = element_tags.size();
-            element_tags.push_back(tag);
-            object_extents.push_back(object);
-            left_child_ids.push_back(0);
-            right_child_ids.push_back(0);
-            hyper_boxes.push_back(new_leaf);
-        } else {
-            store(left_child_ids[id], tag, current_depth + 1, current_span, object, new_leaf);
-        }
+    int child_id = which_child == LEFT ? nodes[id].left_child_id : nodes[id].right_child_id;
+    if (child_id == 0) {
+        child_id = nodes.size();
+        if (which_child == LEFT)
+            nodes[id].left_child_id = child_id;
+        else
+            nodes[id].right_child_id = child_id;
+        addNode(tag, object, new_leaf);
     } else {
-        if (right_child_ids[id] == 0) {
-            right_child_ids[id] = element_tags.size();
-            element_tags.push_back(tag);
-            object_extents.push_back(object);
-            left_child_ids.push_back(0);
-            right_child_ids.push_back(0);
-            hyper_boxes.push_back(new_leaf);
-        } else {
-            store(right_child_ids[id], tag, current_depth + 1, current_span, object, new_leaf);
-        }
+        store(child_id, tag, current_depth + 1, current_span, object, new_leaf);
     }
 }
 
 template <int ndim>
 void Adt<ndim>::retrieve(int id, std::vector<int>& tags, const HyperBox& query_region) const {
-    if (!hyper_boxes[id].contains(query_region)) {
+    const auto& node = nodes[id];
+    if (!node.hyper_box.contains(query_region)) {
         return;
     }
-    if (query_region.contains(object_extents[id])) {
-        tags.push_back(element_tags[id]);
+    if (query_region.contains(node.object_extent)) {
+        tags.push_back(node.element_tag);
     }
-    int left_child = left_child_ids[id];
-    int right_child = right_child_ids[id];
+    int left_child = node.left_child_id;
+    int right_child = node.right_child_id;
     if (left_child > 0) {
         retrieve(left_child, tags, query_region);
     }
@@ -190,8 +257,8 @@ typename Adt<ndim>::ChildType Adt<ndim>::HyperBox::determineChild(int depth, con
 
 template <int ndim>
 int Adt<ndim>::nextIdInPostOrderTraversal(int starting_id) const {
-    int left = left_child_ids[starting_id];
-    int right = right_child_ids[starting_id];
+    int left = nodes[starting_id].left_child_id;
+    int right = nodes[starting_id].right_child_id;
     if (left > 0) {
         return nextIdInPostOrderTraversal(left);
     } else if (right > 0) {
@@ -203,10 +270,10 @@ int Adt<ndim>::nextIdInPostOrderTraversal(int starting_id) const {
 
 template <int ndim>
 void Adt<ndim>::expandParent(int parent_id, int child_id) {
-    auto& parent_xmin = hyper_boxes[parent_id].min;
-    auto& parent_xmax = hyper_boxes[parent_id].max;
-    auto& child_xmin = hyper_boxes[child_id].min;
-    auto& child_xmax = hyper_boxes[child_id].max;
+    auto& parent_xmin = nodes[parent_id].hyper_box.min;
+    auto& parent_xmax = nodes[parent_id].hyper_box.max;
+    auto& child_xmin = nodes[child_id].hyper_box.min;
+    auto& child_xmax = nodes[child_id].hyper_box.max;
     for (int i = 0; i < ndim; i++) {
         parent_xmin[i] = std::min(parent_xmin[i], child_xmin[i]);
         parent_xmax[i] = std::max(parent_xmax[i], child_xmax[i]);
@@ -215,10 +282,10 @@ void Adt<ndim>::expandParent(int parent_id, int child_id) {
 
 template <int ndim>
 std::vector<int> Adt<ndim>::buildParentList() const {
-    std::vector<int> parent(element_tags.size(), -1);
-    for (size_t i = 0; i < element_tags.size(); i++) {
-        int left = left_child_ids[i];
-        int right = right_child_ids[i];
+    std::vector<int> parent(nodes.size(), -1);
+    for (size_t i = 0; i < nodes.size(); i++) {
+        int left = nodes[i].left_child_id;
+        int right = nodes[i].right_child_id;
         if (left > 0) parent[left] = i;
         if (right > 0) parent[right] = i;
     }
@@ -227,14 +294,15 @@ std::vector<int> Adt<ndim>::buildParentList() const {
 
 template <int ndim>
 void Adt<ndim>::tighten() {
+    if (nodes.empty() or is_tightened) return;
     auto parent_ids = buildParentList();
     shrinkElementsToFitTheirObjects();
     int next_id = nextIdInPostOrderTraversal(0);
     while (0 != next_id) {
         int parent_id = parent_ids[next_id];
         expandParent(parent_id, next_id);
-        if (left_child_ids[parent_id] == next_id) {
-            int sibling = right_child_ids[parent_id];
+        if (nodes[parent_id].left_child_id == next_id) {
+            int sibling = nodes[parent_id].right_child_id;
             if (sibling > 0) {
                 next_id = nextIdInPostOrderTraversal(sibling);
             } else {
@@ -263,11 +331,8 @@ void Adt<ndim>::HyperBox::expand(const Parfait::Adt<ndim>::HyperBox& other) {
 
 template <int ndim>
 void Adt<ndim>::shrinkElementsToFitTheirObjects() {
-    hyper_boxes.resize(element_tags.size());
-    for (size_t id = 0; id < element_tags.size(); id++) {
-        auto& element_span = hyper_boxes[id];
-        auto& e = object_extents[id];
-        element_span.shrink(e);
+    for (auto& node : nodes) {
+        node.hyper_box.shrink(node.object_extent);
     }
 }
 
@@ -19,12 +19,16 @@ class Adt3DExtent {
   public:
     Adt3DExtent() = delete;
     Adt3DExtent(const Extent<double>& domain);
+    // Bulk-load constructor: builds a balanced, already tightened tree.
+    Adt3DExtent(const Extent<double>& domain, const std::vector<int>& ids, const std::vector<Extent<double>>& extents);
     void reserve(size_t n);
     void store(int id, const Extent<double>& extent);
+    void bulkLoad(const std::vector<int>& ids, const std::vector<Extent<double>>& extents);
     std::vector<int> retrieve(const Extent<double>& domain) const;
     void retrieve(const Extent<double>& domain, std::vector<int>& ids) const;
     void removeFirst(int id, const Extent<double>& e);
     Parfait::Extent<double> boundingExtent() const;
+    int depth() const;
 
     // Warning: after calling tighten(), you can no longer store
     // new items in the tree.
@@ -11,6 +11,13 @@
 // See the License for the specific language governing permissions and limitations under the License.
 inline Parfait::Adt3DExtent::Adt3DExtent(const Parfait::Extent<double>& domain) : unitTransformer(domain) {}
 
+inline Parfait::Adt3DExtent::Adt3DExtent(const Parfait::Extent<double>& domain,
+                                         const std::vector<int>& ids,
+                                         const std::vector<Parfait::Extent<double>>& extents)
+    : unitTransformer(domain) {
+    bulkLoad(ids, extents);
+}
+
 inline void Parfait::Adt3DExtent::reserve(size_t n) { adt.reserve(n); }
 
 inline void Parfait::Adt3DExtent::store(int id, const Parfait::Extent<double>& extent) {
@@ -20,6 +27,19 @@ inline void Parfait::Adt3DExtent::store(int id, const Parfait::Extent<double>& e
     adt.store(id, &store.lo[0]);
 }
 
+inline void Parfait::Adt3DExtent::bulkLoad(const std::vector<int>& ids,
+                                           const std::vector<Parfait::Extent<double>>& extents) {
+    if (ids.size() != extents.size()) throw std::logic_error("Adt3DExtent: bulk load needs one id per extent");
+    std::vector<double> objects(6 * extents.size());
+    for (size_t i = 0; i < extents.size(); i++) {
+        auto lo = unitTransformer.ToUnitSpace(extents[i].lo);
+        auto hi = unitTransformer.ToUnitSpace(extents[i].hi);
+        std::copy(lo.data(), lo.data() + 3, &objects[6 * i]);
+        std::copy(hi.data(), hi.data() + 3, &objects[6 * i + 3]);
+    }
+    adt.bulkLoad(ids, objects.data());
+}
+
 inline std::vector<int> Parfait::Adt3DExtent::retrieve(const Parfait::Extent<double>& domain) const {
     auto adtDomain = unitTransformer.getDomain();
     if (not adtDomain.intersects(domain)) return {};
@@ -39,4 +59,6 @@ inline void Parfait::Adt3DExtent::retrieve(const Parfait::Extent<double>& domain
 
 inline Parfait::Extent<double> Parfait::Adt3DExtent::boundingExtent() const { return unitTransformer.getDomain(); }
 
-inline void Parfait::Adt3DExtent::tighten() { adt.tighten(); }
\ No newline at end of file
+inline void Parfait::Adt3DExtent::tighten() { adt.tighten(); }
+
+inline int Parfait::Adt3DExtent::depth() const { return adt.depth(); }
\ No newline at end of file
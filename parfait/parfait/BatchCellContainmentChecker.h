@@ -0,0 +1,294 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Parfait {
+
+namespace BatchContainment {
+    typedef std::array<int, 4> TetIndices;
+    constexpr int chunk_size = 32;
+
+    template <int V>
+    struct Chunk {
+        double x[V][chunk_size];
+        double y[V][chunk_size];
+        double z[V][chunk_size];
+    };
+
+    template <int M, typename Coordinates>
+    void addCentroid(Coordinates& c, int target, const std::array<int, M>& ids, int width) {
+        for (int m = 0; m < width; m++) {
+            double x = 0.0, y = 0.0, z = 0.0;
+            for (int id : ids) {
+                x += c.x[id][m];
+                y += c.y[id][m];
+                z += c.z[id][m];
+            }
+            c.x[target][m] = x * (1.0 / double(M));
+            c.y[target][m] = y * (1.0 / double(M));
+            c.z[target][m] = z * (1.0 / double(M));
+        }
+    }
+
+    // Cell vertices followed by the face and cell centroids that
+    // CellTesselator::tesselate() adds, and the tets it builds from them.
+    template <int N>
+    struct Tessellation;
+
+    template <>
+    struct Tessellation<4> {
+        static constexpr int vertex_count = 4;
+        template <typename Coordinates>
+        static void addCentroids(Coordinates&, int) {}
+        static std::array<TetIndices, 1> tets() { return {{{0, 1, 2, 3}}}; }
+    };
+
+    template <>
+    struct Tessellation<5> {
+        static constexpr int vertex_count = 6;
+        template <typename Coordinates>
+        static void addCentroids(Coordinates& c, int width) {
+            addCentroid<4>(c, 5, {0, 1, 2, 3}, width);
+        }
+        static std::array<TetIndices, 4> tets() { return {{{0, 4, 1, 5}, {1, 4, 2, 5}, {2, 4, 3, 5}, {3, 4, 0, 5}}}; }
+    };
+
+    template <>
+    struct Tessellation<6> {
+        static constexpr int vertex_count = 10;
+        template <typename Coordinates>
+        static void addCentroids(Coordinates& c, int width) {
+            addCentroid<6>(c, 6, {0, 1, 2, 3, 4, 5}, width);
+            addCentroid<4>(c, 7, {0, 1, 4, 3}, width);
+            addCentroid<4>(c, 8, {1, 2, 5, 4}, width);
+            addCentroid<4>(c, 9, {0, 2, 3, 5}, width);
+        }
+        static std::array<TetIndices, 14> tets() {
+            return {{{0, 7, 1, 6},
+                     {1, 7, 4, 6},
+                     {3, 7, 0, 6},
+                     {4, 7, 3, 6},
+                     {1, 8, 2, 6},
+                     {2, 8, 5, 6},
+                     {4, 8, 1, 6},
+                     {5, 8, 4, 6},
+                     {0, 9, 3, 6},
+                     {2, 9, 0, 6},
+                     {3, 9, 5, 6},
+                     {5, 9, 2, 6},
+                     {0, 1, 2, 6},
+                     {3, 5, 4, 6}}};
+        }
+    };
+
+    template <>
+    struct Tessellation<8> {
+        static constexpr int vertex_count = 15;
+        template <typename Coordinates>
+        static void addCentroids(Coordinates& c, int width) {
+            addCentroid<8>(c, 8, {0, 1, 2, 3, 4, 5, 6, 7}, width);
+            addCentroid<4>(c, 9, {0, 1, 4, 5}, width);
+            addCentroid<4>(c, 10, {1, 2, 5, 6}, width);
+            addCentroid<4>(c, 11, {2, 3, 6, 7}, width);
+            addCentroid<4>(c, 12, {3, 0, 4, 7}, width);
+            addCentroid<4>(c, 13, {3, 2, 0, 1}, width);
+            addCentroid<4>(c, 14, {4, 5, 6, 7}, width);
+        }
+        static std::array<TetIndices, 24> tets() {
+            return {{{0, 9, 1, 8},  {1, 9, 5, 8},  {5, 9, 4, 8},  {4, 9, 0, 8},  {1, 10, 2, 8}, {2, 10, 6, 8},
+                     {6, 10, 5, 8}, {5, 10, 1, 8}, {2, 11, 3, 8}, {3, 11, 7, 8}, {7, 11, 6, 8}, {6, 11, 2, 8},
+                     {3, 12, 0, 8}, {0, 12, 4, 8}, {4, 12, 7, 8}, {7, 12, 3, 8}, {3, 13, 2, 8}, {2, 13, 1, 8},
+                     {1, 13, 0, 8}, {0, 13, 3, 8}, {4, 14, 5, 8}, {5, 14, 6, 8}, {6, 14, 7, 8}, {7, 14, 4, 8}}};
+        }
+    };
+
+    inline double squaredDistance(double ax, double ay, double az, double bx, double by, double bz) {
+        double dx = ax - bx, dy = ay - by, dz = az - bz;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    // Barycentric test of one sub-tet for every pair in the chunk.  Branch free
+    // so the loop over pairs vectorizes.
+    template <typename Coordinates>
+    void checkTet(const Coordinates& c,
+                  const TetIndices& tet,
+                  const double* px,
+                  const double* py,
+                  const double* pz,
+                  int width,
+                  int* hit) {
+        const double* x0 = c.x[tet[0]];
+        const double* y0 = c.y[tet[0]];
+        const double* z0 = c.z[tet[0]];
+        const double* x1 = c.x[tet[1]];
+        const double* y1 = c.y[tet[1]];
+        const double* z1 = c.z[tet[1]];
+        const double* x2 = c.x[tet[2]];
+        const double* y2 = c.y[tet[2]];
+        const double* z2 = c.z[tet[2]];
+        const double* x3 = c.x[tet[3]];
+        const double* y3 = c.y[tet[3]];
+        const double* z3 = c.z[tet[3]];
+        for (int m = 0; m < width; m++) {
+            double ax = x0[m] - x3[m], ay = y0[m] - y3[m], az = z0[m] - z3[m];
+            double bx = x1[m] - x3[m], by = y1[m] - y3[m], bz = z1[m] - z3[m];
+            double cx = x2[m] - x3[m], cy = y2[m] - y3[m], cz = z2[m] - z3[m];
+            double rx = px[m] - x3[m], ry = py[m] - y3[m], rz = pz[m] - z3[m];
+
+            double bc_x = by * cz - bz * cy, bc_y = bz * cx - bx * cz, bc_z = bx * cy - by * cx;
+            double rc_x = ry * cz - rz * cy, rc_y = rz * cx - rx * cz, rc_z = rx * cy - ry * cx;
+            double br_x = by * rz - bz * ry, br_y = bz * rx - bx * rz, br_z = bx * ry - by * rx;
+
+            double det = ax * bc_x + ay * bc_y + az * bc_z;
+            double w0 = (rx * bc_x + ry * bc_y + rz * bc_z) / det;
+            double w1 = (ax * rc_x + ay * rc_y + az * rc_z) / det;
+            double w2 = (ax * br_x + ay * br_y + az * br_z) / det;
+            double w3 = 1.0 - (w0 + w1 + w2);
+            double worst = std::min(std::min(w0, w1), std::min(w2, w3));
+
+            double e01 = squaredDistance(x0[m], y0[m], z0[m], x1[m], y1[m], z1[m]);
+            double e02 = squaredDistance(x0[m], y0[m], z0[m], x2[m], y2[m], z2[m]);
+            double e12 = squaredDistance(x1[m], y1[m], z1[m], x2[m], y2[m], z2[m]);
+            double e03 = ax * ax + ay * ay + az * az;
+            double e13 = bx * bx + by * by + bz * bz;
+            double e23 = cx * cx + cy * cy + cz * cz;
+            double longest = std::max(std::max(std::max(e01, e02), std::max(e12, e03)), std::max(e13, e23));
+            double shortest = std::min(std::min(std::min(e01, e02), std::min(e12, e03)), std::min(e13, e23));
+            double tol = 1.0e-13 * std::sqrt(longest / shortest);
+
+            hit[m] |= int(det != 0.0) & int(worst + tol > 0.0);
+        }
+    }
+
+    // Pairs of one element type in structure-of-arrays form.
+    template <int N>
+    class Lanes {
+      public:
+        typedef Tessellation<N> Shape;
+
+        void add(const double* vertices, const double* xyz, int index) {
+            for (int i = 0; i < 3 * N; i++) coords[i].push_back(vertices[i]);
+            for (int i = 0; i < 3; i++) points[i].push_back(xyz[i]);
+            batch_index.push_back(index);
+        }
+
+        template <typename Points>
+        void add(const int* vertex_ids, const Points& vertex_points, const double* xyz, int index) {
+            for (int v = 0; v < N; v++) {
+                const auto& vertex = vertex_points[vertex_ids[v]];
+                for (int d = 0; d < 3; d++) coords[3 * v + d].push_back(vertex[d]);
+            }
+            for (int i = 0; i < 3; i++) points[i].push_back(xyz[i]);
+            batch_index.push_back(index);
+        }
+
+        void clear() {
+            for (auto& c : coords) c.clear();
+            for (auto& p : points) p.clear();
+            batch_index.clear();
+        }
+
+        void check(std::vector<int>& is_inside) const {
+            int n = batch_index.size();
+            Chunk<Shape::vertex_count> chunk;
+            for (int begin = 0; begin < n; begin += chunk_size) {
+                int width = std::min(chunk_size, n - begin);
+                for (int v = 0; v < N; v++) {
+                    std::copy(&coords[3 * v][begin], &coords[3 * v][begin] + width, chunk.x[v]);
+                    std::copy(&coords[3 * v + 1][begin], &coords[3 * v + 1][begin] + width, chunk.y[v]);
+                    std::copy(&coords[3 * v + 2][begin], &coords[3 * v + 2][begin] + width, chunk.z[v]);
+                }
+                Shape::addCentroids(chunk, width);
+                int hit[chunk_size] = {};
+                for (auto& tet : Shape::tets())
+                    checkTet(chunk, tet, &points[0][begin], &points[1][begin], &points[2][begin], width, hit);
+                for (int m = 0; m < width; m++) is_inside[batch_index[begin + m]] = hit[m];
+            }
+        }
+
+      private:
+        std::array<std::vector<double>, 3 * N> coords;
+        std::array<std::vector<double>, 3> points;
+        std::vector<int> batch_index;
+    };
+}
+
+// Checks many (cell, point) pairs at once.
+//
+// Pairs are queued per element type and each type is checked by a fixed-size
+// kernel that runs over chunks of pairs, so the compiler can vectorize it.
+// Cells are split into the same tets as CellTesselator::tesselate() and use the
+// same tolerance as CellContainmentChecker::isInCell(), so both agree up to
+// round-off for points on cell faces.
+class BatchCellContainmentChecker {
+  public:
+    // vertices: 3*n coordinates of the cell, xyz: the query point.
+    // Returns the index of the pair in the batch.
+    int add(int n, const double* vertices, const double* xyz) {
+        int index = count++;
+        if (4 == n)
+            tets.add(vertices, xyz, index);
+        else if (5 == n)
+            pyramids.add(vertices, xyz, index);
+        else if (6 == n)
+            prisms.add(vertices, xyz, index);
+        else if (8 == n)
+            hexs.add(vertices, xyz, index);
+        else
+            throw std::domain_error("Invalid cell size: " + std::to_string(n));
+        return index;
+    }
+
+    // Same as above, with the cell's vertices read from a point array in
+    // place: vertex i is vertex_points[vertex_ids[i]].
+    template <typename Points>
+    int add(int n, const int* vertex_ids, const Points& vertex_points, const double* xyz) {
+        int index = count++;
+        if (4 == n)
+            tets.add(vertex_ids, vertex_points, xyz, index);
+        else if (5 == n)
+            pyramids.add(vertex_ids, vertex_points, xyz, index);
+        else if (6 == n)
+            prisms.add(vertex_ids, vertex_points, xyz, index);
+        else if (8 == n)
+            hexs.add(vertex_ids, vertex_points, xyz, index);
+        else
+            throw std::domain_error("Invalid cell size: " + std::to_string(n));
+        return index;
+    }
+
+    void check() {
+        is_inside.assign(count, 0);
+        tets.check(is_inside);
+        pyramids.check(is_inside);
+        prisms.check(is_inside);
+        hexs.check(is_inside);
+    }
+
+    bool isInCell(int index) const { return is_inside[index] != 0; }
+
+    int size() const { return count; }
+
+    void clear() {
+        count = 0;
+        tets.clear();
+        pyramids.clear();
+        prisms.clear();
+        hexs.clear();
+        is_inside.clear();
+    }
+
+  private:
+    int count = 0;
+    BatchContainment::Lanes<4> tets;
+    BatchContainment::Lanes<5> pyramids;
+    BatchContainment::Lanes<6> prisms;
+    BatchContainment::Lanes<8> hexs;
+    std::vector<int> is_inside;
+};
+
+}
@@ -0,0 +1,137 @@
+// Copyright 2016 United States Government as represented by the Administrator of the National Aeronautics and Space
+// Administration. No copyright is claimed in the United States under Title 17, U.S. Code. All Other Rights Reserved.
+//
+// The “Parfait: A Toolbox for CFD Software Development [LAR-18839-1]” platform is licensed under the
+// Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+#pragma once
+#include <algorithm>
+#include <vector>
+#include "ThreadRanges.h"
+
+namespace Parfait {
+
+// Adjacency (node-to-node, node-to-cell, ...) stored as compressed rows: one
+// array with the entries of every row back to back, and one array of offsets
+// where each row starts.  Rows are read through operator[], which returns a
+// view that can be iterated like the std::vector<int> rows of a
+// std::vector<std::vector<int>>.
+//
+// The graph is built in two passes over the same generator: the first pass
+// only counts the entries of each row, the second writes them in place, so
+// the entries are allocated once.
+class CompressedRowGraph {
+  public:
+    class Row {
+      public:
+        Row(const int* b, const int* e) : b(b), e(e) {}
+        const int* begin() const { return b; }
+        const int* end() const { return e; }
+        size_t size() const { return size_t(e - b); }
+        bool empty() const { return b == e; }
+        int operator[](size_t i) const { return b[i]; }
+        int front() const { return *b; }
+        int back() const { return *(e - 1); }
+
+      private:
+        const int* b;
+        const int* e;
+    };
+
+    CompressedRowGraph() : offsets(1, 0) {}
+    explicit CompressedRowGraph(const std::vector<std::vector<int>>& graph) : offsets(graph.size() + 1, 0) {
+        for (size_t row = 0; row < graph.size(); row++) offsets[row + 1] = offsets[row] + long(graph[row].size());
+        values.reserve(offsets.back());
+        for (auto& row : graph) values.insert(values.end(), row.begin(), row.end());
+    }
+
+    size_t size() const { return offsets.size() - 1; }
+    long entryCount() const { return offsets.back(); }
+    Row operator[](long row) const {
+        return {values.data() + offsets[row], values.data() + offsets[row + 1]};
+    }
+    const std::vector<long>& rowOffsets() const { return offsets; }
+    const std::vector<int>& entries() const { return values; }
+    size_t memoryInBytes() const { return offsets.capacity() * sizeof(long) + values.capacity() * sizeof(int); }
+
+    std::vector<std::vector<int>> toVectorOfVectors() const {
+        std::vector<std::vector<int>> graph(size());
+        for (size_t row = 0; row < size(); row++) graph[row].assign((*this)[row].begin(), (*this)[row].end());
+        return graph;
+    }
+
+    // for_each_entry(emit) must call emit(row, value) for every entry, in any
+    // row order.  It is called twice.  Entries keep the order they were emitted.
+    template <typename ForEachEntry>
+    static CompressedRowGraph build(long row_count, ForEachEntry for_each_entry) {
+        CompressedRowGraph graph;
+        graph.offsets.assign(row_count + 1, 0);
+        for_each_entry([&](long row, int) { graph.offsets[row + 1]++; });
+        for (long row = 0; row < row_count; row++) graph.offsets[row + 1] += graph.offsets[row];
+        graph.values.resize(graph.offsets.back());
+        std::vector<long> next(graph.offsets.begin(), graph.offsets.end() - 1);
+        for_each_entry([&](long row, int value) { graph.values[next[row]++] = value; });
+        return graph;
+    }
+
+    // row_entries(row, entries) must append the entries of one row to entries
+    // (which arrives empty).  Each row is generated twice, and the rows are
+    // split over thread_count threads, so row_entries must be safe to call
+    // concurrently for different rows.
+    template <typename RowEntries>
+    static CompressedRowGraph buildByRow(long row_count, RowEntries row_entries, int thread_count = 1) {
+        CompressedRowGraph graph;
+        graph.offsets.assign(row_count + 1, 0);
+        forEachThreadRange(thread_count, row_count, [&](int, long start, long end) {
+            std::vector<int> entries;
+            for (long row = start; row < end; row++) {
+                entries.clear();
+                row_entries(row, entries);
+                graph.offsets[row + 1] = long(entries.size());
+            }
+        });
+        for (long row = 0; row < row_count; row++) graph.offsets[row + 1] += graph.offsets[row];
+        graph.values.resize(graph.offsets.back());
+        forEachThreadRange(thread_count, row_count, [&](int, long start, long end) {
+            std::vector<int> entries;
+            for (long row = start; row < end; row++) {
+                entries.clear();
+                row_entries(row, entries);
+                std::copy(entries.begin(), entries.end(), graph.values.begin() + graph.offsets[row]);
+            }
+        });
+        return graph;
+    }
+
+    // Sorts the entries of every row and removes repeats, compacting in place.
+    void sortAndRemoveDuplicates(int thread_count = 1) {
+        std::vector<long> unique_counts(size(), 0);
+        forEachThreadRange(thread_count, long(size()), [&](int, long start, long end) {
+            for (long row = start; row < end; row++) {
+                auto b = values.begin() + offsets[row];
+                auto e = values.begin() + offsets[row + 1];
+                std::sort(b, e);
+                unique_counts[row] = std::distance(b, std::unique(b, e));
+            }
+        });
+        long next = 0;
+        for (size_t row = 0; row < size(); row++) {
+            long start = offsets[row];
+            offsets[row] = next;
+            std::copy(values.begin() + start, values.begin() + start + unique_counts[row], values.begin() + next);
+            next += unique_counts[row];
+        }
+        offsets.back() = next;
+        values.resize(next);
+        values.shrink_to_fit();
+    }
+
+  private:
+    std::vector<long> offsets;
+    std::vector<int> values;
+};
+}
@@ -33,6 +33,7 @@ class MotionMatrix {
     void addRotation(const double line_start[3], const double line_end[3], double angle);
     void addRotation(const Parfait::Point<double>& a, const Parfait::Point<double>& b, double angle);
     void addMotion(const MotionMatrix& motion);
+    MotionMatrix inverse() const;
     void setMotionMatrix(const double matrix[16]);
     void getMatrix(double matrix[16]) const;
     void movePoint(double p[3]) const;
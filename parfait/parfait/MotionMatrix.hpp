@@ -62,6 +62,22 @@ inline void MotionMatrix::addMotion(const MotionMatrix& motion) {
     setMotionMatrix(result);
 }
 
+inline MotionMatrix MotionMatrix::inverse() const {
+    // only valid for rigid motions: the inverse of [R t] is [R^T -R^T t]
+    double result[16];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) result[4 * i + j] = mat[4 * j + i];
+        result[4 * i + 3] = -(mat[i] * mat[3] + mat[4 + i] * mat[7] + mat[8 + i] * mat[11]);
+    }
+    result[12] = 0.0;
+    result[13] = 0.0;
+    result[14] = 0.0;
+    result[15] = 1.0;
+    MotionMatrix inv;
+    inv.setMotionMatrix(result);
+    return inv;
+}
+
 inline void MotionMatrix::setTranslation(const double translation[3]) {
     clearMotions();
     mat[3] = translation[0];
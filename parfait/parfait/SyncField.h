@@ -18,10 +18,10 @@
 #include "Throw.h"
 
 namespace Parfait {
-template <typename T>
+template <typename T, typename Map = std::map<long, int>>
 class SyncWrapper {
   public:
-    SyncWrapper(std::vector<T>& Q, const std::map<long, int>& global_to_local)
+    SyncWrapper(std::vector<T>& Q, const Map& global_to_local)
         : Q(Q), global_to_local(global_to_local) {
         static_assert(!std::is_same<T, bool>::value, "syncing std::vector<bool> is not allowed.");
     }
@@ -43,7 +43,7 @@ class SyncWrapper {
 
   private:
     std::vector<T>& Q;
-    const std::map<long, int>& global_to_local;
+    const Map& global_to_local;
 };
 
 template <typename T>
@@ -313,12 +313,12 @@ void syncField(MessagePasser mp, Field& f, const Parfait::SyncPattern& syncPatte
     syncer.finish();
 }
 
-template <typename T>
+template <typename T, typename Map>
 void syncVector(MessagePasser mp,
                 std::vector<T>& vec,
-                const std::map<long, int>& global_to_local,
+                const Map& global_to_local,
                 const Parfait::SyncPattern& sync_pattern) {
-    SyncWrapper<T> syncer(vec, global_to_local);
+    SyncWrapper<T, Map> syncer(vec, global_to_local);
     syncField<T>(mp, syncer, sync_pattern);
 }
 
@@ -0,0 +1,54 @@
+// Copyright 2016 United States Government as represented by the Administrator of the National Aeronautics and Space
+// Administration. No copyright is claimed in the United States under Title 17, U.S. Code. All Other Rights Reserved.
+//
+// The “Parfait: A Toolbox for CFD Software Development [LAR-18839-1]” platform is licensed under the
+// Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+#pragma once
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+#include "LinearPartitioner.h"
+
+namespace Parfait {
+
+// Splits [0, n) into one contiguous range per thread and calls
+// work(thread_id, start, end) for each.  Ranges are ordered by thread id, so
+// concatenating per-thread results in thread order reproduces the serial order.
+// The backend is std::thread unless PARFAIT_THREAD_RANGES_OPENMP is defined.
+// With one thread the work runs on the caller.  An exception thrown by any
+// thread is rethrown after all threads have joined.
+template <typename Work>
+void forEachThreadRange(int thread_count, long n, Work work) {
+    thread_count = int(std::max(1l, std::min(long(thread_count), n)));
+    if (1 == thread_count) {
+        work(0, 0l, n);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(thread_count);
+    auto run = [&](int t) {
+        try {
+            auto range = LinearPartitioner::getRangeForWorker(t, n, thread_count);
+            work(t, range.start, range.end);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+#ifdef PARFAIT_THREAD_RANGES_OPENMP
+#pragma omp parallel for num_threads(thread_count) schedule(static, 1)
+    for (int t = 0; t < thread_count; t++) run(t);
+#else
+    std::vector<std::thread> threads;
+    for (int t = 1; t < thread_count; t++) threads.emplace_back(run, t);
+    run(0);
+    for (auto& thread : threads) thread.join();
+#endif
+    for (auto& e : errors)
+        if (e) std::rethrow_exception(e);
+}
+}
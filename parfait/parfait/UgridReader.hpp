@@ -75,7 +75,7 @@ inline std::vector<double> Parfait::UgridReader::readNodes(int begin, int end) {
     std::vector<double> nodes(3 * nrequested, 0);
 
     long byteOffset = calcOffsetForSection(Section::Nodes);
-    byteOffset += 3 * begin * sizeof(double);
+    byteOffset += 3 * long(begin) * sizeof(double);
     fseek(f, byteOffset, SEEK_SET);
     fread(&nodes[0], sizeof(double), 3 * nrequested, f);
     if (swap_bytes) {
@@ -94,7 +94,7 @@ inline std::vector<int> Parfait::UgridReader::readTriangles(int begin, int end)
     std::vector<int> triangles(3 * nrequested, 0);
 
     long byteOffset = calcOffsetForSection(Section::Triangles);
-    byteOffset += 3 * begin * sizeof(int);
+    byteOffset += 3 * long(begin) * sizeof(int);
     fseek(f, byteOffset, SEEK_SET);
     fread(&triangles[0], sizeof(int), 3 * nrequested, f);
     if (swap_bytes) swapBytes(triangles);
@@ -111,7 +111,7 @@ inline std::vector<int> Parfait::UgridReader::readQuads(int begin, int end) {
     std::vector<int> quads(4 * nrequested, 0);
 
     long byteOffset = calcOffsetForSection(Section::Quads);
-    byteOffset += 4 * begin * sizeof(int);
+    byteOffset += 4 * long(begin) * sizeof(int);
     fseek(f, byteOffset, SEEK_SET);
     fread(&quads[0], sizeof(int), 4 * nrequested, f);
     if (swap_bytes) swapBytes(quads);
@@ -210,7 +210,7 @@ inline std::vector<int> Parfait::UgridReader::readBoundaryTags(int begin, int en
     std::vector<int> tags(nrequested, 0);
 
     long byteOffset = calcOffsetForSection(Section::TriTags);
-    byteOffset += begin * sizeof(int);
+    byteOffset += long(begin) * sizeof(int);
     fseek(f, byteOffset, SEEK_SET);
     fread(&tags[0], sizeof(int), nrequested, f);
     if (swap_bytes) swapBytes(tags);
@@ -57,3 +57,34 @@ TEST_CASE("Adt3DExtent, StoreNegativeExtent") {
     inside = adt.retrieve(Extent<double>(Point<double>(-4, -4, -4), Point<double>(4, 4, 4)));
     REQUIRE(3 == inside.size());
 }
+
+TEST_CASE("Adt3DExtent, BulkLoadMatchesIncrementalStore") {
+    Extent<double> domain(Point<double>(0, 0, 0), Point<double>(10, 10, 10));
+    std::vector<int> ids;
+    std::vector<Extent<double>> extents;
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            for (int k = 0; k < 10; k++) {
+                ids.push_back(100 * i + 10 * j + k);
+                extents.push_back(Extent<double>(Point<double>(i, j, k), Point<double>(i + 1.1, j + 1.1, k + 1.1)));
+            }
+        }
+    }
+    Adt3DExtent incremental(domain);
+    for (size_t i = 0; i < ids.size(); i++) incremental.store(ids[i], extents[i]);
+    Adt3DExtent bulk(domain, ids, extents);
+
+    REQUIRE(bulk.depth() == 10);
+    REQUIRE(bulk.depth() <= incremental.depth());
+
+    for (auto p : {Point<double>(.5, .5, .5), Point<double>(5, 5, 5), Point<double>(8.95, 0.2, 3.05)}) {
+        auto expected = incremental.retrieve({p, p});
+        auto actual = bulk.retrieve({p, p});
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        REQUIRE(not actual.empty());
+        REQUIRE(expected == actual);
+    }
+
+    REQUIRE_THROWS(bulk.store(7, extents.front()));
+}
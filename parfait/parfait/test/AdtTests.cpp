@@ -136,4 +136,17 @@ TEST_CASE("Adt, CornerCaseStoreMinus10") {
     auto inside = adt.retrieve(extent);
 
     REQUIRE(1 == inside.size());
-}
\ No newline at end of file
+}
+TEST_CASE("Adt, BulkLoad3DPoints") {
+    Adt<3> adt;
+    std::vector<int> tags = {10, 11, 12};
+    std::vector<double> points = {0.1, 0.1, 0.1, 0.7, 0.7, 0.7, 0.2, 0.3, 0.4};
+    adt.bulkLoad(tags, points.data());
+    REQUIRE(3 == adt.size());
+    REQUIRE(2 == adt.depth());
+
+    double extent[6] = {0, 0, 0, 0.5, 0.5, 0.5};
+    auto inside = adt.retrieve(extent);
+    std::sort(inside.begin(), inside.end());
+    REQUIRE(std::vector<int>{10, 12} == inside);
+}
@@ -0,0 +1,129 @@
+#include <RingAssertions.h>
+#include <parfait/BatchCellContainmentChecker.h>
+#include <parfait/CellContainmentChecker.h>
+#include <parfait/CGNSElements.h>
+#include <random>
+
+template <int N>
+std::array<Parfait::Point<double>, N> unitCell();
+
+template <>
+std::array<Parfait::Point<double>, 4> unitCell<4>() {
+    return {Parfait::Point<double>{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+}
+template <>
+std::array<Parfait::Point<double>, 5> unitCell<5>() {
+    return {Parfait::Point<double>{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0.5, 0.5, 1}};
+}
+template <>
+std::array<Parfait::Point<double>, 6> unitCell<6>() {
+    return {Parfait::Point<double>{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {0, 1, 1}};
+}
+template <>
+std::array<Parfait::Point<double>, 8> unitCell<8>() {
+    return {Parfait::Point<double>{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+}
+
+template <int N>
+void requireBatchMatchesScalar(int count) {
+    std::mt19937 gen(N);
+    std::uniform_real_distribution<double> wiggle(-0.15, 0.15);
+    std::uniform_real_distribution<double> position(-0.25, 1.25);
+    std::vector<std::array<Parfait::Point<double>, N>> cells;
+    std::vector<Parfait::Point<double>> points;
+    Parfait::BatchCellContainmentChecker batch;
+    for (int i = 0; i < count; i++) {
+        auto cell = unitCell<N>();
+        for (auto& p : cell)
+            for (int d = 0; d < 3; d++) p[d] += wiggle(gen);
+        Parfait::Point<double> p{position(gen), position(gen), position(gen)};
+        if (i % 7 == 0) p = cell[i % N];
+        cells.push_back(cell);
+        points.push_back(p);
+        REQUIRE(i == batch.add(N, cell.front().data(), p.data()));
+    }
+    batch.check();
+    REQUIRE(count == batch.size());
+    int inside = 0;
+    for (int i = 0; i < count; i++) {
+        bool expected = Parfait::CellContainmentChecker::isInCell<N>(cells[i], points[i]);
+        REQUIRE(expected == batch.isInCell(i));
+        if (expected) inside++;
+    }
+    REQUIRE(inside > 0);
+    REQUIRE(inside < count);
+}
+
+TEST_CASE("Batch containment matches the scalar check for every element type") {
+    requireBatchMatchesScalar<4>(100);
+    requireBatchMatchesScalar<5>(100);
+    requireBatchMatchesScalar<6>(100);
+    requireBatchMatchesScalar<8>(100);
+}
+
+TEST_CASE("Batch containment keeps the order of mixed element types") {
+    Parfait::BatchCellContainmentChecker batch;
+    auto tet = unitCell<4>();
+    auto hex = unitCell<8>();
+    auto prism = unitCell<6>();
+    Parfait::Point<double> near_origin{0.2, 0.2, 0.2};
+    Parfait::Point<double> near_far_corner{0.9, 0.9, 0.9};
+    batch.add(4, tet.front().data(), near_origin.data());
+    batch.add(8, hex.front().data(), near_far_corner.data());
+    batch.add(4, tet.front().data(), near_far_corner.data());
+    batch.add(6, prism.front().data(), near_origin.data());
+    batch.check();
+    REQUIRE(batch.isInCell(0));
+    REQUIRE(batch.isInCell(1));
+    REQUIRE_FALSE(batch.isInCell(2));
+    REQUIRE(batch.isInCell(3));
+
+    batch.clear();
+    REQUIRE(0 == batch.size());
+    REQUIRE_THROWS(batch.add(7, hex.front().data(), near_origin.data()));
+}
+
+TEST_CASE("Batch containment accepts points on faces of anisotropic cells") {
+    std::array<Parfait::Point<double>, 4> tet;
+    tet[0] = {1.428809e-01, 1.000000e+00, -5.152324e-01};
+    tet[1] = {1.419095e-01, 1.000000e+00, -5.136984e-01};
+    tet[2] = {1.424697e-01, 1.000000e+00, -5.147030e-01};
+    tet[3] = {1.424200e-01, 5.000000e-01, -5.145446e-01};
+    Parfait::Point<double> point_on_face{1.421266e-01, 1.000000e+00, -5.140557e-01};
+
+    std::array<Parfait::Point<double>, 6> prism;
+    prism[0] = {1.5195706352567007e-01, 0.0000000000000000e+00, -5.3004592372315762e-01};
+    prism[1] = {1.5282115090984527e-01, 0.0000000000000000e+00, -5.3142296915015397e-01};
+    prism[2] = {1.5332012062398159e-01, 0.0000000000000000e+00, -5.3232104704332261e-01};
+    prism[3] = {1.5195706352567007e-01, 1.0000000000000000e+00, -5.3004592372315762e-01};
+    prism[4] = {1.5282115090984527e-01, 1.0000000000000000e+00, -5.3142296915015397e-01};
+    prism[5] = {1.5332012062398159e-01, 1.0000000000000000e+00, -5.3232104704332261e-01};
+
+    Parfait::BatchCellContainmentChecker batch;
+    batch.add(4, tet.front().data(), point_on_face.data());
+    for (auto& vertex : tet) batch.add(4, tet.front().data(), vertex.data());
+    for (auto edge_midpoint : Parfait::CGNS::Prism::computeEdgeCenters(prism))
+        batch.add(6, prism.front().data(), edge_midpoint.data());
+    batch.check();
+    for (int i = 0; i < batch.size(); i++) REQUIRE(batch.isInCell(i));
+}
+
+TEST_CASE("Batch containment can read cell vertices from a point array by index") {
+    auto hex = unitCell<8>();
+    std::vector<Parfait::Point<double>> points(hex.begin(), hex.end());
+    points.insert(points.begin(), Parfait::Point<double>{9, 9, 9});
+    std::array<int, 8> hex_ids = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::array<int, 4> tet_ids = {1, 2, 4, 5};
+    Parfait::Point<double> inside{0.2, 0.3, 0.4};
+    Parfait::Point<double> outside{0.9, 0.9, 0.9};
+
+    Parfait::BatchCellContainmentChecker batch;
+    batch.add(8, hex_ids.data(), points, inside.data());
+    batch.add(4, tet_ids.data(), points, outside.data());
+    batch.add(8, hex.front().data(), outside.data());
+    batch.check();
+    REQUIRE(batch.isInCell(0));
+    REQUIRE_FALSE(batch.isInCell(1));
+    REQUIRE(batch.isInCell(2));
+    REQUIRE_THROWS(batch.add(7, hex_ids.data(), points, inside.data()));
+}
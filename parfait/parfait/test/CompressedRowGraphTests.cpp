@@ -0,0 +1,48 @@
+
+// Copyright 2016 United States Government as represented by the Administrator of the National Aeronautics and Space
+// Administration. No copyright is claimed in the United States under Title 17, U.S. Code. All Other Rights Reserved.
+//
+// The “Parfait: A Toolbox for CFD Software Development [LAR-18839-1]” platform is licensed under the
+// Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0.
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#include <RingAssertions.h>
+#include <parfait/CompressedRowGraph.h>
+
+TEST_CASE("Compressed row graph round trips a vector of vectors") {
+    std::vector<std::vector<int>> graph = {{1, 2}, {}, {0, 3, 4}, {2}};
+    Parfait::CompressedRowGraph crs(graph);
+    REQUIRE(4 == crs.size());
+    REQUIRE(6 == crs.entryCount());
+    REQUIRE(crs[1].empty());
+    REQUIRE(3 == crs[2].size());
+    REQUIRE(4 == crs[2].back());
+    REQUIRE(graph == crs.toVectorOfVectors());
+}
+
+TEST_CASE("Compressed row graph built from emitted entries keeps their order") {
+    auto crs = Parfait::CompressedRowGraph::build(3, [](auto emit) {
+        emit(2, 7);
+        emit(0, 5);
+        emit(2, 1);
+        emit(2, 7);
+    });
+    REQUIRE(std::vector<std::vector<int>>{{5}, {}, {7, 1, 7}} == crs.toVectorOfVectors());
+    crs.sortAndRemoveDuplicates();
+    REQUIRE(std::vector<std::vector<int>>{{5}, {}, {1, 7}} == crs.toVectorOfVectors());
+    REQUIRE(3 == crs.entryCount());
+}
+
+TEST_CASE("Compressed row graph built by row gives the same rows on any number of threads") {
+    auto row_entries = [](long row, std::vector<int>& entries) {
+        for (long i = 0; i < row % 5; i++) entries.push_back(int(row + i));
+    };
+    auto serial = Parfait::CompressedRowGraph::buildByRow(1000, row_entries);
+    auto threaded = Parfait::CompressedRowGraph::buildByRow(1000, row_entries, 4);
+    REQUIRE(serial.rowOffsets() == threaded.rowOffsets());
+    REQUIRE(serial.entries() == threaded.entries());
+    REQUIRE(3 == serial[13].size());
+    REQUIRE(15 == serial[13][2]);
+}
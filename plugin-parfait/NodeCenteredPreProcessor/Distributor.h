@@ -4,15 +4,21 @@
 #include <parfait/Point.h>
 #include <parfait/ToString.h>
 #include <t-infinity/MeshInterface.h>
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <queue>
 #include <vector>
 #include "../shared/Reader.h"
 
+// Ranks are split evenly between reader ranks.  Each reader reads the node
+// and cell ranges of the ranks it serves straight from the file and sends
+// them on.  One reader is the rank 0 only path; readers that can seek to any
+// slice cheaply default to every rank reading its own ranges.
 class Distributor {
   public:
     Distributor(MessagePasser mp, std::shared_ptr<Reader> reader) : mp(mp), reader(reader), first_cell_id_in_chunk(0) {
+        setReaderCount(reader->canReadSlicesInParallel() ? mp.NumberOfProcesses() : 1);
         if (mp.Rank() == 0) {
             global_node_count = reader->nodeCount();
             printf("Loading mesh with %s nodes.\n", Parfait::bigNumberToStringWithCommas(global_node_count).c_str());
@@ -22,6 +28,21 @@ class Distributor {
 
     long globalNodeCount() const { return global_node_count; }
 
+    void setReaderCount(int count) { reader_count = std::max(1, std::min(count, mp.NumberOfProcesses())); }
+    int readerCount() const { return reader_count; }
+
+    int readerOf(int rank) const {
+        auto reader_index = Parfait::LinearPartitioner::getWorkerOfWorkItem(rank, mp.NumberOfProcesses(), reader_count);
+        return int(Parfait::LinearPartitioner::getRangeForWorker(reader_index, mp.NumberOfProcesses(), reader_count).start);
+    }
+
+    std::vector<int> ranksServedByMe() const {
+        std::vector<int> ranks;
+        if (readerOf(mp.Rank()) != mp.Rank()) return ranks;
+        for (int r = mp.Rank(); r < mp.NumberOfProcesses() and readerOf(r) == mp.Rank(); r++) ranks.push_back(r);
+        return ranks;
+    }
+
     void determineCellOwners(const long* cell, int length, std::set<int>& owners) const {
         for (int i = 0; i < length; i++) {
             long gid = cell[i];
@@ -42,38 +63,33 @@ class Distributor {
         auto node_range_per_rank = buildNodeRangePerRank(mp.NumberOfProcesses(), global_node_count);
 
         auto my_range = node_range_per_rank[mp.Rank()];
-        std::vector<Parfait::Point<double>> my_nodes((my_range.end - my_range.start));
+        int nnodes = my_range.end - my_range.start;
+        std::vector<Parfait::Point<double>> my_nodes(nnodes);
+        auto my_status = mp.NonBlockingRecv(my_nodes, nnodes, readerOf(mp.Rank()));
+
         int max_send_buffers = 8;
         using Buffer = std::vector<Parfait::Point<double>>;
         std::queue<std::shared_ptr<Buffer>> send_buffers;
         std::queue<MessagePasser::MessageStatus> statuses;
-        for (int r = 0; r < mp.NumberOfProcesses(); r++) {
-            if (mp.Rank() == 0) {
-                auto range = node_range_per_rank[r];
-                if (statuses.size() >= size_t(max_send_buffers)) {
-                    auto& status = statuses.front();
-                    status.wait();
-                    statuses.pop();
-                    send_buffers.pop();
-                }
-                auto send_buffer_ptr = std::make_shared<Buffer>(reader->readCoords(range.start, range.end));
-                send_buffers.push(send_buffer_ptr);
-                statuses.push(mp.NonBlockingSend(*send_buffer_ptr, int(send_buffer_ptr->size()), r));
-            }
-            if (r == mp.Rank()) {
-                int nnodes = my_range.end - my_range.start;
-                my_nodes.resize(nnodes);
-                mp.Recv(my_nodes, nnodes, 0);
-            }
-        }
-
-        if (mp.Rank() == 0) {
-            while (statuses.size() > 0) {
-                auto& s = statuses.front();
-                s.wait();
+        for (int r : ranksServedByMe()) {
+            auto range = node_range_per_rank[r];
+            if (statuses.size() >= size_t(max_send_buffers)) {
+                auto& status = statuses.front();
+                status.wait();
                 statuses.pop();
                 send_buffers.pop();
             }
+            auto send_buffer_ptr = std::make_shared<Buffer>(reader->readCoords(range.start, range.end));
+            send_buffers.push(send_buffer_ptr);
+            statuses.push(mp.NonBlockingSend(*send_buffer_ptr, int(send_buffer_ptr->size()), r));
+        }
+
+        my_status.wait();
+        while (statuses.size() > 0) {
+            auto& s = statuses.front();
+            s.wait();
+            statuses.pop();
+            send_buffers.pop();
         }
 
         return my_nodes;
@@ -101,13 +117,13 @@ class Distributor {
         cells.resize(cell_length * my_cell_count);
         tags.resize(my_cell_count);
         cell_ids.resize(my_cell_count);
-        auto s1 = mp.NonBlockingRecv(cells, cell_length * my_cell_count, 0);
-        auto s2 = mp.NonBlockingRecv(tags, my_cell_count, 0);
-        if (mp.Rank() == 0) {
+        auto s1 = mp.NonBlockingRecv(cells, cell_length * my_cell_count, readerOf(mp.Rank()));
+        auto s2 = mp.NonBlockingRecv(tags, my_cell_count, readerOf(mp.Rank()));
+        {
             std::queue<std::shared_ptr<std::vector<long>>> cell_buffers;
             std::queue<std::shared_ptr<std::vector<int>>> tag_buffers;
             std::queue<MessagePasser::MessageStatus> promises;
-            for (int chunk = 0; chunk < nchunks; chunk++) {
+            for (int chunk : ranksServedByMe()) {
                 auto range = Parfait::LinearPartitioner::getRangeForWorker(chunk, cell_count, nchunks);
                 int ncells = range.end - range.start;
                 auto cell_buffer = reader->readCells(type, range.start, range.end);
@@ -207,4 +223,5 @@ class Distributor {
     std::shared_ptr<Reader> reader;
     long global_node_count;
     long first_cell_id_in_chunk;
+    int reader_count;
 };
@@ -36,6 +36,9 @@ std::shared_ptr<inf::MeshInterface> NC_GrpPreProcessor::load(MPI_Comm comm, std:
 
         auto partitioner = NC::Partitioner::getPartitioner(mp, "default");
         NodeCentered::PProcessor pre_processor(mp, reader, *partitioner);
+        if (settings.count("reader_ranks")) {
+            pre_processor.setReaderCount(settings.at("reader_ranks").asInt());
+        }
         mesh = pre_processor.createMesh();
     } else {
         SerialPreProcessor serial_pre_processor;
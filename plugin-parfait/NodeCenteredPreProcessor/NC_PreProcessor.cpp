@@ -38,6 +38,9 @@ std::shared_ptr<inf::MeshInterface> NC_PreProcessor::load(MPI_Comm comm, std::st
 
         auto partitioner = NC::Partitioner::getPartitioner(mp, partitioner_string);
         NodeCentered::PProcessor pre_processor(mp, reader, *partitioner);
+        if (settings.count("reader_ranks")) {
+            pre_processor.setReaderCount(settings.at("reader_ranks").asInt());
+        }
         mesh = pre_processor.createMesh();
     } else {
         SerialPreProcessor serial_pre_processor;
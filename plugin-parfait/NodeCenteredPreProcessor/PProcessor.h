@@ -12,6 +12,8 @@ class PProcessor {
     PProcessor(MessagePasser mp, std::shared_ptr<Reader> reader, NC::Partitioner& partitioner)
         : mp(mp), reader(reader), partitioner(partitioner), distributor(mp, reader) {}
 
+    void setReaderCount(int count) { distributor.setReaderCount(count); }
+
     NaiveMesh loadNaiveMesh() {
         mp_rootprint("PP: Loading naive mesh\n");
         mp_rootprint("PP: distributing nodes\n");
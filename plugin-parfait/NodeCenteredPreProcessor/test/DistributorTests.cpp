@@ -123,3 +123,38 @@ TEST_CASE("Distributor can export a NaiveMesh") {
     const long expected_max_global_cell_id = number_of_total_cells - 1;
     REQUIRE(expected_max_global_cell_id == max_id);
 }
+
+TEST_CASE("Distributed reads match reading everything on rank 0") {
+    auto reader = std::make_shared<UgridReader>(six_cell);
+    MessagePasser mp(MPI_COMM_WORLD);
+
+    for (int reader_count = 2; reader_count <= mp.NumberOfProcesses(); reader_count++) {
+        Distributor rank_0_reads(mp, reader);
+        rank_0_reads.setReaderCount(1);
+        Distributor distributor(mp, reader);
+        distributor.setReaderCount(reader_count);
+
+        auto expected_coords = rank_0_reads.distributeNodes();
+        auto coords = distributor.distributeNodes();
+        REQUIRE(coords.size() == expected_coords.size());
+        for (size_t i = 0; i < coords.size(); i++) REQUIRE(coords[i].approxEqual(expected_coords[i]));
+
+        for (auto type : reader->cellTypes()) {
+            std::vector<long> expected_cells, cells, expected_ids, ids;
+            std::vector<int> expected_tags, tags;
+            std::tie(expected_cells, expected_tags, expected_ids) = rank_0_reads.distributeCellsTagsAndGlobalIds2(type);
+            std::tie(cells, tags, ids) = distributor.distributeCellsTagsAndGlobalIds2(type);
+            REQUIRE(expected_cells == cells);
+            REQUIRE(expected_tags == tags);
+            REQUIRE(expected_ids == ids);
+        }
+    }
+}
+
+TEST_CASE("Ugrid files are read on every rank by default") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    Distributor ugrid_distributor(mp, std::make_shared<UgridReader>(six_cell));
+    REQUIRE(ugrid_distributor.readerCount() == mp.NumberOfProcesses());
+    Distributor mock_distributor(mp, std::make_shared<MockReader>());
+    REQUIRE(mock_distributor.readerCount() == 1);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include <MessagePasser/MessagePasser.h>
+#include <parfait/LinearPartitioner.h>
+#include <parfait/Throw.h>
+
+// Every rank writes its own part of each section of a file with MPI-IO,
+// instead of funnelling the whole file through rank 0.
+class CollectiveFileWriter {
+  public:
+    // A contiguous range of global ids held by one rank, in global id order.
+    template <typename T>
+    struct Slab {
+        long start;
+        std::vector<T> values;
+    };
+
+    // Collective.  If truncate is false, whatever is already in the file is kept,
+    // so rank 0 can write headers with other tools first.
+    inline CollectiveFileWriter(MessagePasser mp, const std::string& filename, bool truncate = true) : mp(mp) {
+        int error =
+            MPI_File_open(mp.getCommunicator(), filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &f);
+        if (MPI_SUCCESS != error) PARFAIT_THROW("Could not open file for writing: " + filename);
+        if (truncate) MPI_File_set_size(f, 0);
+    }
+
+    // Collective.
+    inline void close() { MPI_File_close(&f); }
+
+    // Collective.
+    inline void writeAtAll(long offset, const void* data, long bytes) { mp.WriteAtAll(f, offset, data, bytes); }
+
+    // Collective.  Only rank 0 writes, but every rank must pass the same text.
+    // Returns the offset just past it.
+    inline long writeTextOnRoot(long offset, const std::string& s) {
+        writeAtAll(offset, s.data(), 0 == mp.Rank() ? long(s.size()) : 0);
+        return offset + long(s.size());
+    }
+
+    // Where this rank's bytes start in a section every rank contributes to in rank order.
+    inline long offsetInRankOrder(long bytes) const {
+        long offset = 0;
+        MPI_Exscan(&bytes, &offset, 1, MPI_LONG, MPI_SUM, mp.getCommunicator());
+        return 0 == mp.Rank() ? 0 : offset;
+    }
+
+    // Collective.  Sends each owned (global id, value) to the rank holding that id's
+    // linear range of [0, n_global) and returns this rank's range.
+    template <typename T>
+    inline Slab<T> gatherSlab(const std::map<long, T>& owned, long n_global) const {
+        int nranks = mp.NumberOfProcesses();
+        std::vector<std::vector<long>> gids_for_ranks(nranks);
+        std::vector<std::vector<T>> values_for_ranks(nranks);
+        for (auto& pair : owned) {
+            auto owner = Parfait::LinearPartitioner::getWorkerOfWorkItem(pair.first, n_global, nranks);
+            gids_for_ranks[owner].push_back(pair.first);
+            values_for_ranks[owner].push_back(pair.second);
+        }
+        auto gids_from_ranks = mp.Exchange(gids_for_ranks);
+        auto values_from_ranks = mp.Exchange(values_for_ranks);
+
+        auto range = Parfait::LinearPartitioner::getRangeForWorker(mp.Rank(), n_global, nranks);
+        Slab<T> slab;
+        slab.start = range.start;
+        slab.values.resize(range.end - range.start);
+        for (int r = 0; r < nranks; r++) {
+            auto& gids = gids_from_ranks[r];
+            for (size_t i = 0; i < gids.size(); i++) slab.values[gids[i] - range.start] = values_from_ranks[r][i];
+        }
+        return slab;
+    }
+
+  private:
+    MessagePasser mp;
+    MPI_File f;
+};
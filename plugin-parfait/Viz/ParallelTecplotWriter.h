@@ -17,6 +17,7 @@
 #include <t-infinity/FieldTools.h>
 #include <t-infinity/MeshConnectivity.h>
 #include <t-infinity/FilterFactory.h>
+#include "CollectiveFileWriter.h"
 
 class ParallelTecplotZoneWriter {
   public:
@@ -46,21 +47,7 @@ class ParallelTecplotZoneWriter {
 
     inline void writeZone(FILE* fp_in) {
         fp = fp_in;
-
-        float zone_marker = 299.0;
-        int xyz_fields = 3;
-        if (mp.Rank() == 0) {
-            writeFloat(zone_marker);
-            for (int i = 0; i < int(node_fields.size() + cell_fields.size() + xyz_fields); i++) {
-                writeInt(2);  // we're going to write all fields as doubles
-            }
-            writeInt(
-                0);  // no passive variables (these are variables in the global variable list that are NOT in this zone)
-            writeInt(0);   // no variable sharing (whatever that is)
-            writeInt(-1);  // no zone sharing (whatever THAT is)
-        }
-
-        writeRanges();
+        writeZoneHeader();
         writeNodes();
         writeFields();
         if (zone_type == ZoneType::VOLUME) writeVolumeCells();
@@ -69,6 +56,28 @@ class ParallelTecplotZoneWriter {
         fp = nullptr;
     }
 
+    // Nodes, fields and cells are fixed size records, so every rank writes the
+    // ones in its range of global ids straight to the file.  Returns the offset past the zone.
+    inline long writeZoneCollectively(CollectiveFileWriter& file, long offset) {
+        writeZoneHeader();
+        long header_size = buffer.size();
+        mp.Broadcast(header_size, 0);
+        file.writeAtAll(offset, buffer.data(), buffer.size());
+        buffer.clear();
+        offset += header_size;
+
+        offset = writeFieldCollectively(file, offset, *getPointDimensionAsField("X", 0), global_num_points);
+        offset = writeFieldCollectively(file, offset, *getPointDimensionAsField("Y", 1), global_num_points);
+        offset = writeFieldCollectively(file, offset, *getPointDimensionAsField("Z", 2), global_num_points);
+        for (auto& field : node_fields) offset = writeFieldCollectively(file, offset, *field, global_num_points);
+        for (auto& field : cell_fields) offset = writeFieldCollectively(file, offset, *field, global_num_elements);
+        if (zone_type == ZoneType::VOLUME)
+            offset = writeCellsCollectively(file, offset, extractCollapsedVolumeCellsInRange(0, global_num_elements));
+        if (zone_type == ZoneType::SURFACE)
+            offset = writeCellsCollectively(file, offset, extractCollapsedSurfaceCellsInRange(0, global_num_elements));
+        return offset;
+    }
+
   public:
     MessagePasser mp;
     std::shared_ptr<inf::MeshInterface> mesh;
@@ -76,6 +85,7 @@ class ParallelTecplotZoneWriter {
     std::vector<std::shared_ptr<inf::FieldInterface>> node_fields;  // will be written out in order added
     std::vector<std::shared_ptr<inf::FieldInterface>> cell_fields;  // nodes first, then cells
     FILE* fp = nullptr;
+    std::vector<char> buffer;  // collects rank 0's writes when there is no fp
 
     struct Topology {
         std::vector<long> global_ids;
@@ -87,6 +97,41 @@ class ParallelTecplotZoneWriter {
     long global_num_elements;
     std::map<Association, Topology> topologies;
 
+    inline void writeZoneHeader() {
+        float zone_marker = 299.0;
+        int xyz_fields = 3;
+        if (mp.Rank() == 0) {
+            writeFloat(zone_marker);
+            for (int i = 0; i < int(node_fields.size() + cell_fields.size() + xyz_fields); i++) {
+                writeInt(2);  // we're going to write all fields as doubles
+            }
+            writeInt(
+                0);  // no passive variables (these are variables in the global variable list that are NOT in this zone)
+            writeInt(0);   // no variable sharing (whatever that is)
+            writeInt(-1);  // no zone sharing (whatever THAT is)
+        }
+        writeRanges();
+    }
+
+    inline long writeFieldCollectively(CollectiveFileWriter& file,
+                                       long offset,
+                                       const inf::FieldInterface& field,
+                                       long n_global_items) {
+        auto slab = file.gatherSlab(extractScalarFieldAsMapInRange(field, 0, n_global_items), n_global_items);
+        file.writeAtAll(offset + slab.start * sizeof(double), slab.values.data(), slab.values.size() * sizeof(double));
+        return offset + n_global_items * sizeof(double);
+    }
+
+    template <size_t N>
+    inline long writeCellsCollectively(CollectiveFileWriter& file,
+                                       long offset,
+                                       const std::map<long, std::array<int, N>>& owned_cells) {
+        auto slab = file.gatherSlab(owned_cells, global_num_elements);
+        long bytes_per_cell = N * sizeof(int);
+        file.writeAtAll(offset + slab.start * bytes_per_cell, slab.values.data(), slab.values.size() * bytes_per_cell);
+        return offset + global_num_elements * bytes_per_cell;
+    }
+
     inline void writeRanges() {
         auto e = inf::meshExtent(mp, *mesh);
         if (mp.Rank() == 0) {
@@ -409,10 +454,18 @@ class ParallelTecplotZoneWriter {
         return std::make_shared<inf::VectorFieldAdapter>(name, inf::FieldAttributes::Node(), 1, x);
     }
 
-    inline void writeFloat(float f) { fwrite(&f, sizeof(float), 1, fp); }
-    inline void writeDouble(double f) { fwrite(&f, sizeof(double), 1, fp); }
-    inline void writeInt(int i) { fwrite(&i, sizeof(int), 1, fp); }
-    inline void writeDoubles(double* d, int num_to_write) { fwrite(d, sizeof(double), num_to_write, fp); }
+    inline void put(const void* data, size_t bytes) {
+        if (fp) {
+            fwrite(data, 1, bytes, fp);
+        } else {
+            auto begin = static_cast<const char*>(data);
+            buffer.insert(buffer.end(), begin, begin + bytes);
+        }
+    }
+    inline void writeFloat(float f) { put(&f, sizeof(float)); }
+    inline void writeDouble(double f) { put(&f, sizeof(double)); }
+    inline void writeInt(int i) { put(&i, sizeof(int)); }
+    inline void writeDoubles(double* d, int num_to_write) { put(d, sizeof(double) * num_to_write); }
 };
 
 class ParallelTecplotWriter {
@@ -456,7 +509,14 @@ class ParallelTecplotWriter {
         }
     }
 
+    // Collective MPI-IO is the default.  Otherwise rank 0 gathers and writes everything.
+    inline void setCollectiveIO(bool c) { collective_io = c; }
+
     inline void write() {
+        if (collective_io) {
+            writeCollectively();
+            return;
+        }
         open();
         addFieldsToSubZones();
         writeHeader();
@@ -467,6 +527,28 @@ class ParallelTecplotWriter {
         close();
     }
 
+    // Rank 0 writes the file header with the serial helpers, then every rank
+    // writes its part of each zone after it.
+    inline void writeCollectively() {
+        Tracer::begin("ParallelTecplotWriter::writeCollectively");
+        open();
+        addFieldsToSubZones();
+        writeHeader();
+        long offset = 0;
+        if (mp.Rank() == 0) offset = ftell(fp);
+        close();
+        mp.Broadcast(filename, 0);
+        mp.Broadcast(offset, 0);
+
+        CollectiveFileWriter file(mp, filename, false);
+        if (write_volume) offset = volume_zone_writer.writeZoneCollectively(file, offset);
+        for (auto& pair : surface_tag_writers) {
+            offset = pair.second.writeZoneCollectively(file, offset);
+        }
+        file.close();
+        Tracer::end("ParallelTecplotWriter::writeCollectively");
+    }
+
     inline void setSolutionTime(double s) { solution_time = s; }
     static inline void addInOrder(std::vector<std::shared_ptr<inf::FieldInterface>>& ordered_fields,
                                   std::shared_ptr<inf::FieldInterface> field) {
@@ -540,6 +622,7 @@ class ParallelTecplotWriter {
 
     FILE* fp;
     double solution_time = 0.0;
+    bool collective_io = true;
 
     inline void open() {
         if (Parfait::StringTools::getExtension(filename) != "plt") filename += ".plt";
@@ -6,8 +6,11 @@
 #include <t-infinity/VectorFieldAdapter.h>
 #include <t-infinity/FileStreamer.h>
 #include <Tracer.h>
+#include <parfait/ByteSwap.h>
 #include <parfait/StringTools.h>
+#include <parfait/VTKWriter.h>
 #include <t-infinity/InfinityToVtk.h>
+#include "CollectiveFileWriter.h"
 
 class ParallelVTKWriter {
   public:
@@ -29,7 +32,14 @@ class ParallelVTKWriter {
         }
     }
 
+    // Collective MPI-IO is the default.  Otherwise rank 0 gathers and writes everything.
+    inline void setCollectiveIO(bool c) { collective_io = c; }
+
     inline void write() {
+        if (collective_io) {
+            writeCollectively();
+            return;
+        }
         open();
         writeHeader();
         writeNodes();
@@ -53,12 +63,17 @@ class ParallelVTKWriter {
     long global_num_points;
     long global_num_elements;
     std::map<Association, Topology> topologies;
+    bool collective_io = true;
 
     std::shared_ptr<inf::FileStreamer> f = nullptr;
 
-    inline void open() {
+    inline void fixExtension() {
         filename = Parfait::StringTools::stripExtension(filename, "pvtk");
         if (Parfait::StringTools::getExtension(filename) != "vtk") filename += ".vtk";
+    }
+
+    inline void open() {
+        fixExtension();
         if (mp.Rank() == 0) {
             f = inf::FileStreamer::create("default");
             if (not f->openWrite(filename)) {
@@ -239,8 +254,16 @@ class ParallelVTKWriter {
     template <size_t BufferLength>
     inline void writePackedCells(const std::vector<std::array<long, BufferLength>>& packed_cells,
                                  long starting_global_cell_id) {
+        auto cells = packCells(packed_cells);
+        f->write(cells.data(), sizeof(int), cells.size());
+    }
+
+    // Each cell as its big endian node count followed by its big endian node ids.
+    template <size_t BufferLength>
+    inline std::vector<int> packCells(const std::vector<std::array<long, BufferLength>>& packed_cells) {
+        std::vector<int> out;
         std::vector<int> cell_nodes;
-        for (auto cell : packed_cells) {
+        for (auto& cell : packed_cells) {
             int num_points = int(cell[1]);
             int cell_type = int(cell[0]);
             int vtk_type = inf::infinityToVtkCellType(inf::MeshInterface::CellType(cell_type));
@@ -253,14 +276,14 @@ class ParallelVTKWriter {
 
             int num_points_big_endian = num_points;
             bswap_32(&num_points_big_endian);
-            f->write(&num_points_big_endian, sizeof(num_points_big_endian), 1);
+            out.push_back(num_points_big_endian);
 
             for (int i = 0; i < num_points; i++) {
                 bswap_32(&cell_nodes[i]);
             }
-
-            f->write(cell_nodes.data(), sizeof(int), num_points);
+            out.insert(out.end(), cell_nodes.begin(), cell_nodes.end());
         }
+        return out;
     }
 
     inline size_t calcCellBufferSize() {
@@ -439,6 +462,92 @@ class ParallelVTKWriter {
         return out;
     }
 
+    // Every rank gathers one contiguous range of global ids for each section and
+    // writes it at an offset it computes itself.  Rank 0 only writes the text headers.
+    inline void writeCollectively() {
+        Tracer::begin("ParallelVTKWriter::writeCollectively");
+        fixExtension();
+        mp.Broadcast(filename, 0);
+        CollectiveFileWriter file(mp, filename);
+        long offset = file.writeTextOnRoot(0, Parfait::vtk::Writer::getHeader());
+        offset = writeNodesCollectively(file, offset);
+        offset = writeCellsCollectively(file, offset);
+        offset = writeCellTypesCollectively(file, offset);
+        if (cell_fields.size() != 0) {
+            offset = file.writeTextOnRoot(offset, "\nCELL_DATA " + std::to_string(global_num_elements) + "\n");
+            for (auto& key_value : cell_fields)
+                offset = writeFieldCollectively(file, offset, *key_value.second, global_num_elements);
+        }
+        if (node_fields.size() != 0) {
+            offset = file.writeTextOnRoot(offset, "\nPOINT_DATA " + std::to_string(global_num_points) + "\n");
+            for (auto& key_value : node_fields)
+                offset = writeFieldCollectively(file, offset, *key_value.second, global_num_points);
+        }
+        file.close();
+        Tracer::end("ParallelVTKWriter::writeCollectively");
+    }
+
+    inline long writeNodesCollectively(CollectiveFileWriter& file, long offset) {
+        offset = file.writeTextOnRoot(offset, "POINTS " + std::to_string(global_num_points) + " double\n");
+        auto slab = file.gatherSlab(extractOwnedNodesInRange(0, global_num_points), global_num_points);
+        for (auto& p : slab.values) {
+            bswap_64(&p[0]);
+            bswap_64(&p[1]);
+            bswap_64(&p[2]);
+        }
+        long bytes_per_point = 3 * sizeof(double);
+        file.writeAtAll(offset + slab.start * bytes_per_point, slab.values.data(), slab.values.size() * bytes_per_point);
+        return offset + global_num_points * bytes_per_point;
+    }
+
+    inline long writeCellsCollectively(CollectiveFileWriter& file, long offset) {
+        size_t cell_buffer_size = calcCellBufferSize();
+        offset = file.writeTextOnRoot(
+            offset, "\nCELLS " + std::to_string(global_num_elements) + " " + std::to_string(cell_buffer_size) + "\n");
+        int max_cell_length = mp.ParallelMax(calcMaxCellLength());
+        std::vector<int> cells;
+        if (max_cell_length <= 8) {
+            cells = gatherPackedCells<10>(file);
+        } else if (max_cell_length <= 27) {
+            cells = gatherPackedCells<29>(file);
+        } else {
+            PARFAIT_WARNING("Cannot write file " + filename +
+                            " the maximum cell length is too large: " + std::to_string(max_cell_length));
+        }
+        // Cells have different lengths, so ranks are placed by what the ranks before them write.
+        long bytes = cells.size() * sizeof(int);
+        file.writeAtAll(offset + file.offsetInRankOrder(bytes), cells.data(), bytes);
+        return offset + mp.ParallelSum(bytes);
+    }
+
+    template <size_t CellBufferLength>
+    inline std::vector<int> gatherPackedCells(CollectiveFileWriter& file) {
+        auto slab =
+            file.gatherSlab(extractOwnedCellsInRange<CellBufferLength>(0, global_num_elements), global_num_elements);
+        return packCells(slab.values);
+    }
+
+    inline long writeCellTypesCollectively(CollectiveFileWriter& file, long offset) {
+        offset = file.writeTextOnRoot(offset, "\nCELL_TYPES " + std::to_string(global_num_elements) + "\n");
+        auto slab = file.gatherSlab(extractOwnedCellTypesInRange(0, global_num_elements), global_num_elements);
+        for (auto& type : slab.values) bswap_32(&type);
+        file.writeAtAll(offset + slab.start * sizeof(int), slab.values.data(), slab.values.size() * sizeof(int));
+        offset += global_num_elements * sizeof(int);
+        return file.writeTextOnRoot(offset, "\n");
+    }
+
+    inline long writeFieldCollectively(CollectiveFileWriter& file,
+                                       long offset,
+                                       const inf::FieldInterface& field,
+                                       long n_global_items) {
+        std::string field_name = Parfait::StringTools::findAndReplace(field.name(), " ", "_");
+        offset = file.writeTextOnRoot(offset, "SCALARS " + field_name + " DOUBLE 1\nLOOKUP_TABLE DEFAULT\n");
+        auto slab = file.gatherSlab(extractScalarFieldAsMapInRange(field, 0, n_global_items), n_global_items);
+        for (auto& d : slab.values) bswap_64(&d);
+        file.writeAtAll(offset + slab.start * sizeof(double), slab.values.data(), slab.values.size() * sizeof(double));
+        return offset + n_global_items * sizeof(double);
+    }
+
     inline const Topology& getTopology(std::string association) const {
         if (topologies.count(association) == 0) {
             PARFAIT_THROW("Attempting to access Topology for Unknown Association: " + association);
@@ -13,6 +13,9 @@ class Reader {
                                           long element_start,
                                           long element_end) const = 0;
     virtual std::vector<inf::MeshInterface::CellType> cellTypes() const = 0;
+    // True if any slice can be read without touching the rest of the file,
+    // so every rank can read its own slices.
+    virtual bool canReadSlicesInParallel() const { return false; }
 
     virtual ~Reader() = default;
 };
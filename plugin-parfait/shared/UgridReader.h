@@ -30,6 +30,8 @@ class UgridReader : public Reader {
 
     std::vector<inf::MeshInterface::CellType> cellTypes() const override;
 
+    bool canReadSlicesInParallel() const override { return true; }
+
     bool isBigEndian(std::string name);
 
   private:
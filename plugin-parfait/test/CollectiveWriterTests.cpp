@@ -0,0 +1,42 @@
+#include <Viz/ParallelTecplotWriter.h>
+#include <Viz/ParallelVTKWriter.h>
+#include <t-infinity/CartMesh.h>
+#include <t-infinity/FieldTools.h>
+#include <t-infinity/VectorFieldAdapter.h>
+#include <parfait/FileTools.h>
+#include <RingAssertions.h>
+#include <string>
+
+template <typename Writer>
+void requireCollectiveAndRootOnlyFilesMatch(const std::string& extension) {
+    MessagePasser mp(MPI_COMM_WORLD);
+    auto mesh = inf::CartMesh::create(mp, 4, 3, 5);
+    auto node_field = inf::FieldTools::createNodeFieldFromCallback(
+        "x plus y", *mesh, [](double x, double y, double z) { return x + y; });
+    std::vector<double> cell_ids(mesh->cellCount());
+    for (int c = 0; c < mesh->cellCount(); c++) cell_ids[c] = double(mesh->globalCellId(c));
+    auto cell_field = std::make_shared<inf::VectorFieldAdapter>("cell id", inf::FieldAttributes::Cell(), 1, cell_ids);
+
+    std::string collective_name = "collective" + extension;
+    std::string root_only_name = "root-only" + extension;
+    for (bool collective : {true, false}) {
+        Writer writer(collective ? collective_name : root_only_name, mesh, mp.getCommunicator());
+        writer.addField(node_field);
+        writer.addField(cell_field);
+        writer.setCollectiveIO(collective);
+        writer.write();
+    }
+    mp.Barrier();
+
+    if (0 == mp.Rank()) {
+        REQUIRE(Parfait::FileTools::loadFileToString(collective_name) ==
+                Parfait::FileTools::loadFileToString(root_only_name));
+        remove(collective_name.c_str());
+        remove(root_only_name.c_str());
+    }
+}
+
+TEST_CASE("Collective and root-only parallel writers agree") {
+    SECTION("vtk") { requireCollectiveAndRootOnlyFilesMatch<ParallelVTKWriter>(".vtk"); }
+    SECTION("tecplot") { requireCollectiveAndRootOnlyFilesMatch<ParallelTecplotWriter>(".plt"); }
+}
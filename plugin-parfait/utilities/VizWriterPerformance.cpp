@@ -0,0 +1,53 @@
+#include <MessagePasser/MessagePasser.h>
+#include <chrono>
+#include <iostream>
+#include <Viz/ParallelTecplotWriter.h>
+#include <Viz/ParallelVTKWriter.h>
+#include <t-infinity/CartMesh.h>
+#include <t-infinity/FieldTools.h>
+#include <parfait/ToString.h>
+
+template <typename Writer>
+double timeWrite(MessagePasser mp,
+                 std::string filename,
+                 std::shared_ptr<inf::MeshInterface> mesh,
+                 std::shared_ptr<inf::FieldInterface> field,
+                 bool collective) {
+    Writer writer(filename, mesh, mp.getCommunicator());
+    writer.addField(field);
+    writer.setCollectiveIO(collective);
+    mp.Barrier();
+    auto start = std::chrono::system_clock::now();
+    writer.write();
+    mp.Barrier();
+    auto end = std::chrono::system_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    MessagePasser::Init();
+    MessagePasser mp(MPI_COMM_WORLD);
+
+    int n = 50;
+    if (argc >= 2) n = std::stoi(argv[1]);
+    auto mesh = inf::CartMesh::create(mp, n, n, n);
+    if (mp.Rank() == 0)
+        printf("Writing a %d^3 cartesian mesh (%s cells) on %d ranks\n",
+               n,
+               Parfait::bigNumberToStringWithCommas(long(n) * n * n).c_str(),
+               mp.NumberOfProcesses());
+    auto field = inf::FieldTools::createNodeFieldFromCallback(
+        "x plus y", *mesh, [](double x, double y, double z) { return x + y; });
+
+    for (bool collective : {false, true}) {
+        std::string label = collective ? "collective" : "root-only";
+        double vtk = timeWrite<ParallelVTKWriter>(mp, label + ".vtk", mesh, field, collective);
+        double plt = timeWrite<ParallelTecplotWriter>(mp, label + ".plt", mesh, field, collective);
+        if (mp.Rank() == 0) {
+            std::cout << label << " vtk writing took: " << vtk << " seconds" << std::endl;
+            std::cout << label << " tecplot writing took: " << plt << " seconds" << std::endl;
+        }
+    }
+
+    MessagePasser::Finalize();
+}
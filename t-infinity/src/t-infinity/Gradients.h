@@ -1,6 +1,8 @@
 #pragma once
 
 #include <parfait/Throw.h>
+#include <parfait/CompressedRowGraph.h>
+#include <parfait/ThreadRanges.h>
 #include <parfait/LeastSquaresReconstruction.h>
 #include <parfait/ToString.h>
 #include <t-infinity/BoundaryNodes.h>
@@ -18,144 +20,234 @@
 
 namespace inf {
 
+// Linear least-squares gradients from the nodes sharing a cell with each node.
+//
+// The stencils and their coefficients are stored as compressed rows, with the
+// three coefficients of a stencil entry next to each other.  Coefficient setup
+// and stencil application are split over thread_count threads.  A batch of
+// fields is differentiated in one pass over the stencils: the field values of a
+// node are interleaved so the innermost loop runs over the fields contiguously.
 class NodeToNodeGradientCalculator {
   public:
-    inline NodeToNodeGradientCalculator(MessagePasser mp, std::shared_ptr<inf::MeshInterface> mesh)
+    inline NodeToNodeGradientCalculator(MessagePasser mp,
+                                        std::shared_ptr<inf::MeshInterface> mesh,
+                                        int thread_count = 1)
         : mp(mp),
           mesh(mesh),
-          node_stencils(inf::NodeToNode::buildForAnyNodeInSharedCell(*mesh)),
-          node_stencil_coeffs(mesh->nodeCount()),
+          thread_count(std::max(1, thread_count)),
           node_sync_pattern(inf::buildNodeSyncPattern(mp, *mesh)),
           node_g2l(inf::GlobalToLocal::buildNode(*mesh)) {
-        for (int n = 0; n < mesh->nodeCount(); n++) {
-            node_stencils.at(n).push_back(n);
-        }
-
-        auto calc_node_weights = [&](int n) {
-            if (mesh->nodeOwner(n) != mp.Rank()) {
-                node_stencils.at(n).resize(0);  // zero out this row's stencil.
-                return;
-            }
-            int num_neighbors = node_stencils.at(n).size();
-            node_stencil_coeffs.at(n).resize(num_neighbors);
-            auto get_neighbor_location = [&](int neighbor) {
-                int c = node_stencils.at(n)[neighbor];
-                Parfait::Point<double> p = mesh->node(c);
-                return p;
-            };
-            double distance_weight_power = 0.0;
-            Parfait::Point<double> node_location = mesh->node(n);
-            auto dimension = Parfait::detectStencilDimension(get_neighbor_location, num_neighbors);
-            auto row_coeffs = Parfait::calcLLSQCoefficients(get_neighbor_location,
-                                                            num_neighbors,
-                                                            distance_weight_power,
-                                                            node_location,
-                                                            Parfait::LSQDimensionality(dimension));
-            for (int i = 0; i < num_neighbors; i++) {
-                node_stencil_coeffs[n][i][0] = row_coeffs(i, 1);
-                node_stencil_coeffs[n][i][1] = row_coeffs(i, 2);
-                if (dimension > 2)
-                    node_stencil_coeffs[n][i][2] = row_coeffs(i, 3);
-                else
-                    node_stencil_coeffs[n][i][2] = 0.0;
-            }
-        };
-
-        for (int n = 0; n < mesh->nodeCount(); n++) {
-            calc_node_weights(n);
-        }
+        buildStencils();
+        calcStencilCoefficients();
     }
+
     inline std::vector<Parfait::Point<double>> calcGrad(const inf::FieldInterface& f) const {
-        if (f.size() != mesh->nodeCount() or f.association() != inf::FieldAttributes::Node()) {
-            PARFAIT_THROW(
-                "Cannot compute cell to node gradient if field is not defined at cells with "
-                "matching length");
-        }
+        throwIfNotNodeField(f);
         auto f_accessor = [&f](int n) { return extractValue(n, f); };
         return calcGrad(f_accessor);
     }
 
     inline std::vector<std::array<double, 6>> calcHessian(const inf::FieldInterface& f) const {
-        if (f.size() != mesh->nodeCount() or f.association() != inf::FieldAttributes::Node()) {
-            PARFAIT_THROW(
-                "Cannot compute cell to node gradient if field is not defined at cells with "
-                "matching length");
-        }
+        throwIfNotNodeField(f);
         auto f_accessor = [&f](int n) { return extractValue(n, f); };
         return calcHessian(f_accessor);
     }
 
-    template <typename FieldAccessor>
-    std::vector<Parfait::Point<double>> calcGrad(FieldAccessor f) const {
-        std::vector<Parfait::Point<double>> grad(mesh->nodeCount(),
-                                                 Parfait::Point<double>(0, 0, 0));
-
+    inline std::vector<std::vector<Parfait::Point<double>>> calcGrads(
+        const std::vector<std::shared_ptr<inf::FieldInterface>>& fields) const {
+        int field_count = int(fields.size());
+        auto grad = calcInterleavedGrads(extractInterleavedValues(fields), field_count);
+        std::vector<std::vector<Parfait::Point<double>>> grads(
+            field_count, std::vector<Parfait::Point<double>>(mesh->nodeCount()));
         for (int n = 0; n < mesh->nodeCount(); n++) {
-            for (int i = 0; i < int(node_stencils.at(n).size()); i++) {
-                PARFAIT_ASSERT(node_stencils.at(n).size() == node_stencil_coeffs.at(n).size(),
-                               "stencil coeff size mismatch");
+            for (int f = 0; f < field_count; f++) {
                 for (int e = 0; e < 3; e++) {
-                    grad[n][e] += node_stencil_coeffs.at(n).at(i)[e] * f(node_stencils.at(n)[i]);
+                    grads[f][n][e] = grad[(3 * long(n) + e) * field_count + f];
                 }
             }
         }
-        Parfait::syncVector(mp, grad, node_g2l, node_sync_pattern);
-        return grad;
+        return grads;
     }
 
-    template <typename FieldAccessor>
-    std::vector<std::array<double, 6>> calcHessian(FieldAccessor f) const {
-        auto grad = calcGrad(f);
-        std::vector<std::array<double, 6>> hess(mesh->nodeCount());
-
-        auto f_x = [&](int n) { return grad[n][0]; };
-        auto f_y = [&](int n) { return grad[n][1]; };
-        auto f_z = [&](int n) { return grad[n][2]; };
-
-        auto grad_f_x = calcGrad(f_x);
-        auto grad_f_y = calcGrad(f_y);
-        auto grad_f_z = calcGrad(f_z);
+    inline std::vector<std::vector<std::array<double, 6>>> calcHessians(
+        const std::vector<std::shared_ptr<inf::FieldInterface>>& fields) const {
+        int field_count = int(fields.size());
+        auto hess = calcInterleavedHessians(extractInterleavedValues(fields), field_count);
+        std::vector<std::vector<std::array<double, 6>>> hessians(
+            field_count, std::vector<std::array<double, 6>>(mesh->nodeCount()));
+        for (int n = 0; n < mesh->nodeCount(); n++) {
+            for (int f = 0; f < field_count; f++) {
+                for (int i = 0; i < 6; i++) {
+                    hessians[f][n][i] = hess[(6 * long(n) + i) * field_count + f];
+                }
+            }
+        }
+        return hessians;
+    }
 
-        for (int node = 0; node < mesh->nodeCount(); node++) {
-            double hess_xx = grad_f_x[node][0];
-            double hess_xy = 0.5 * (grad_f_x[node][1] + grad_f_y[node][0]);
-            double hess_xz = 0.5 * (grad_f_x[node][2] + grad_f_z[node][0]);
-            double hess_yy = grad_f_y[node][1];
-            double hess_yz = 0.5 * (grad_f_y[node][2] + grad_f_z[node][1]);
-            double hess_zz = grad_f_z[node][2];
-            hess[node][0] = hess_xx;
-            hess[node][1] = hess_xy;
-            hess[node][2] = hess_xz;
-            hess[node][3] = hess_yy;
-            hess[node][4] = hess_yz;
-            hess[node][5] = hess_zz;
+    template <typename FieldAccessor>
+    std::vector<Parfait::Point<double>> calcGrad(FieldAccessor f) const {
+        auto grad = calcInterleavedGrads(extractValues(f), 1);
+        std::vector<Parfait::Point<double>> points(mesh->nodeCount());
+        for (int n = 0; n < mesh->nodeCount(); n++) {
+            points[n] = {grad[3 * n + 0], grad[3 * n + 1], grad[3 * n + 2]};
         }
+        return points;
+    }
 
-        Parfait::syncVector(mp, hess, node_g2l, node_sync_pattern);
-        return hess;
+    template <typename FieldAccessor>
+    std::vector<std::array<double, 6>> calcHessian(FieldAccessor f) const {
+        auto hess = calcInterleavedHessians(extractValues(f), 1);
+        std::vector<std::array<double, 6>> hessian(mesh->nodeCount());
+        for (int n = 0; n < mesh->nodeCount(); n++) {
+            for (int i = 0; i < 6; i++) {
+                hessian[n][i] = hess[6 * n + i];
+            }
+        }
+        return hessian;
     }
 
   private:
     MessagePasser mp;
     std::shared_ptr<inf::MeshInterface> mesh;
-    std::vector<std::vector<int>> node_stencils;
-    std::vector<std::vector<Parfait::Point<double>>> node_stencil_coeffs;
+    int thread_count;
+    Parfait::CompressedRowGraph node_stencils;
+    std::vector<double> node_stencil_coeffs;
     Parfait::SyncPattern node_sync_pattern;
     std::map<long, int> node_g2l;
 
-    inline static double extractValue(int n, const inf::FieldInterface& f) {
-        double d;
-        f.value(n, &d);
-        return d;
+    inline void buildStencils() {
+        auto n2n = inf::NodeToNode::buildForAnyNodeInSharedCell(*mesh);
+        // Only owned nodes get a stencil; the gradient at ghost nodes comes from the sync.
+        node_stencils = Parfait::CompressedRowGraph::buildByRow(
+            mesh->nodeCount(),
+            [&](long n, std::vector<int>& stencil) {
+                if (mesh->nodeOwner(int(n)) != mp.Rank()) return;
+                stencil.assign(n2n[n].begin(), n2n[n].end());
+                stencil.push_back(int(n));
+            },
+            thread_count);
+    }
+
+    inline void calcStencilCoefficients() {
+        node_stencil_coeffs.assign(3 * node_stencils.entryCount(), 0.0);
+        const auto& offsets = node_stencils.rowOffsets();
+        Parfait::forEachThreadRange(thread_count, mesh->nodeCount(), [&](int, long start, long end) {
+            for (long n = start; n < end; n++) {
+                auto stencil = node_stencils[n];
+                int num_neighbors = int(stencil.size());
+                if (num_neighbors == 0) continue;
+                auto get_neighbor_location = [&](int neighbor) {
+                    Parfait::Point<double> p = mesh->node(stencil[neighbor]);
+                    return p;
+                };
+                double distance_weight_power = 0.0;
+                Parfait::Point<double> node_location = mesh->node(int(n));
+                auto dimension = Parfait::detectStencilDimension(get_neighbor_location, num_neighbors);
+                auto row_coeffs = Parfait::calcLLSQCoefficients(get_neighbor_location,
+                                                                num_neighbors,
+                                                                distance_weight_power,
+                                                                node_location,
+                                                                Parfait::LSQDimensionality(dimension));
+                double* coeffs = &node_stencil_coeffs[3 * offsets[n]];
+                for (int i = 0; i < num_neighbors; i++) {
+                    coeffs[3 * i + 0] = row_coeffs(i, 1);
+                    coeffs[3 * i + 1] = row_coeffs(i, 2);
+                    coeffs[3 * i + 2] = dimension > 2 ? row_coeffs(i, 3) : 0.0;
+                }
+            }
+        });
+    }
+
+    // values holds field_count values per node.  Returns the 3 * field_count
+    // derivatives of every node ordered [node][direction][field], not synced.
+    inline std::vector<double> applyStencils(const std::vector<double>& values, int field_count) const {
+        std::vector<double> grad(3 * long(field_count) * mesh->nodeCount(), 0.0);
+        const auto& offsets = node_stencils.rowOffsets();
+        const auto& neighbors = node_stencils.entries();
+        Parfait::forEachThreadRange(thread_count, mesh->nodeCount(), [&](int, long start, long end) {
+            for (long n = start; n < end; n++) {
+                double* g = &grad[3 * field_count * n];
+                for (long i = offsets[n]; i < offsets[n + 1]; i++) {
+                    const double* c = &node_stencil_coeffs[3 * i];
+                    const double* v = &values[long(field_count) * neighbors[i]];
+                    for (int e = 0; e < 3; e++) {
+                        double* g_e = g + e * field_count;
+                        for (int f = 0; f < field_count; f++) {
+                            g_e[f] += c[e] * v[f];
+                        }
+                    }
+                }
+            }
+        });
+        return grad;
+    }
+
+    inline std::vector<double> calcInterleavedGrads(const std::vector<double>& values, int field_count) const {
+        auto grad = applyStencils(values, field_count);
+        Parfait::syncStridedVector(mp, grad, node_g2l, node_sync_pattern, 3 * field_count);
+        return grad;
+    }
+
+    // Returns [node][xx, xy, xz, yy, yz, zz][field].  The gradients of all
+    // 3 * field_count first derivatives are taken in a single pass.
+    inline std::vector<double> calcInterleavedHessians(const std::vector<double>& values, int field_count) const {
+        auto grad = calcInterleavedGrads(values, field_count);
+        int k = field_count;
+        int first_derivative_count = 3 * k;
+        auto second = applyStencils(grad, first_derivative_count);
+        // d/dx_d of d/dx_e of field f
+        auto d2 = [&](long n, int d, int e, int f) {
+            return second[(3 * n + d) * first_derivative_count + e * k + f];
+        };
+        std::vector<double> hess(6 * long(k) * mesh->nodeCount());
+        for (long n = 0; n < mesh->nodeCount(); n++) {
+            double* h = &hess[6 * k * n];
+            for (int f = 0; f < k; f++) {
+                h[0 * k + f] = d2(n, 0, 0, f);
+                h[1 * k + f] = 0.5 * (d2(n, 1, 0, f) + d2(n, 0, 1, f));
+                h[2 * k + f] = 0.5 * (d2(n, 2, 0, f) + d2(n, 0, 2, f));
+                h[3 * k + f] = d2(n, 1, 1, f);
+                h[4 * k + f] = 0.5 * (d2(n, 2, 1, f) + d2(n, 1, 2, f));
+                h[5 * k + f] = d2(n, 2, 2, f);
+            }
+        }
+        Parfait::syncStridedVector(mp, hess, node_g2l, node_sync_pattern, 6 * k);
+        return hess;
     }
 
     template <typename FieldAccessor>
-    std::vector<double> extractHaloValues(const std::vector<int>& n2n, FieldAccessor f) const {
-        std::vector<double> halo_values;
-        for (size_t i = 0; i < n2n.size(); i++) {
-            halo_values.push_back(f(n2n[i]));
+    std::vector<double> extractValues(FieldAccessor f) const {
+        std::vector<double> values(mesh->nodeCount());
+        for (int n = 0; n < mesh->nodeCount(); n++) values[n] = f(n);
+        return values;
+    }
+
+    inline std::vector<double> extractInterleavedValues(
+        const std::vector<std::shared_ptr<inf::FieldInterface>>& fields) const {
+        for (auto& f : fields) throwIfNotNodeField(*f);
+        long field_count = long(fields.size());
+        std::vector<double> values(field_count * mesh->nodeCount());
+        for (int n = 0; n < mesh->nodeCount(); n++) {
+            for (long f = 0; f < field_count; f++) {
+                values[n * field_count + f] = extractValue(n, *fields[f]);
+            }
+        }
+        return values;
+    }
+
+    inline void throwIfNotNodeField(const inf::FieldInterface& f) const {
+        if (f.size() != mesh->nodeCount() or f.association() != inf::FieldAttributes::Node()) {
+            PARFAIT_THROW(
+                "Cannot compute node to node gradient if field is not defined at nodes with "
+                "matching length");
         }
-        return halo_values;
+    }
+
+    inline static double extractValue(int n, const inf::FieldInterface& f) {
+        double d;
+        f.value(n, &d);
+        return d;
     }
 };
 
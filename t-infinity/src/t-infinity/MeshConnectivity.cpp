@@ -1,4 +1,5 @@
 #include "MeshConnectivity.h"
+#include <algorithm>
 #include <parfait/CGNSElements.h>
 #include <parfait/CellWindingConverters.h>
 #include <parfait/EdgeBuilder.h>
@@ -53,6 +54,18 @@ std::vector<std::vector<int>> NodeToNode::buildSurfaceOnly(const inf::MeshInterf
     return n2n;
 }
 
+Parfait::CompressedRowGraph NodeToNode::buildCompressed(const inf::MeshInterface& mesh) {
+    auto edges = EdgeToNode::build(mesh);
+    auto n2n = Parfait::CompressedRowGraph::build(mesh.nodeCount(), [&](auto emit) {
+        for (auto& e : edges) {
+            emit(e[0], e[1]);
+            emit(e[1], e[0]);
+        }
+    });
+    n2n.sortAndRemoveDuplicates();
+    return n2n;
+}
+
 std::vector<std::array<int, 2>> NodeToNode::buildUniqueSurfaceEdgesForCellsTouchingNodes(
     const inf::MeshInterface& mesh, const std::set<int>& requested_nodes) {
     auto should_build_cell = [&](const std::array<int, 8> cell) {
@@ -104,6 +117,15 @@ std::vector<std::vector<int>> NodeToCell::build(const MeshInterface& mesh) {
     }
     return node_to_cell;
 }
+Parfait::CompressedRowGraph NodeToCell::buildCompressed(const MeshInterface& mesh) {
+    std::vector<int> cell;
+    return Parfait::CompressedRowGraph::build(mesh.nodeCount(), [&](auto emit) {
+        for (int cell_id = 0; cell_id < mesh.cellCount(); cell_id++) {
+            mesh.cell(cell_id, cell);
+            for (int node : cell) emit(node, cell_id);
+        }
+    });
+}
 std::vector<std::vector<int>> NodeToCell::buildVolumeOnly(const inf::MeshInterface& mesh) {
     return buildDimensionOnly(mesh, 3);
 }
@@ -152,6 +174,27 @@ std::vector<std::vector<int>> CellToCell::build(const inf::MeshInterface& mesh)
     return build(mesh, NodeToCell::build(mesh));
 }
 
+Parfait::CompressedRowGraph CellToCell::buildCompressed(const inf::MeshInterface& mesh,
+                                                        const Parfait::CompressedRowGraph& n2c,
+                                                        int thread_count) {
+    return Parfait::CompressedRowGraph::buildByRow(
+        mesh.cellCount(),
+        [&](long c, std::vector<int>& neighbors) {
+            thread_local std::vector<int> nodes;
+            mesh.cell(c, nodes);
+            for (int node : nodes)
+                for (int neighbor : n2c[node])
+                    if (neighbor != c) neighbors.push_back(neighbor);
+            std::sort(neighbors.begin(), neighbors.end());
+            neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        },
+        thread_count);
+}
+
+Parfait::CompressedRowGraph CellToCell::buildCompressed(const inf::MeshInterface& mesh) {
+    return buildCompressed(mesh, NodeToCell::buildCompressed(mesh));
+}
+
 std::vector<std::vector<int>> CellToCell::buildDimensionOnly(
     const MeshInterface& mesh, const std::vector<std::vector<int>>& n2c, int dimension) {
     std::vector<std::vector<int>> c2c(mesh.cellCount());
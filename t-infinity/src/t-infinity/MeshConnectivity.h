@@ -1,5 +1,6 @@
 #pragma once
 #include "MeshInterface.h"
+#include <parfait/CompressedRowGraph.h>
 #include <set>
 #include <vector>
 
@@ -8,6 +9,7 @@ namespace NodeToNode {
     std::vector<std::vector<int>> buildForAnyNodeInSharedCell(const inf::MeshInterface& mesh);
     std::vector<std::vector<int>> build(const inf::MeshInterface& mesh);
     std::vector<std::vector<int>> buildSurfaceOnly(const inf::MeshInterface& mesh);
+    Parfait::CompressedRowGraph buildCompressed(const inf::MeshInterface& mesh);
     std::vector<std::array<int, 2>> buildUniqueSurfaceEdgesForCellsTouchingNodes(
         const inf::MeshInterface& mesh, const std::set<int>& requested_nodes);
 }
@@ -16,6 +18,7 @@ namespace NodeToCell {
     std::vector<std::vector<int>> buildDimensionOnly(const inf::MeshInterface& mesh, int dimension);
     std::vector<std::vector<int>> buildVolumeOnly(const inf::MeshInterface& mesh);
     std::vector<std::vector<int>> buildSurfaceOnly(const inf::MeshInterface& mesh);
+    Parfait::CompressedRowGraph buildCompressed(const inf::MeshInterface& mesh);
 }
 namespace CellToCell {
     std::vector<std::vector<int>> build(const inf::MeshInterface& mesh,
@@ -25,6 +28,10 @@ namespace CellToCell {
     std::vector<std::vector<int>> buildDimensionOnly(const inf::MeshInterface& mesh,
                                                      const std::vector<std::vector<int>>& n2c,
                                                      int dimension);
+    Parfait::CompressedRowGraph buildCompressed(const inf::MeshInterface& mesh,
+                                                const Parfait::CompressedRowGraph& n2c,
+                                                int thread_count = 1);
+    Parfait::CompressedRowGraph buildCompressed(const inf::MeshInterface& mesh);
 }
 namespace EdgeToCell {
     std::vector<std::vector<int>> build(const inf::MeshInterface& mesh,
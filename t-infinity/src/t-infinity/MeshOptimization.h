@@ -21,7 +21,7 @@ class MeshOptimization {
           mesh(mesh_in),
           sync_pattern(buildNodeSyncPattern(mp, *mesh)),
           node_g2l(buildGlobalToLocalNode(mesh->mesh)) {
-        n2n = inf::NodeToNode::build(*mesh);
+        n2n = inf::NodeToNode::buildCompressed(*mesh);
         n2c_volume = inf::NodeToCell::buildVolumeOnly(*mesh);
         n2c_surface = inf::NodeToCell::buildSurfaceOnly(*mesh);
         frozen_tags = extractAllTagsWithDimensionality(mp, *mesh, 2);
@@ -354,7 +354,7 @@ class MeshOptimization {
     std::vector<int> node_types;
     std::vector<int> node_projection_surface_tag;
 
-    std::vector<std::vector<int>> n2n;
+    Parfait::CompressedRowGraph n2n;
     std::vector<std::vector<int>> n2c_volume;
     std::vector<std::vector<int>> n2c_surface;
     std::vector<double> node_step_length;
@@ -6,7 +6,7 @@
 
 namespace inf {
 inline std::vector<double> calcNodeAvgLength(const MeshInterface& mesh) {
-    auto n2n = NodeToNode::build(mesh);
+    auto n2n = NodeToNode::buildCompressed(mesh);
     std::vector<double> avg_length(mesh.nodeCount());
 
     for (int n = 0; n < mesh.nodeCount(); n++) {
@@ -23,7 +23,7 @@ inline std::vector<double> calcNodeAvgLength(const MeshInterface& mesh) {
     return avg_length;
 }
 inline std::vector<double> calcNodeMinLength(const MeshInterface& mesh) {
-    auto n2n = NodeToNode::build(mesh);
+    auto n2n = NodeToNode::buildCompressed(mesh);
     std::vector<double> min_length(mesh.nodeCount());
 
     for (int n = 0; n < mesh.nodeCount(); n++) {
@@ -6,6 +6,7 @@
 #include "MeshInquisitor.h"
 #include "MeshHelpers.h"
 #include "Cell.h"
+#include "Gradients.h"
 #include <parfait/Plane.h>
 
 namespace inf {
@@ -194,7 +195,7 @@ std::shared_ptr<inf::FieldInterface> MetricManipulator::toNode9ElementHessianFie
         "hessian", inf::FieldAttributes::Node(), 9, hessian_as_9_elements);
 }
 std::shared_ptr<inf::FieldInterface> MetricManipulator::toNode9ElementHessianField(
-    const std::vector<std::array<double, 6>>& hessian) {
+    const std::vector<std::array<double, 6>>& hessian, const std::string& name) {
     std::vector<double> hessian_as_9_elements(9 * hessian.size());
     std::array<int, 9> ij_to_i = {0, 1, 2, 1, 3, 4, 2, 4, 5};
     for (int n = 0; n < int(hessian.size()); n++) {
@@ -206,7 +207,7 @@ std::shared_ptr<inf::FieldInterface> MetricManipulator::toNode9ElementHessianFie
         }
     }
     return std::make_shared<inf::VectorFieldAdapter>(
-        "hessian", inf::FieldAttributes::Node(), 9, hessian_as_9_elements);
+        name, inf::FieldAttributes::Node(), 9, hessian_as_9_elements);
 }
 std::shared_ptr<inf::FieldInterface> MetricManipulator::toRefineHessian(
     const std::vector<Tensor>& hessian) {
@@ -218,6 +219,31 @@ std::shared_ptr<inf::FieldInterface> MetricManipulator::toRefineHessian(
     // refine assumes 9 element fields are hessians.
     return toNode9ElementHessianField(H);
 }
+std::vector<std::shared_ptr<inf::FieldInterface>> MetricManipulator::scalarsToRefineHessians(
+    MessagePasser mp,
+    std::shared_ptr<inf::MeshInterface> mesh,
+    const std::vector<std::shared_ptr<inf::FieldInterface>>& fields,
+    int thread_count) {
+    auto is_scalar = [](const FieldInterface& f) {
+        return f.blockSize() == 1 and f.association() == inf::FieldAttributes::Node();
+    };
+    std::vector<std::shared_ptr<FieldInterface>> scalars;
+    for (auto& f : fields)
+        if (is_scalar(*f)) scalars.push_back(f);
+    if (scalars.empty()) return fields;
+
+    auto hessians = NodeToNodeGradientCalculator(mp, mesh, thread_count).calcHessians(scalars);
+    std::vector<std::shared_ptr<FieldInterface>> out;
+    int next = 0;
+    for (auto& f : fields) {
+        if (is_scalar(*f))
+            // refine assumes 9 element fields are hessians.
+            out.push_back(toNode9ElementHessianField(hessians[next++], f->name()));
+        else
+            out.push_back(f);
+    }
+    return out;
+}
 std::shared_ptr<inf::FieldInterface> MetricManipulator::calcImpliedMetricAtNodes(
     const inf::MeshInterface& mesh, int dimensionality) {
     using namespace Parfait;
@@ -83,11 +83,20 @@ class MetricManipulator {
     static std::shared_ptr<inf::FieldInterface> toNode9ElementHessianField(
         const std::vector<Tensor>& metric);
     static std::shared_ptr<inf::FieldInterface> toNode9ElementHessianField(
-        const std::vector<std::array<double, 6>>& H);
+        const std::vector<std::array<double, 6>>& H, const std::string& name = "hessian");
     static std::shared_ptr<inf::FieldInterface> toRefineHessian(const std::vector<Tensor>& H);
     static std::shared_ptr<inf::FieldInterface> toRefineHessian(
         const std::vector<std::array<double, 6>>& H);
 
+    // Replaces each scalar node field with its 9 element Hessian (same name),
+    // all taken in one batched pass over the gradient stencils on thread_count
+    // threads.  Other fields are passed through unchanged.
+    static std::vector<std::shared_ptr<inf::FieldInterface>> scalarsToRefineHessians(
+        MessagePasser mp,
+        std::shared_ptr<inf::MeshInterface> mesh,
+        const std::vector<std::shared_ptr<inf::FieldInterface>>& fields,
+        int thread_count = 1);
+
   private:
     static std::vector<Tensor> calcImpliedMetricAtCellsWithDimensionality(
         const MeshInterface& mesh, int target_dimensionality);
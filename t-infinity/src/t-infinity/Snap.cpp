@@ -12,6 +12,53 @@
 #include <Tracer.h>
 
 using namespace inf;
+
+namespace {
+// Lets the FileStreamer based header writers produce bytes for MPI-IO.
+class ByteBuffer : public FileStreamer {
+  public:
+    std::vector<char> bytes;
+    bool openWrite(std::string) override { return true; }
+    bool openRead(std::string) override { return false; }
+    void write(const void* data, size_t item_size, size_t num_items) override {
+        auto begin = static_cast<const char*>(data);
+        bytes.insert(bytes.end(), begin, begin + item_size * num_items);
+    }
+    void read(void*, size_t, size_t) override { PARFAIT_THROW("ByteBuffer is write only"); }
+    void skip(size_t) override { PARFAIT_THROW("ByteBuffer is write only"); }
+    void close() override {}
+};
+
+struct FieldLocation {
+    std::unordered_map<std::string, std::string> attributes;
+    long n_global_items;
+    long entry_length;
+    long data_offset;
+};
+
+// Which global ids this rank asks each rank for, and which ids each rank asks
+// of this rank, when every rank holds a contiguous range of global ids.
+struct SlabRequests {
+    std::vector<std::vector<long>> gids_i_want;
+    std::vector<std::vector<long>> gids_wanted_from_me;
+};
+
+SlabRequests buildSlabRequests(const MessagePasser& mp,
+                               const Parfait::Topology& top,
+                               long n_global_items) {
+    SlabRequests requests;
+    requests.gids_i_want.resize(mp.NumberOfProcesses());
+    for (auto& pair : top.global_to_local) {
+        long global = pair.first;
+        if (global < 0 or global >= n_global_items) continue;
+        auto owner = Parfait::LinearPartitioner::getWorkerOfWorkItem(
+            global, n_global_items, mp.NumberOfProcesses());
+        requests.gids_i_want[owner].push_back(global);
+    }
+    requests.gids_wanted_from_me = mp.Exchange(requests.gids_i_want);
+    return requests;
+}
+}
 Snap::Snap(MPI_Comm comm) : mp(comm) {
     if (mp.Rank() == 0) {
         if (Parfait::FileTools::doesFileExist("backdoor.poml")) {
@@ -21,9 +68,13 @@ Snap::Snap(MPI_Comm comm) : mp(comm) {
                 int target_chunk_size = settings.at("snap_chunk_size_mb").asInt();
                 chunk_max_size_in_MB = std::max(target_chunk_size, 1);
             }
+            if (settings.has("snap_collective_io")) {
+                collective_io = settings.at("snap_collective_io").asBool();
+            }
         }
     }
     mp.Broadcast(chunk_max_size_in_MB, 0);
+    mp.Broadcast(collective_io, 0);
 }
 
 Snap::Snap(MessagePasser m) : Snap(m.getCommunicator()) {}
@@ -68,7 +119,10 @@ void Snap::load(std::string filename) {
     if (extension != "snap") {
         filename += ".snap";
     }
-    fields = readFields(filename);
+    if (collective_io)
+        fields = readFieldsCollectively(filename);
+    else
+        fields = readFields(filename);
     Tracer::end(__FUNCTION__);
 }
 
@@ -189,6 +243,10 @@ void Snap::writeFile(std::string filename) const {
     if (extension != "snap") {
         filename += ".snap";
     }
+    if (collective_io) {
+        writeFileCollectively(filename);
+        return;
+    }
 
     if (0 == mp.Rank()) {
         f = FileStreamer::create("default");
@@ -492,8 +550,196 @@ void Snap::writeField(FileStreamer& f, const FieldInterface& field) const {
     Tracer::end("write field " + field.name());
 }
 
+void Snap::writeFileCollectively(std::string filename) const {
+    Tracer::begin(__FUNCTION__);
+    for (auto& field : fields) getTopology(field.second->attribute(FieldAttributes::Association()));
+    // Like the serial writer, the file is named by rank 0.
+    mp.Broadcast(filename, 0);
+
+    ByteBuffer header;
+    if (0 == mp.Rank()) writeHeader(filename, header);
+    long header_size = header.bytes.size();
+    mp.Broadcast(header_size, 0);
+
+    MPI_File f;
+    int error = MPI_File_open(mp.getCommunicator(),
+                              filename.c_str(),
+                              MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                              MPI_INFO_NULL,
+                              &f);
+    if (MPI_SUCCESS != error) PARFAIT_THROW("Could not open file for snap writing: " + filename);
+    MPI_File_set_size(f, 0);
+
+    mp.WriteAtAll(f, 0, header.bytes.data(), header.bytes.size());
+    long offset = header_size;
+    for (auto& field : fields) offset = writeFieldCollectively(f, offset, *field.second);
+
+    MPI_File_close(&f);
+    Tracer::end(__FUNCTION__);
+}
+
+long Snap::writeFieldCollectively(MPI_File f, long offset, const FieldInterface& field) const {
+    Tracer::begin("write field " + field.name());
+    auto& top = getTopology(field.attribute(FieldAttributes::Association()));
+    long n_global_items = countGlobalItems(top.global_ids);
+    int stride = field.blockSize();
+    int nranks = mp.NumberOfProcesses();
+
+    ByteBuffer header;
+    if (0 == mp.Rank())
+        writeFieldHeader(header, n_global_items, stride, field.getAllAttributes());
+    long header_size = header.bytes.size();
+    mp.Broadcast(header_size, 0);
+
+    Tracer::begin("send to slab owners");
+    std::vector<std::vector<long>> gids_for_ranks(nranks);
+    std::vector<std::vector<double>> values_for_ranks(nranks);
+    std::vector<double> value(stride);
+    for (int local = 0; local < int(top.global_ids.size()); local++) {
+        if (not top.do_own[local]) continue;
+        long global = top.global_ids[local];
+        auto owner = Parfait::LinearPartitioner::getWorkerOfWorkItem(global, n_global_items, nranks);
+        field.value(local, value.data());
+        gids_for_ranks[owner].push_back(global);
+        values_for_ranks[owner].insert(values_for_ranks[owner].end(), value.begin(), value.end());
+    }
+    auto gids_from_ranks = mp.Exchange(gids_for_ranks);
+    auto values_from_ranks = mp.Exchange(values_for_ranks);
+    Tracer::end("send to slab owners");
+
+    auto range = Parfait::LinearPartitioner::getRangeForWorker(mp.Rank(), n_global_items, nranks);
+    std::vector<double> slab((range.end - range.start) * stride, 0.0);
+    for (int r = 0; r < nranks; r++) {
+        auto& gids = gids_from_ranks[r];
+        auto& values = values_from_ranks[r];
+        for (size_t i = 0; i < gids.size(); i++)
+            std::copy(values.begin() + i * stride,
+                      values.begin() + (i + 1) * stride,
+                      slab.begin() + (gids[i] - range.start) * stride);
+    }
+
+    Tracer::begin("write slab");
+    mp.WriteAtAll(f, offset, header.bytes.data(), header.bytes.size());
+    long data_offset = offset + header_size;
+    mp.WriteAtAll(f,
+               data_offset + range.start * stride * sizeof(double),
+               slab.data(),
+               slab.size() * sizeof(double));
+    Tracer::end("write slab");
+    Tracer::end("write field " + field.name());
+    return data_offset + n_global_items * stride * sizeof(double);
+}
+
+std::map<std::string, std::shared_ptr<inf::FieldInterface>> Snap::readFieldsCollectively(
+    std::string filename) {
+    Tracer::begin(__FUNCTION__);
+    if (topologies.empty())
+        PARFAIT_THROW(
+            "Cannot read snap file, you haven't registered any topology (NODE, CELL, FACE, "
+            "etc...)");
+    mp.Broadcast(filename, 0);
+
+    Tracer::begin("locate fields");
+    int nfields = 0;
+    std::vector<FieldLocation> locations;
+    if (0 == mp.Rank()) {
+        auto f = FileStreamer::create("default");
+        openFileAndReadHeader(filename, nfields, *f);
+        long offset = 2 * sizeof(u_int64_t);
+        for (int i = 0; i < nfields; i++) {
+            FieldLocation location;
+            size_t n_global_items, entry_length;
+            location.attributes = readFieldHeader(*f, n_global_items, entry_length);
+            location.n_global_items = n_global_items;
+            location.entry_length = entry_length;
+            if (version_read == 2)
+                offset += 3 * sizeof(u_int64_t) + sizeof(int) +
+                          location.attributes.at(FieldAttributes::name()).size();
+            else
+                offset += 3 * sizeof(u_int64_t) + SnapIOHelpers::calcMapSize(location.attributes);
+            location.data_offset = offset;
+            long data_bytes = n_global_items * entry_length * sizeof(double);
+            f->skip(data_bytes);
+            offset += data_bytes;
+            locations.push_back(location);
+        }
+        f->close();
+    }
+    mp.Broadcast(nfields, 0);
+    locations.resize(nfields);
+    for (auto& location : locations) {
+        mp.Broadcast(location.attributes, 0);
+        mp.Broadcast(location.n_global_items, 0);
+        mp.Broadcast(location.entry_length, 0);
+        mp.Broadcast(location.data_offset, 0);
+    }
+    Tracer::end("locate fields");
+
+    MPI_File f;
+    int error =
+        MPI_File_open(mp.getCommunicator(), filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &f);
+    if (MPI_SUCCESS != error) PARFAIT_THROW("Couldn't open file: " + filename);
+
+    std::map<std::pair<Association, long>, SlabRequests> requests_for_topologies;
+    std::map<std::string, std::shared_ptr<inf::FieldInterface>> fields_from_file;
+    for (auto& location : locations) {
+        auto association = location.attributes.at(FieldAttributes::Association());
+        auto& top = getTopology(association);
+        long stride = location.entry_length;
+        auto range = Parfait::LinearPartitioner::getRangeForWorker(
+            mp.Rank(), location.n_global_items, mp.NumberOfProcesses());
+
+        Tracer::begin("read slab");
+        std::vector<double> slab((range.end - range.start) * stride);
+        mp.ReadAtAll(f,
+                  location.data_offset + range.start * stride * sizeof(double),
+                  slab.data(),
+                  slab.size() * sizeof(double));
+        Tracer::end("read slab");
+
+        Tracer::begin("send to requesters");
+        auto key = std::make_pair(association, location.n_global_items);
+        if (requests_for_topologies.count(key) == 0)
+            requests_for_topologies[key] = buildSlabRequests(mp, top, location.n_global_items);
+        auto& requests = requests_for_topologies.at(key);
+
+        std::vector<std::vector<double>> values_for_ranks(mp.NumberOfProcesses());
+        for (size_t r = 0; r < values_for_ranks.size(); r++) {
+            for (long global : requests.gids_wanted_from_me[r]) {
+                auto begin = slab.begin() + (global - range.start) * stride;
+                values_for_ranks[r].insert(values_for_ranks[r].end(), begin, begin + stride);
+            }
+        }
+        auto values_from_ranks = mp.Exchange(values_for_ranks);
+
+        std::vector<double> field_data(top.global_ids.size() * stride);
+        for (size_t r = 0; r < values_from_ranks.size(); r++) {
+            auto& gids = requests.gids_i_want[r];
+            auto& values = values_from_ranks[r];
+            for (size_t i = 0; i < gids.size(); i++)
+                for (auto local : top.global_to_local.at(gids[i]))
+                    std::copy(values.begin() + i * stride,
+                              values.begin() + (i + 1) * stride,
+                              field_data.begin() + local * stride);
+        }
+        Tracer::end("send to requesters");
+
+        auto name = location.attributes.at(FieldAttributes::name());
+        auto output_field =
+            std::make_shared<inf::VectorFieldAdapter>(name, association, stride, field_data);
+        output_field->setAdapterAttributes(location.attributes);
+        fields_from_file[name] = output_field;
+    }
+
+    MPI_File_close(&f);
+    Tracer::end(__FUNCTION__);
+    return fields_from_file;
+}
+
 void Snap::setMaxChunkSizeInMB(size_t chunk_size) { chunk_max_size_in_MB = chunk_size; }
 
+void Snap::setCollectiveIO(bool use_collective_io) { collective_io = use_collective_io; }
+
 const Parfait::Topology& Snap::getTopology(std::string association) const {
     if (topologies.count(association) == 0) {
         PARFAIT_THROW("Attempting to access Topology for Unknown Association: " + association);
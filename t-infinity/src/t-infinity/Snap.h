@@ -24,6 +24,10 @@ class Snap {
     void writeFile(std::string filename) const;
     std::vector<std::string> availableFields() const;
     void setMaxChunkSizeInMB(size_t chunk_size);
+    // Collective I/O (the default) has every rank read and write its own
+    // contiguous range of global ids with MPI-IO.  Otherwise rank 0 does all
+    // file access in chunks.  The file format is the same either way.
+    void setCollectiveIO(bool use_collective_io);
     bool has(std::string field_name) const;
     inline void clear() { fields.clear(); }
 
@@ -45,11 +49,16 @@ class Snap {
     std::map<Association, Parfait::Topology> topologies;
     std::map<std::string, std::shared_ptr<inf::FieldInterface>> fields;
     size_t chunk_max_size_in_MB = 10;
+    bool collective_io = true;
     u_int64_t version_read = 0;
     u_int64_t latest_version = 3;
 
     std::map<long, std::set<int>> buildGlobalToLocals(const std::vector<long>& gids) const;
     void writeField(FileStreamer& f, const FieldInterface& field) const;
+    void writeFileCollectively(std::string filename) const;
+    long writeFieldCollectively(MPI_File f, long offset, const FieldInterface& field) const;
+    std::map<std::string, std::shared_ptr<inf::FieldInterface>> readFieldsCollectively(
+        std::string filename);
     std::map<std::string, std::shared_ptr<inf::FieldInterface>> readFields(
         const std::string& filename);
     long countGlobalItems(const std::vector<long>& global_ids) const;
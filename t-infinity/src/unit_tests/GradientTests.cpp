@@ -39,6 +39,79 @@ TEST_CASE("Node to Node 2D gradients are exact for linear function", "[grad]") {
     }
 }
 
+TEST_CASE("Node to Node gradients of a batch of fields match one field at a time", "[grad]") {
+    auto mp = MessagePasser(MPI_COMM_WORLD);
+    std::shared_ptr<inf::MeshInterface> mesh = inf::CartMesh::create(mp, 4, 5, 6);
+
+    auto quadratic = [](double x, double y, double z) { return x * y + 2 * z * z - y; };
+    auto cubic = [](double x, double y, double z) { return x * x * x + y * z + 3 * x; };
+    std::vector<std::shared_ptr<inf::FieldInterface>> fields = {
+        inf::createNodeField(inf::test::fillFieldAtNodes(*mesh, quadratic)),
+        inf::createNodeField(inf::test::fillFieldAtNodes(*mesh, cubic))};
+
+    inf::NodeToNodeGradientCalculator serial(mp, mesh);
+    int thread_count = 3;
+    inf::NodeToNodeGradientCalculator threaded(mp, mesh, thread_count);
+    auto grads = threaded.calcGrads(fields);
+    auto hessians = threaded.calcHessians(fields);
+    REQUIRE(2 == grads.size());
+    REQUIRE(2 == hessians.size());
+    for (size_t f = 0; f < fields.size(); f++) {
+        auto grad = serial.calcGrad(*fields[f]);
+        auto hess = serial.calcHessian(*fields[f]);
+        for (int n = 0; n < mesh->nodeCount(); n++) {
+            for (int e = 0; e < 3; e++) REQUIRE(grads[f][n][e] == Approx(grad[n][e]).margin(1.0e-10));
+            for (int i = 0; i < 6; i++) REQUIRE(hessians[f][n][i] == Approx(hess[n][i]).margin(1.0e-10));
+        }
+    }
+}
+
+TEST_CASE("Batched, threaded node to node derivatives are exact for linear and quadratic fields", "[grad]") {
+    auto mp = MessagePasser(MPI_COMM_WORLD);
+    std::shared_ptr<inf::MeshInterface> mesh = inf::CartMesh::create(mp, 6, 6, 6);
+
+    auto linear = [](double x, double y, double z) { return 4 * x + 3 * y - z; };
+    auto quadratic = [](double x, double y, double z) { return x * x + 2 * x * y - 3 * y * z + 0.5 * z * z; };
+    std::vector<std::shared_ptr<inf::FieldInterface>> fields = {
+        inf::createNodeField(inf::test::fillFieldAtNodes(*mesh, linear)),
+        inf::createNodeField(inf::test::fillFieldAtNodes(*mesh, quadratic))};
+
+    int thread_count = 3;
+    inf::NodeToNodeGradientCalculator calculator(mp, mesh, thread_count);
+    auto grads = calculator.calcGrads(fields);
+    auto hessians = calculator.calcHessians(fields);
+
+    // The stencils are symmetric only away from the boundary: gradients of a
+    // quadratic are exact one layer in, and Hessians (gradients of gradients)
+    // two layers in.
+    double h = 1.0 / 6.0;
+    auto is_interior = [&](const Parfait::Point<double>& p, int layers) {
+        for (int i = 0; i < 3; i++)
+            if (p[i] < layers * h - 1.0e-12 or p[i] > 1.0 - layers * h + 1.0e-12) return false;
+        return true;
+    };
+    std::array<double, 6> quadratic_hessian = {2.0, 2.0, 0.0, 0.0, -3.0, 1.0};
+    int checked_hessians = 0;
+    for (int n = 0; n < mesh->nodeCount(); n++) {
+        Parfait::Point<double> p = mesh->node(n);
+        REQUIRE(grads[0][n][0] == Approx(4.0));
+        REQUIRE(grads[0][n][1] == Approx(3.0));
+        REQUIRE(grads[0][n][2] == Approx(-1.0));
+        for (int i = 0; i < 6; i++) REQUIRE(hessians[0][n][i] == Approx(0.0).margin(1.0e-8));
+        if (is_interior(p, 1)) {
+            REQUIRE(grads[1][n][0] == Approx(2 * p[0] + 2 * p[1]).margin(1.0e-10));
+            REQUIRE(grads[1][n][1] == Approx(2 * p[0] - 3 * p[2]).margin(1.0e-10));
+            REQUIRE(grads[1][n][2] == Approx(-3 * p[1] + p[2]).margin(1.0e-10));
+        }
+        if (is_interior(p, 2)) {
+            for (int i = 0; i < 6; i++)
+                REQUIRE(hessians[1][n][i] == Approx(quadratic_hessian[i]).margin(1.0e-8));
+            checked_hessians++;
+        }
+    }
+    REQUIRE(mp.ParallelSum(checked_hessians) > 0);
+}
+
 TEST_CASE("Cell to node gradients are linearly accurate") {
     auto mp = MessagePasser(MPI_COMM_SELF);
     std::shared_ptr<inf::MeshInterface> mesh = inf::CartMesh::create2D(mp, 5, 5);
@@ -3,6 +3,7 @@
 #include <t-infinity/TinfMesh.h>
 #include <t-infinity/MetricManipulator.h>
 #include <t-infinity/CartMesh.h>
+#include <t-infinity/FieldTools.h>
 #include <t-infinity/MeshShard.h>
 #include <t-infinity/MeshAdaptionInterface.h>
 #include <t-infinity/PluginLocator.h>
@@ -175,3 +176,31 @@ TEST_CASE("Calculate implied complexity in parallel") {
     double expected_complexity = 7.071068e+02;
     REQUIRE(expected_complexity == Approx(complexity));
 }
+
+TEST_CASE("Scalar node fields are replaced by their refine Hessians") {
+    auto mp = MessagePasser(MPI_COMM_WORLD);
+    std::shared_ptr<MeshInterface> mesh = CartMesh::create(mp, 6, 6, 6);
+    auto quadratic = FieldTools::createNodeFieldFromCallback(
+        "quadratic", *mesh, [](double x, double y, double z) { return x * x + 2 * x * y - 3 * y * z; });
+    auto metric = MetricManipulator::calcImpliedMetricAtNodes(*mesh, 3);
+
+    auto fields = MetricManipulator::scalarsToRefineHessians(mp, mesh, {quadratic, metric}, 2);
+    REQUIRE(2 == fields.size());
+    REQUIRE(metric == fields[1]);
+    REQUIRE("quadratic" == fields[0]->name());
+    REQUIRE(9 == fields[0]->blockSize());
+
+    std::array<double, 9> expected = {2, 2, 0, 2, 0, -3, 0, -3, 0};
+    int checked = 0;
+    for (int n = 0; n < mesh->nodeCount(); n++) {
+        Parfait::Point<double> p = mesh->node(n);
+        bool deep_interior = true;
+        for (int i = 0; i < 3; i++) deep_interior = deep_interior and p[i] > 0.3 and p[i] < 0.7;
+        if (not deep_interior) continue;
+        std::array<double, 9> H;
+        fields[0]->value(n, H.data());
+        for (int i = 0; i < 9; i++) REQUIRE(H[i] == Approx(expected[i]).margin(1.0e-8));
+        checked++;
+    }
+    REQUIRE(mp.ParallelSum(checked) > 0);
+}
@@ -1,4 +1,5 @@
 #include <RingAssertions.h>
+#include <parfait/FileTools.h>
 #include <parfait/StringTools.h>
 #include <parfait/LinearPartitioner.h>
 #include <t-infinity/Snap.h>
@@ -391,4 +392,68 @@ TEST_CASE("Can write and read fields from shortcut") {
     REQUIRE(fields[0]->name() == "my-cool-node-field");
     REQUIRE(fields[0]->getDouble(node_id) == 8.88);
     REQUIRE(fields[0]->getDouble(0) == 7.77);
-}
\ No newline at end of file
+}
+TEST_CASE("Collective and serial snap I/O agree") {
+    auto mp = MessagePasser(MPI_COMM_WORLD);
+    std::string hash = Parfait::StringTools::randomLetters(6);
+    mp.Broadcast(hash, 0);
+    std::string collective_file = "collective-" + hash + ".snap";
+    std::string serial_file = "serial-" + hash + ".snap";
+
+    // every rank owns an interleaved set of gids and ghosts its neighbor's first one
+    int nranks = mp.NumberOfProcesses();
+    int next = (mp.Rank() + 1) % nranks;
+    std::vector<long> global_ids;
+    std::vector<bool> do_own;
+    for (long gid = mp.Rank(); gid < 10 * nranks; gid += nranks) {
+        global_ids.push_back(gid);
+        do_own.push_back(true);
+    }
+    if (nranks > 1) {
+        global_ids.push_back(next);
+        do_own.push_back(false);
+    }
+    std::vector<double> velocity, pressure;
+    for (auto gid : global_ids) {
+        bool stale = gid % nranks != mp.Rank();
+        pressure.push_back(stale ? -1.0 : 0.5 * gid);
+        for (int i = 0; i < 3; i++) velocity.push_back(stale ? -1.0 : 10 * gid + i);
+    }
+
+    Snap snap(mp);
+    snap.setTopology(FieldAttributes::Node(), global_ids, do_own);
+    snap.add(std::make_shared<VectorFieldAdapter>("velocity", FieldAttributes::Node(), 3, velocity));
+    snap.add(std::make_shared<VectorFieldAdapter>("pressure", FieldAttributes::Node(), 1, pressure));
+    snap.setCollectiveIO(true);
+    snap.writeFile(collective_file);
+    snap.setCollectiveIO(false);
+    snap.writeFile(serial_file);
+    mp.Barrier();
+
+    if (0 == mp.Rank()) {
+        REQUIRE(Parfait::FileTools::loadFileToString(collective_file) ==
+                Parfait::FileTools::loadFileToString(serial_file));
+    }
+
+    std::vector<long> reversed(global_ids.rbegin(), global_ids.rend());
+    std::vector<bool> reversed_do_own(do_own.rbegin(), do_own.rend());
+    for (bool collective : {true, false}) {
+        Snap incoming(mp);
+        incoming.setCollectiveIO(collective);
+        incoming.setTopology(FieldAttributes::Node(), reversed, reversed_do_own);
+        incoming.load(collective_file);
+        auto v = incoming.retrieve("velocity");
+        auto p = incoming.retrieve("pressure");
+        for (int local = 0; local < int(reversed.size()); local++) {
+            REQUIRE(0.5 * reversed[local] == p->getDouble(local));
+            std::vector<double> value(3);
+            v->value(local, value.data());
+            for (int i = 0; i < 3; i++) REQUIRE(10 * reversed[local] + i == value[i]);
+        }
+    }
+    mp.Barrier();
+    if (0 == mp.Rank()) {
+        remove(collective_file.c_str());
+        remove(serial_file.c_str());
+    }
+}
@@ -0,0 +1,106 @@
+#include <parfait/Adt3dExtent.h>
+#include <parfait/ExtentBuilder.h>
+#include <parfait/Timing.h>
+#include <t-infinity/Shortcuts.h>
+#include <t-infinity/SubCommand.h>
+#include <t-infinity/MeshExtents.h>
+#include <Tracer.h>
+#include <algorithm>
+#include <random>
+
+namespace inf {
+class AdtProfilingCommand : public SubCommand {
+  public:
+    std::string description() const override {
+        return "Profile building and querying an ADT by incremental insertion vs bulk loading";
+    }
+
+    Parfait::CommandLineMenu menu() const override {
+        Parfait::CommandLineMenu m;
+        m.addParameter({"--mesh", "-m"}, "use the cell extents of this mesh (otherwise random boxes)", false);
+        m.addParameter({"--count", "-n"}, "number of random boxes when no mesh is given", false, "1000000");
+        return m;
+    }
+
+    void run(Parfait::CommandLineMenu m, MessagePasser mp) override {
+        Parfait::Extent<double> domain;
+        std::vector<Parfait::Extent<double>> extents;
+        if (m.has("--mesh")) {
+            auto mesh = inf::shortcut::loadMesh(mp, m.get("--mesh"));
+            domain = inf::partitionExtent(*mesh);
+            for (int c = 0; c < mesh->cellCount(); c++)
+                extents.push_back(Parfait::ExtentBuilder::buildExtentForCellInMesh(*mesh, c));
+        } else {
+            domain = {{0, 0, 0}, {1, 1, 1}};
+            extents = randomBoxes(m.getInt("--count"));
+        }
+        std::vector<int> ids(extents.size());
+        for (size_t i = 0; i < ids.size(); i++) ids[i] = int(i);
+
+        auto start_incremental = Parfait::Now();
+        Tracer::begin("ADT incremental build");
+        Parfait::Adt3DExtent incremental(domain);
+        for (size_t i = 0; i < extents.size(); i++) incremental.store(ids[i], extents[i]);
+        Tracer::end("ADT incremental build");
+        auto end_incremental = Parfait::Now();
+
+        Tracer::begin("ADT bulk build");
+        Parfait::Adt3DExtent bulk(domain, ids, extents);
+        Tracer::end("ADT bulk build");
+        auto end_bulk = Parfait::Now();
+
+        Tracer::begin("ADT incremental query");
+        auto incremental_hits = queryCentroids(incremental, extents);
+        Tracer::end("ADT incremental query");
+        auto end_incremental_query = Parfait::Now();
+
+        Tracer::begin("ADT bulk query");
+        auto bulk_hits = queryCentroids(bulk, extents);
+        Tracer::end("ADT bulk query");
+        auto end_bulk_query = Parfait::Now();
+
+        mp_rootprint("Objects:              %lu\n", extents.size());
+        mp_rootprint("Incremental depth:    %d\n", incremental.depth());
+        mp_rootprint("Bulk depth:           %d\n", bulk.depth());
+        auto report = [&](const char* name, double seconds) {
+            double max_seconds = mp.ParallelMax(seconds);
+            double avg_seconds = mp.ParallelAverage(seconds);
+            mp_rootprint("%-21s max %.3f s, avg %.3f s\n", name, max_seconds, avg_seconds);
+        };
+        report("Incremental build:", Parfait::elapsedTimeInSeconds(start_incremental, end_incremental));
+        report("Bulk build:", Parfait::elapsedTimeInSeconds(end_incremental, end_bulk));
+        report("Incremental queries:", Parfait::elapsedTimeInSeconds(end_bulk, end_incremental_query));
+        report("Bulk queries:", Parfait::elapsedTimeInSeconds(end_incremental_query, end_bulk_query));
+
+        PARFAIT_ASSERT(incremental_hits == bulk_hits,
+                       "Query hits not equal: " + std::to_string(incremental_hits) + " vs " +
+                           std::to_string(bulk_hits));
+    }
+
+  private:
+    static std::vector<Parfait::Extent<double>> randomBoxes(int n) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> position(0.0, 1.0);
+        std::uniform_real_distribution<double> size(0.0, 0.01);
+        std::vector<Parfait::Extent<double>> boxes(n);
+        for (auto& e : boxes) {
+            for (int i = 0; i < 3; i++) {
+                e.lo[i] = position(gen);
+                e.hi[i] = std::min(1.0, e.lo[i] + size(gen));
+            }
+        }
+        return boxes;
+    }
+
+    static long queryCentroids(const Parfait::Adt3DExtent& adt, const std::vector<Parfait::Extent<double>>& extents) {
+        long hits = 0;
+        for (auto& e : extents) {
+            auto center = e.center();
+            hits += adt.retrieve({center, center}).size();
+        }
+        return hits;
+    }
+};
+}
+
+CREATE_INF_SUBCOMMAND(inf::AdtProfilingCommand)
@@ -0,0 +1,82 @@
+#include <parfait/Throw.h>
+#include <parfait/Timing.h>
+#include <t-infinity/CartMesh.h>
+#include <t-infinity/MeshConnectivity.h>
+#include <t-infinity/Shortcuts.h>
+#include <t-infinity/SubCommand.h>
+#include <Tracer.h>
+
+namespace inf {
+class ConnectivityProfilingCommand : public SubCommand {
+  public:
+    std::string description() const override {
+        return "Profile building node and cell adjacency as vector-of-vectors vs compressed rows";
+    }
+
+    Parfait::CommandLineMenu menu() const override {
+        Parfait::CommandLineMenu m;
+        m.addParameter({"--mesh", "-m"}, "profile this mesh (otherwise a cartesian hex mesh)", false);
+        m.addParameter({"--cells", "-n"}, "hexes per side of the cartesian mesh", false, "80");
+        m.addParameter({"--threads", "-t"}, "threads used to build compressed cell-to-cell", false, "1");
+        return m;
+    }
+
+    void run(Parfait::CommandLineMenu m, MessagePasser mp) override {
+        std::shared_ptr<MeshInterface> mesh;
+        if (m.has("--mesh")) {
+            mesh = shortcut::loadMesh(mp, m.get("--mesh"));
+        } else {
+            int n = m.getInt("--cells");
+            mesh = CartMesh::create(mp, n, n, n);
+        }
+        int threads = m.getInt("--threads");
+        mp_rootprint("Nodes:                %d\n", mesh->nodeCount());
+        mp_rootprint("Cells:                %d\n", mesh->cellCount());
+
+        profile(mp, "node-to-node", [&] { return NodeToNode::build(*mesh); }, [&] {
+            return NodeToNode::buildCompressed(*mesh);
+        });
+        profile(mp, "node-to-cell", [&] { return NodeToCell::build(*mesh); }, [&] {
+            return NodeToCell::buildCompressed(*mesh);
+        });
+        auto n2c = NodeToCell::build(*mesh);
+        auto compressed_n2c = NodeToCell::buildCompressed(*mesh);
+        profile(mp, "cell-to-cell", [&] { return CellToCell::build(*mesh, n2c); }, [&] {
+            return CellToCell::buildCompressed(*mesh, compressed_n2c, threads);
+        });
+    }
+
+  private:
+    template <typename BuildNested, typename BuildCompressed>
+    static void profile(MessagePasser mp,
+                        const std::string& name,
+                        BuildNested build_nested,
+                        BuildCompressed build_compressed) {
+        long rss_start = long(Tracer::usedMemoryMB());
+        auto start_compressed = Parfait::Now();
+        auto compressed = build_compressed();
+        auto end_compressed = Parfait::Now();
+        long rss_compressed = long(Tracer::usedMemoryMB());
+        auto nested = build_nested();
+        auto end_nested = Parfait::Now();
+        long rss_nested = long(Tracer::usedMemoryMB());
+
+        PARFAIT_ASSERT(compressed.toVectorOfVectors() == nested, name + ": compressed rows differ");
+
+        size_t nested_bytes = nested.capacity() * sizeof(std::vector<int>);
+        for (auto& row : nested) nested_bytes += row.capacity() * sizeof(int);
+        double mb = 1024.0 * 1024.0;
+        mp_rootprint("%s (%ld entries)\n", name.c_str(), compressed.entryCount());
+        mp_rootprint("  vector-of-vectors: %s, payload %.1f MB, resident +%ld MB\n",
+                     Parfait::readableElapsedTimeAsString(end_compressed, end_nested).c_str(),
+                     nested_bytes / mb,
+                     rss_nested - rss_compressed);
+        mp_rootprint("  compressed rows:   %s, payload %.1f MB, resident +%ld MB\n",
+                     Parfait::readableElapsedTimeAsString(start_compressed, end_compressed).c_str(),
+                     compressed.memoryInBytes() / mb,
+                     rss_compressed - rss_start);
+    }
+};
+}
+
+CREATE_INF_SUBCOMMAND(inf::ConnectivityProfilingCommand)
@@ -43,6 +43,7 @@ class MetricCommand : public inf::SubCommand {
         m.addParameter(Alias::snap(), "input scalar fields as snap files", false);
         m.addParameter(Alias::outputFileBase(), "output filename", false, "metric.snap");
         m.addParameter(Alias::mesh(), Help::mesh(), true);
+        m.addParameter({"threads"}, "threads used to compute Hessians of scalar fields", false, "1");
         return m;
     }
 
@@ -90,7 +91,8 @@ class MetricCommand : public inf::SubCommand {
             }
         }
         if (m.has("snap")) {
-            auto fields = inf::importFields(mp, mesh, m);
+            auto fields = MetricManipulator::scalarsToRefineHessians(
+                mp, mesh, inf::importFields(mp, mesh, m), m.getInt("threads"));
             auto metric_calculator = inf::getMetricCalculator(getPluginDir(), "RefinePlugins");
             Parfait::Dictionary settings;
             settings["complexity"] = target_complexity;
@@ -98,9 +100,9 @@ class MetricCommand : public inf::SubCommand {
             settings["gradation"] = m.getDouble("gradation");
             settings["shock filtering"] = m.has("shock-filtering");
             for (auto& field : fields) {
-                // Note: field could be a scalar (1 element)
-                // or could be a hessian (9 elements)
-                // or could be a metric (6 elements).
+                // Note: scalar node fields were already
+                // replaced by their hessian (9 elements),
+                // others could be a metric (6 elements).
                 // RefinePlugins::metric_calculator will
                 // switch what it does to calculate the metric
                 // based on what you send it.
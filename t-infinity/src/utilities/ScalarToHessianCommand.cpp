@@ -7,7 +7,7 @@
 #include <t-infinity/MetricCalculatorInterface.h>
 #include <t-infinity/MeshLoader.h>
 #include <t-infinity/Snap.h>
-#include <t-infinity/Gradients.h>
+#include <t-infinity/MetricManipulator.h>
 #include <parfait/Dictionary.h>
 
 using namespace inf;
@@ -27,13 +27,14 @@ class ScalarToHessianCommand : public SubCommand {
         m.addParameter({"complexity", "c"}, "Target complexity", false, "1000");
         m.addParameter(Alias::plugindir(), Help::plugindir(), false, getPluginDir());
         m.addParameter(Alias::outputFileBase(), Help::outputFileBase(), false, "hessian");
+        m.addParameter({"threads"}, "threads used to compute the Hessians", false, "1");
         return m;
     }
 
     void run(Parfait::CommandLineMenu m, MessagePasser mp) override {
         auto mesh = importMesh(m, mp);
-        auto fields = importFields(mp, mesh, m);
-        auto grad_calculator = NodeToNodeGradientCalculator(mp, mesh);
+        auto fields = MetricManipulator::scalarsToRefineHessians(
+            mp, mesh, importFields(mp, mesh, m), m.getInt("threads"));
         auto snap = Snap(mp.getCommunicator());
         snap.addMeshTopologies(*mesh);
         auto metric_calculator = getMetricCalculator(inf::getPluginDir(), "RefinePlugins");
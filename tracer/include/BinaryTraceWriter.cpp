@@ -0,0 +1,166 @@
+#include "BinaryTraceWriter.h"
+#include <chrono>
+
+namespace TracerBinary {
+
+namespace {
+    std::atomic<uint64_t> next_writer_id{1};
+
+    struct ThreadState {
+        uint64_t writer_id = 0;
+        std::shared_ptr<Ring> ring;
+        std::unordered_map<std::string, uint32_t> name_ids;
+    };
+    thread_local ThreadState this_thread;
+
+    uint64_t threadId() {
+        auto tid = std::this_thread::get_id();
+        uint64_t* p = (uint64_t*)&tid;
+        return *p;
+    }
+
+    template <typename T>
+    void writeBytes(std::ofstream& f, const T& t) {
+        f.write(reinterpret_cast<const char*>(&t), sizeof(T));
+    }
+}
+
+size_t Ring::tryPush(const Record& r) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    size_t held = t - head.load(std::memory_order_acquire);
+    if (held == capacity) return 0;
+    slots[t % capacity] = r;
+    tail.store(t + 1, std::memory_order_release);
+    return held + 1;
+}
+
+void Ring::drainInto(std::vector<Record>& out) {
+    size_t h = head.load(std::memory_order_relaxed);
+    size_t t = tail.load(std::memory_order_acquire);
+    for (; h != t; h++) out.push_back(slots[h % capacity]);
+    head.store(h, std::memory_order_release);
+}
+
+Writer::Writer(const std::string& filename, int process_id)
+    : writer_id(next_writer_id++), file(filename, std::ios::binary) {
+    file.write("TRACEBIN", 8);
+    int32_t pid = process_id;
+    int32_t record_size = sizeof(Record);
+    writeBytes(file, pid);
+    writeBytes(file, record_size);
+    flusher = std::thread([this]() { flushLoop(); });
+}
+
+Writer::~Writer() {
+    {
+        std::lock_guard<std::mutex> guard(wake_lock);
+        stopping = true;
+    }
+    wake.notify_one();
+    flusher.join();
+    drainAll();
+    file.close();
+}
+
+void Writer::record(const std::string& name, const std::string& category, char phase, uint64_t timestamp) {
+    Record r{};
+    r.thread_id = threadId();
+    r.timestamp = timestamp;
+    r.name_id = intern(name);
+    r.category_id = intern(category);
+    r.phase = phase;
+    auto& ring = ringForThisThread();
+    size_t held;
+    while (0 == (held = ring.tryPush(r))) {
+        wake.notify_one();
+        std::this_thread::yield();
+    }
+    if (held == Ring::capacity / 2) wake.notify_one();
+}
+
+void Writer::writeJson(const std::string& event) {
+    std::lock_guard<std::mutex> guard(file_lock);
+    uint32_t length = event.size();
+    file.put('J');
+    writeBytes(file, length);
+    file.write(event.data(), length);
+}
+
+void Writer::flush() {
+    drainAll();
+    std::lock_guard<std::mutex> guard(file_lock);
+    file.flush();
+}
+
+uint32_t Writer::intern(const std::string& name) {
+    auto& cache = this_thread.name_ids;
+    if (this_thread.writer_id == writer_id) {
+        auto it = cache.find(name);
+        if (it != cache.end()) return it->second;
+    }
+    std::lock_guard<std::mutex> guard(names_lock);
+    auto it = name_ids.find(name);
+    uint32_t id;
+    if (it != name_ids.end()) {
+        id = it->second;
+    } else {
+        id = names.size();
+        name_ids[name] = id;
+        names.push_back(name);
+    }
+    ringForThisThread();
+    cache[name] = id;
+    return id;
+}
+
+Ring& Writer::ringForThisThread() {
+    if (this_thread.writer_id != writer_id) {
+        this_thread.writer_id = writer_id;
+        this_thread.name_ids.clear();
+        this_thread.ring = std::make_shared<Ring>();
+        std::lock_guard<std::mutex> guard(rings_lock);
+        rings.push_back(this_thread.ring);
+    }
+    return *this_thread.ring;
+}
+
+void Writer::drainAll() {
+    std::lock_guard<std::mutex> guard(file_lock);
+    std::vector<std::shared_ptr<Ring>> rings_to_drain;
+    {
+        std::lock_guard<std::mutex> rings_guard(rings_lock);
+        rings_to_drain = rings;
+    }
+    pending.clear();
+    for (auto& ring : rings_to_drain) ring->drainInto(pending);
+
+    // Every drained record's names were interned before it was pushed.
+    {
+        std::lock_guard<std::mutex> names_guard(names_lock);
+        for (; names_written < names.size(); names_written++) {
+            auto& name = names[names_written];
+            uint32_t id = names_written;
+            uint32_t length = name.size();
+            file.put('N');
+            writeBytes(file, id);
+            writeBytes(file, length);
+            file.write(name.data(), length);
+        }
+    }
+    if (pending.empty()) return;
+    uint32_t count = pending.size();
+    file.put('R');
+    writeBytes(file, count);
+    file.write(reinterpret_cast<const char*>(pending.data()), count * sizeof(Record));
+}
+
+void Writer::flushLoop() {
+    std::unique_lock<std::mutex> guard(wake_lock);
+    while (not stopping) {
+        wake.wait_for(guard, std::chrono::milliseconds(20));
+        guard.unlock();
+        drainAll();
+        guard.lock();
+    }
+}
+}
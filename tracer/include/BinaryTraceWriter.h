@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Binary trace files, converted to Chrome-trace JSON by utils/TracerUtils:
+//   "TRACEBIN", int32 process id, int32 record size
+//   followed by chunks, each starting with a one byte kind:
+//     'N'  uint32 id, uint32 length, name characters
+//     'R'  uint32 count, count Records
+//     'J'  uint32 length, one Chrome-trace JSON event
+// Names and categories share one table of ids.
+namespace TracerBinary {
+
+struct Record {
+    uint64_t thread_id;
+    uint64_t timestamp;
+    uint32_t name_id;
+    uint32_t category_id;
+    char phase;
+    char padding[7];
+};
+
+// Single producer, single consumer.  Only the owning thread pushes and only
+// the writer drains.
+class Ring {
+  public:
+    static constexpr size_t capacity = 1 << 15;
+
+    // Returns the number of records held after the push, or 0 if full.
+    size_t tryPush(const Record& r);
+    void drainInto(std::vector<Record>& out);
+
+  private:
+    Record slots[capacity];
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+};
+
+// Each thread appends to its own Ring.  A background thread moves records
+// to the file, so recording an event never takes a lock once its name has
+// been seen by that thread.  Threads keep the ring of the writer they last
+// used, so only one writer should be recording at a time.
+class Writer {
+  public:
+    Writer(const std::string& filename, int process_id);
+    ~Writer();
+
+    void record(const std::string& name, const std::string& category, char phase, uint64_t timestamp);
+    void writeJson(const std::string& event);
+    void flush();
+
+  private:
+    uint64_t writer_id;
+    std::ofstream file;
+    std::mutex file_lock;
+
+    std::mutex names_lock;
+    std::unordered_map<std::string, uint32_t> name_ids;
+    std::vector<std::string> names;
+    size_t names_written = 0;
+
+    std::mutex rings_lock;
+    std::vector<std::shared_ptr<Ring>> rings;
+    std::vector<Record> pending;
+
+    std::mutex wake_lock;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread flusher;
+
+    uint32_t intern(const std::string& name);
+    Ring& ringForThisThread();
+    void drainAll();
+    void flushLoop();
+};
+}
@@ -1,5 +1,6 @@
 #include "Tracer.h"
 #include "TracerImpl.h"
+#include "BinaryTraceWriter.h"
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
@@ -256,10 +257,16 @@ bool Tracer::isEnabled() {
     return global_tracer_handle->isEnabled();
 }
 
-TracerImpl::TracerImpl() : file_name("trace.trace") { initialize(); }
+TracerImpl::Format TracerImpl::formatFromEnvironment() {
+    const char* format = getenv("TRACER_FORMAT");
+    if (format != nullptr and std::string(format) == "binary") return Binary;
+    return Json;
+}
+
+TracerImpl::TracerImpl() : file_name("trace.trace"), format(formatFromEnvironment()) { initialize(); }
 
-TracerImpl::TracerImpl(std::string file_name, int processId, bool enabled)
-    : file_name(file_name), process_id(processId), is_enabled(enabled) {
+TracerImpl::TracerImpl(std::string file_name, int processId, bool enabled, Format format)
+    : file_name(file_name), process_id(processId), is_enabled(enabled), format(format) {
     if (not is_enabled) return;
     initialize();
 }
@@ -271,6 +278,10 @@ uint64_t TracerImpl::timestamp() {
 }
 TracerImpl::~TracerImpl() {
     if (not is_enabled) return;
+    if (binary_writer) {
+        binary_writer.reset();
+        return;
+    }
     lock.lock();
     if (not skip_closing_brace) printFileFooter();
     file.close();
@@ -285,6 +296,10 @@ void TracerImpl::setDebug() {
     flush_always = true;
 }
 void TracerImpl::log(Event&& e) {
+    if (binary_writer and e.args.empty() and e.phase.size() == 1) {
+        binary_writer->record(e.name, e.category, e.phase[0], timestamp());
+        return;
+    }
     addThreadId(e);
     addTimeStamp(e);
     writeEvent(e);
@@ -313,14 +328,22 @@ void TracerImpl::writeEvent(const Event& e) {
         }
         item.addPair("args", args);
     }
+    writeItem(item.getString());
+}
+void TracerImpl::writeItem(const std::string& item) {
+    if (binary_writer) return binary_writer->writeJson(item);
     std::string output = "";
-    auto s = item.getString();
     std::lock_guard<std::mutex> guard(lock);
     beginItem(output);
-    file << output + s;
+    file << output + item;
     if (flush_always) file.flush();
 }
-void TracerImpl::flush() { file.flush(); }
+void TracerImpl::flush() {
+    if (binary_writer)
+        binary_writer->flush();
+    else
+        file.flush();
+}
 void TracerImpl::skipClosingBrace() { skip_closing_brace = true; }
 void TracerImpl::addThreadId(Event& e) const {
     if (e.thread_id == -1) {
@@ -333,17 +356,18 @@ void TracerImpl::addTimeStamp(Event& e) { e.timestamp = timestamp(); }
 void TracerImpl::printFileHeader() { file << "["; }
 void TracerImpl::printFileFooter() { file << std::endl << "]"; }
 void TracerImpl::initialize() {
+    clock_start = std::chrono::high_resolution_clock::now().time_since_epoch();
+    if (format == Binary) {
+        binary_writer = std::make_unique<TracerBinary::Writer>(file_name, process_id);
+        return;
+    }
     lock.lock();
     file.open(file_name);
     printFileHeader();
     lock.unlock();
-    clock_start = std::chrono::high_resolution_clock::now().time_since_epoch();
 }
 
 void TracerImpl::setThreadName(const std::string& name, int processId, int threadId) {
-    std::lock_guard<std::mutex> guard(lock);
-    std::string output = "";
-    beginItem(output);
     auto tid = std::this_thread::get_id();
     uint64_t* p = (uint64_t*)&tid;
     threadId = *p;
@@ -356,13 +380,10 @@ void TracerImpl::setThreadName(const std::string& name, int processId, int threa
     JsonItem threadNamePair;
     threadNamePair.addPair("name", name);
     item.addPair("args", threadNamePair);
-    file << (output + item.getString());
+    writeItem(item.getString());
 }
 
 void TracerImpl::beginFlowEvent(int eventId, int processId, int threadId, const std::string& timestamp) {
-    std::lock_guard<std::mutex> guard(lock);
-    std::string output = "";
-    beginItem(output);
     Event e;
     addThreadId(e);
     addTimeStamp(e);
@@ -375,13 +396,10 @@ void TracerImpl::beginFlowEvent(int eventId, int processId, int threadId, const
     item.addPair("ts", e.timestamp);
     item.addPair("id", eventId);
     item.addPair("ph", "s");
-    file << (output + item.getString());
+    writeItem(item.getString());
 }
 
 void TracerImpl::endFlowEvent(int eventId, int processId) {
-    std::lock_guard<std::mutex> guard(lock);
-    std::string output = "";
-    beginItem(output);
     Event e;
     addThreadId(e);
     addTimeStamp(e);
@@ -394,9 +412,10 @@ void TracerImpl::endFlowEvent(int eventId, int processId) {
     item.addPair("id", eventId);
     item.addPair("ph", "f");
     item.addPair("bp", "e");
-    file << item.getString();
+    writeItem(item.getString());
 }
 void TracerImpl::begin(std::string name, std::string category) {
+    if (binary_writer) return binary_writer->record(name, category, 'B', timestamp());
     Event e;
     e.process_id = process_id;
     e.name = std::move(name);
@@ -405,6 +424,7 @@ void TracerImpl::begin(std::string name, std::string category) {
     log(std::move(e));
 }
 void TracerImpl::end(std::string name, std::string category) {
+    if (binary_writer) return binary_writer->record(name, category, 'E', timestamp());
     Event e;
     e.process_id = process_id;
     e.name = std::move(name);
@@ -3,6 +3,11 @@
 #include <mutex>
 #include <map>
 #include <fstream>
+#include <memory>
+
+namespace TracerBinary {
+class Writer;
+}
 
 class Event {
   public:
@@ -19,7 +24,14 @@ class Event {
 
 class TracerImpl {
   public:
-    TracerImpl(std::string file_name, int processId, bool enabled = true);
+    // Json writes Chrome-trace events as they happen.  Binary records begin,
+    // end, and log events into per-thread buffers that are written in the
+    // background; utils/merge.py converts them to Chrome-trace JSON.
+    // The default is Binary when TRACER_FORMAT=binary is set in the environment.
+    enum Format { Json, Binary };
+    static Format formatFromEnvironment();
+
+    TracerImpl(std::string file_name, int processId, bool enabled = true, Format format = formatFromEnvironment());
     TracerImpl();
     ~TracerImpl();
     void log(Event&& e);
@@ -45,6 +57,8 @@ class TracerImpl {
     std::ofstream file;
     std::chrono::high_resolution_clock::duration clock_start;
     bool is_enabled = true;
+    Format format = Json;
+    std::unique_ptr<TracerBinary::Writer> binary_writer;
 
     uint64_t timestamp();
     void printFileHeader();
@@ -52,6 +66,7 @@ class TracerImpl {
     void addThreadId(Event& e) const;
     void addTimeStamp(Event& event);
     void writeEvent(const Event& e);
+    void writeItem(const std::string& item);
     void beginItem(std::string& output);
     void initialize();
 
@@ -92,3 +92,48 @@ TEST_CASE("Tracer global functions don't work if tracer isn't initialized") {
 
     REQUIRE_FALSE(doesFileExist("trace.trace"));
 }
+
+TEST_CASE("Binary tracer records every event from every thread") {
+    auto filename = randomLetters(7) + ".trace";
+    auto tracer = std::make_shared<TracerImpl>(filename, 3, true, TracerImpl::Binary);
+    int events_per_thread = 20000;
+    auto work = [&]() {
+        for (int i = 0; i < events_per_thread; i++) {
+            tracer->begin("binary-event", "my-category");
+            tracer->end("binary-event", "my-category");
+        }
+    };
+    std::thread other_thread(work);
+    work();
+    other_thread.join();
+    tracer->log(Event());
+    tracer.reset();
+
+    auto contents = loadFileToString(filename);
+    REQUIRE_THAT(contents, StartsWith("TRACEBIN"));
+    REQUIRE_THAT(contents, Contains("binary-event"));
+    REQUIRE_THAT(contents, Contains("my-category"));
+
+    int32_t record_size;
+    memcpy(&record_size, &contents[12], 4);
+    long records = 0;
+    size_t offset = 16;
+    while (offset < contents.size()) {
+        char kind = contents[offset++];
+        uint32_t n;
+        memcpy(&n, &contents[offset], 4);
+        offset += 4;
+        if (kind == 'N') {
+            memcpy(&n, &contents[offset], 4);
+            offset += 4 + n;
+        } else if (kind == 'R') {
+            records += n;
+            offset += n * record_size;
+        } else {
+            offset += n;
+        }
+    }
+    REQUIRE(offset == contents.size());
+    REQUIRE(records == 4 * events_per_thread + 1);
+    REQUIRE(0 == remove(filename.c_str()));
+}
@@ -0,0 +1,55 @@
+import json
+import struct
+
+MAGIC = b"TRACEBIN"
+RECORD = struct.Struct("<QQIIc7x")
+
+
+def isBinaryTrace(filename):
+    with open(filename, "rb") as f:
+        return f.read(len(MAGIC)) == MAGIC
+
+
+def loadBinaryTrace(filename):
+    """Converts a binary trace to the same list of events a JSON trace holds."""
+    with open(filename, "rb") as f:
+        data = f.read()
+    process_id, record_size = struct.unpack_from("<ii", data, len(MAGIC))
+    if record_size != RECORD.size:
+        raise ValueError("%s: unexpected record size %d" % (filename, record_size))
+    names = {}
+    events = []
+    offset = len(MAGIC) + 8
+    while offset < len(data):
+        kind = data[offset:offset + 1]
+        offset += 1
+        if kind == b"N":
+            name_id, length = struct.unpack_from("<II", data, offset)
+            offset += 8
+            names[name_id] = data[offset:offset + length].decode("utf-8")
+            offset += length
+        elif kind == b"R":
+            count, = struct.unpack_from("<I", data, offset)
+            offset += 4
+            for i in range(count):
+                tid, ts, name_id, category_id, phase = RECORD.unpack_from(data, offset)
+                offset += RECORD.size
+                events.append({"cat": names[category_id], "pid": process_id, "tid": tid, "ts": ts,
+                               "ph": phase.decode("utf-8"), "name": names[name_id]})
+        elif kind == b"J":
+            length, = struct.unpack_from("<I", data, offset)
+            offset += 4
+            events.append(json.loads(data[offset:offset + length].decode("utf-8")))
+            offset += length
+        else:
+            raise ValueError("%s: corrupt binary trace at byte %d" % (filename, offset - 1))
+    # Each thread's events are in order, but threads are written in batches.
+    events.sort(key=lambda e: int(e.get("ts", 0)))
+    return events
+
+
+def loadTrace(filename):
+    if isBinaryTrace(filename):
+        return loadBinaryTrace(filename)
+    with open(filename) as f:
+        return json.load(f)
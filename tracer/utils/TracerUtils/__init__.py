@@ -1,2 +1,3 @@
 from .Event import Event
 from .Helpers import *
+from .BinaryTrace import isBinaryTrace, loadBinaryTrace, loadTrace
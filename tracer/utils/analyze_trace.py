@@ -62,8 +62,7 @@ def selectThread(selected_process):
 if __name__ == "__main__":
     event_list = []
     for i in range(1, len(sys.argv)):
-        with open(sys.argv[i]) as f:
-            event_list += extractEventList(json.load(f))
+        event_list += extractEventList(loadTrace(sys.argv[i]))
     process_ids = getProcessIds(event_list)
     selected_process = process_ids[0]
     if len(process_ids) > 1:
@@ -1,6 +1,10 @@
 import unittest
 import json
+import os
+import struct
+import tempfile
 from TracerUtils import convertFromMicroseconds, Event, extractEventList, getProcessIds, getThreadIds, generateTraceString, generateTotalsString
+from TracerUtils import isBinaryTrace, loadTrace
 
 
 class TraceTestCase(unittest.TestCase):
@@ -51,6 +55,37 @@ class TraceTestCase(unittest.TestCase):
     assert 1 == totals_string.count('\n')
 
 
+class BinaryTraceTestCase(unittest.TestCase):
+  def setUp(self):
+    def name(name_id, s):
+      return b"N" + struct.pack("<II", name_id, len(s)) + s.encode()
+
+    def record(tid, ts, name_id, category_id, phase):
+      return struct.pack("<QQIIc7x", tid, ts, name_id, category_id, phase.encode())
+
+    data = b"TRACEBIN" + struct.pack("<ii", 7, 32)
+    data += name(0, "First event") + name(1, "xx")
+    data += b"R" + struct.pack("<I", 2) + record(576, 172045, 0, 1, "B") + record(576, 552045, 0, 1, "E")
+    counter = '{"cat": "category", "pid": 7, "tid": 576, "ts": 83, "ph": "C", "name": "Memory (MB)", "args": {"Memory (MB)": 97}}'
+    data += b"J" + struct.pack("<I", len(counter)) + counter.encode()
+
+    handle, self.filename = tempfile.mkstemp()
+    with os.fdopen(handle, "wb") as f:
+      f.write(data)
+
+  def tearDown(self):
+    os.remove(self.filename)
+
+  def testConvertsToChromeTraceEvents(self):
+    assert isBinaryTrace(self.filename)
+    events = loadTrace(self.filename)
+    assert 3 == len(events)
+    assert "C" == events[0]["ph"]
+    assert {"cat": "xx", "pid": 7, "tid": 576, "ts": 172045, "ph": "B", "name": "First event"} == events[1]
+    event_list = extractEventList(events)
+    totals_string = generateTotalsString(event_list, 0, 7, 576)
+    assert 1 == totals_string.count('\n')
+
 
 if __name__ == "__main__":
   unittest.main()
@@ -3,6 +3,7 @@
 import json
 import sys
 from pprint import pprint
+from TracerUtils import isBinaryTrace, loadBinaryTrace
 
 
 def fix_trace_file(name):
@@ -16,8 +17,8 @@ def fix_trace_file(name):
         f.write(s)
 
 
-if len(sys.argv) < 3:
-    print("usage: %s <trace files to merge>" % sys.argv[0])
+if len(sys.argv) < 2:
+    print("usage: %s <trace files to merge or convert>" % sys.argv[0])
     exit(1)
 
 outfile_name = "combined.trace"
@@ -26,12 +27,15 @@ data = []
 for filename in sys.argv[1:]:
     if filename == outfile_name:
         continue
-    fix_trace_file(filename)
-    with open(filename) as json_data:
-        d = json.load(json_data)
-        for event in d:
-            event["tid"] = filename + '.' + str(event["tid"])
-        data = data + d
+    if isBinaryTrace(filename):
+        d = loadBinaryTrace(filename)
+    else:
+        fix_trace_file(filename)
+        with open(filename) as json_data:
+            d = json.load(json_data)
+    for event in d:
+        event["tid"] = filename + '.' + str(event["tid"])
+    data = data + d
 
 with open(outfile_name, 'w') as outfile:
         json.dump(data, outfile, sort_keys=True, indent=4)
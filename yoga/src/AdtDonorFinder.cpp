@@ -28,43 +28,24 @@ AdtDonorFinder::AdtDonorFinder(WorkVoxel& vox)
 }
 
 void AdtDonorFinder::fillAdt(Parfait::Adt3DExtent& adt, int component) {
-    for (size_t i = 0; i < workVoxel.tets.size(); ++i) {
-        if (component == getCellComponent(i)) {
-            auto cellExtent = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
-            auto tet = workVoxel.tets[i];
-            for (auto nodeId : tet.nodeIds)
-                Parfait::ExtentBuilder::add(cellExtent, workVoxel.nodes[nodeId].xyz);
-            adt.store(i, cellExtent);
-        }
-    }
-    for (size_t i = 0; i < workVoxel.pyramids.size(); ++i) {
-        if (component == getCellComponent(i + workVoxel.tets.size())) {
-            auto cellExtent = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
-            auto pyramid = workVoxel.pyramids[i];
-            for (auto nodeId : pyramid.nodeIds)
-                Parfait::ExtentBuilder::add(cellExtent, workVoxel.nodes[nodeId].xyz);
-            adt.store(i + workVoxel.tets.size(), cellExtent);
-        }
-    }
-    for (size_t i = 0; i < workVoxel.prisms.size(); ++i) {
-        if (component == getCellComponent(i + workVoxel.tets.size() + workVoxel.pyramids.size())) {
-            auto cellExtent = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
-            auto prism = workVoxel.prisms[i];
-            for (auto nodeId : prism.nodeIds)
-                Parfait::ExtentBuilder::add(cellExtent, workVoxel.nodes[nodeId].xyz);
-            adt.store(i + workVoxel.tets.size() + workVoxel.pyramids.size(), cellExtent);
-        }
-    }
-    for (size_t i = 0; i < workVoxel.hexs.size(); ++i) {
-        if (component ==
-            getCellComponent(i + workVoxel.tets.size() + workVoxel.pyramids.size() + workVoxel.prisms.size())) {
-            auto cellExtent = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
-            auto hex = workVoxel.hexs[i];
-            for (auto nodeId : hex.nodeIds)
-                Parfait::ExtentBuilder::add(cellExtent, workVoxel.nodes[nodeId].xyz);
-            adt.store(i + workVoxel.tets.size() + workVoxel.pyramids.size() + workVoxel.prisms.size(), cellExtent);
-        }
-    }
+    std::vector<int> cell_ids;
+    std::vector<Parfait::Extent<double>> cell_extents;
+    auto add_cell = [&](int cell_id, const int* node_ids, int n) {
+        if (component != getCellComponent(cell_id)) return;
+        auto cellExtent = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
+        for (int i = 0; i < n; i++) Parfait::ExtentBuilder::add(cellExtent, workVoxel.nodes[node_ids[i]].xyz);
+        cell_ids.push_back(cell_id);
+        cell_extents.push_back(cellExtent);
+    };
+    int offset = 0;
+    for (size_t i = 0; i < workVoxel.tets.size(); ++i) add_cell(offset + i, workVoxel.tets[i].nodeIds.data(), 4);
+    offset += workVoxel.tets.size();
+    for (size_t i = 0; i < workVoxel.pyramids.size(); ++i) add_cell(offset + i, workVoxel.pyramids[i].nodeIds.data(), 5);
+    offset += workVoxel.pyramids.size();
+    for (size_t i = 0; i < workVoxel.prisms.size(); ++i) add_cell(offset + i, workVoxel.prisms[i].nodeIds.data(), 6);
+    offset += workVoxel.prisms.size();
+    for (size_t i = 0; i < workVoxel.hexs.size(); ++i) add_cell(offset + i, workVoxel.hexs[i].nodeIds.data(), 8);
+    adt.bulkLoad(cell_ids, cell_extents);
 }
 
 std::vector<int> AdtDonorFinder::getComponentIdsForVoxel(const WorkVoxel& w) {
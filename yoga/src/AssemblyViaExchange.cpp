@@ -2,13 +2,18 @@
 #include <parfait/ExtentWriter.h>
 #include <parfait/RecursiveBisection.h>
 #include <parfait/Timing.h>
+#include <algorithm>
 #include <memory>
 #include "AlternateMapBuilder.h"
+#include "BodyFrameSearchStructures.h"
 #include "CartesianLoadBalancer.h"
+#include "CompactPacking.h"
 #include "YogaConfiguration.h"
 #include "Connectivity.h"
 #include "DistanceFieldAdapter.h"
+#include "DistributedWallDistance.h"
 #include "DistributedLoadBalancer.h"
+#include "DonorSearchThreads.h"
 #include "DruyorTypeAssignment.h"
 #include "ExchangeBasedAssembly.h"
 #include "GhostSyncPatternBuilder.h"
@@ -25,13 +30,13 @@
 #include "OversetData.h"
 #include "ParallelSurface.h"
 #include "PartitionInfo.h"
+#include "QueryPointPipeline.h"
 #include "RootPrinter.h"
 #include "WorkVoxelBuilder.h"
 #include "AssemblyViaExchange.h"
 #include "InspectorPrinter.h"
 #include "OverlapDetector.h"
 #include "FragmentBalancer.h"
-#include "ChunkedPointGatherer.h"
 #include <parfait/LinearPartitioner.h>
 
 namespace YOGA{
@@ -42,9 +47,10 @@ std::vector<NodeStatus> generateNodeStatuses(MessagePasser mp,
                                              const MeshSystemInfo& mesh_system_info,
                                              const YogaMesh& mesh,
                                              std::vector<Receptor>& receptors,
-                                             const std::map<long,int>& g2l,
+                                             const IdMap& g2l,
                                              int extra_layers,
-                                             bool should_add_max_receptors);
+                                             bool should_add_max_receptors,
+                                             const BodyFrameSearchStructures* body_frames);
 
 std::vector<NodeStatus> extractPlainStatuses(const std::vector<StatusKeeper>& status_keepers){
     std::vector<NodeStatus> plain_statuses(status_keepers.size());
@@ -53,9 +59,9 @@ std::vector<NodeStatus> extractPlainStatuses(const std::vector<StatusKeeper>& st
     return plain_statuses;
 }
 
-void addNodeNeighborsToReceptors(std::vector<Receptor>& receptors,const YogaMesh& mesh, const std::map<long,int>& g2l){
+void addNodeNeighborsToReceptors(std::vector<Receptor>& receptors,const YogaMesh& mesh, const IdMap& g2l){
     Tracer::begin("n2n");
-    auto n2n = Connectivity::nodeToNode(mesh);
+    auto n2n = Connectivity::nodeToNodeCompressed(mesh);
     Tracer::traceMemory();
     for(auto& r:receptors) {
         int local_id = g2l.at(r.globalId);
@@ -68,15 +74,17 @@ void addNodeNeighborsToReceptors(std::vector<Receptor>& receptors,const YogaMesh
 std::map<int,std::vector<std::pair<int,int>>> mapNodeIdsToRanks(int rank,
                                                                 const std::map<int,VoxelFragment>& fragments,
                                                                 const OverlapDetector& overlap_detector,
-                                                                const std::map<int,std::vector<bool>>& affinities);
+                                                                const std::map<int,std::vector<bool>>& affinities,
+                                                                const DonorSearchHistory& history);
 
 void addWallDistanceToTransferNodes(MessagePasser mp,
                                     const YogaMesh& mesh,
                                     FragmentMap& frags_from_ranks);
 
-void addWallDistanceToTransferNodesWithChunkedSurfaces(MessagePasser mp,
-                                                       const YogaMesh& mesh,
-                                                       FragmentMap& frags_from_ranks);
+void addFacetWallDistanceToTransferNodes(MessagePasser mp,
+                                         const YogaMesh& mesh,
+                                         FragmentMap& frags_from_ranks,
+                                         const BodyFrameSearchStructures* body_frames);
 
 std::vector<std::vector<TransferNode>> buildAndExchangeQueryPoints(
     const MessagePasser& mp,
@@ -92,9 +100,10 @@ std::map<int, ReceptorCollection> buildReceptorCollectionsForRanks(
 std::map<int, std::vector<std::pair<int, int>>> buildNodeKeysForRanks(const MessagePasser& mp,
                                                                       const FragmentMap& frags_from_ranks,
                                                                       const AffinityMap& affinities,
-                                                                      const FragmentDonorFinder& donor_finder);
+                                                                      const FragmentDonorFinder& donor_finder,
+                                                                      const DonorSearchHistory& history);
 std::vector<Receptor> exchangeAndUnpackDonors(const MessagePasser& mp,
-                                            std::map<long, int>& g2l,
+                                            IdMap& g2l,
                                             const std::map<int, ReceptorCollection>& receptor_collections_for_ranks);
 
 
@@ -103,18 +112,112 @@ std::vector<Receptor> performDonorSearchViaSingleExchange(MessagePasser mp,
                                                           const std::map<int,VoxelFragment>& frags_from_ranks,
                                                           std::map<int, std::vector<std::pair<int, int>>>&  node_keys_for_ranks,
                                                           FragmentDonorFinder& donor_finder,
-                                                          std::map<long,int>& g2l);
-
-std::vector<Receptor> performDonorSearchInChunksToReducePeakMemory(MessagePasser mp,
-                                                                   Parfait::Inspector& inspector,
-                                                                   const std::map<int,VoxelFragment>& frags_from_ranks,
-                                                                   std::map<int, std::vector<std::pair<int, int>>>&  node_keys_for_ranks,
-                                                                   FragmentDonorFinder& donor_finder,
-                                                                   std::map<long,int>& g2l
-                                                                   );
+                                                          IdMap& g2l);
+
+std::vector<Receptor> performPipelinedDonorSearch(MessagePasser mp,
+                                                 Parfait::Inspector& inspector,
+                                                 const std::map<int,VoxelFragment>& frags_from_ranks,
+                                                 std::map<int, std::vector<std::pair<int, int>>>&  node_keys_for_ranks,
+                                                 FragmentDonorFinder& donor_finder,
+                                                 IdMap& g2l);
+
+// Merges the receptors found for the same node on several ranks, and returns
+// them in local id order.
+class ReceptorMerger {
+  public:
+    explicit ReceptorMerger(const IdMap& g2l) : g2l(g2l) {}
+    void add(ReceptorCollection& collection);
+    std::vector<Receptor> extractInLocalOrder();
+
+  private:
+    const IdMap& g2l;
+    IdMap index_of_gid;
+    std::vector<Receptor> receptors;
+};
 
 void modifyDistanceBasedOnComponentImportance(FragmentMap& map,const std::vector<int>& component_grid_importance);
 
+std::shared_ptr<OversetData> assemblyViaExchange(MessagePasser mp,
+                                                 YogaMesh& view,
+                                                 int load_balancer_algorithm,
+                                                 int target_voxel_size,
+                                                 int extra_layers,
+                                                 int rcb_agglom_ncells,
+                                                 bool should_add_max_receptors,
+                                                 const std::vector<int>& component_grid_importance) {
+    DonorSearchHistory no_history(false);
+    return assemblyViaExchange(mp,
+                               view,
+                               load_balancer_algorithm,
+                               target_voxel_size,
+                               extra_layers,
+                               rcb_agglom_ncells,
+                               should_add_max_receptors,
+                               component_grid_importance,
+                               no_history);
+}
+
+std::vector<Receptor> mergeWithReusedReceptors(std::vector<Receptor>&& searched,
+                                               std::vector<Receptor>&& reused,
+                                               const IdMap& g2l){
+    if(reused.empty()) return std::move(searched);
+    searched.insert(searched.end(),reused.begin(),reused.end());
+    std::sort(searched.begin(),searched.end(),[&](const Receptor& a,const Receptor& b){
+        return g2l.at(a.globalId) < g2l.at(b.globalId);
+    });
+    return std::move(searched);
+}
+
+std::vector<Receptor> searchForDonors(MessagePasser mp,
+                                      YogaMesh& view,
+                                      const PartitionInfo& partition_info,
+                                      const MeshSystemInfo& mesh_system_info,
+                                      IdMap& g2l,
+                                      int rcb_agglom_ncells,
+                                      const std::vector<int>& component_grid_importance,
+                                      const DonorSearchHistory& history,
+                                      DonorWarmStart* warm_start,
+                                      Parfait::Inspector& inspector){
+    auto fragments_and_affinities = createAndBalanceFragments(mp,
+                                                              view,
+                                                              partition_info,
+                                                              mesh_system_info,
+                                                              g2l,
+                                                              rcb_agglom_ncells,
+                                                              inspector);
+    auto& frags_from_ranks = fragments_and_affinities.first;
+    auto& affinities = fragments_and_affinities.second;
+
+    FragmentDonorFinder donor_finder(frags_from_ranks,warm_start);
+    YogaConfiguration config(mp);
+    donor_finder.setThreadCount(config.donorSearchThreadCount());
+    donor_finder.setMortonOrdering(config.shouldMortonOrderDonorSearch());
+    Tracer::traceMemory();
+
+    //addWallDistanceToTransferNodes(mp, view, frags_from_ranks);
+    addFacetWallDistanceToTransferNodes(mp,view,frags_from_ranks,history.bodyFrames());
+    if(mesh_system_info.numberOfComponents() == int(component_grid_importance.size())) {
+        modifyDistanceBasedOnComponentImportance(frags_from_ranks, component_grid_importance);
+    }
+
+    auto node_keys_for_ranks =
+        buildNodeKeysForRanks(mp, frags_from_ranks, affinities, donor_finder, history);
+
+    if(YogaConfiguration(mp).shouldPipelineDonorSearch())
+        return performPipelinedDonorSearch(mp,
+                                           inspector,
+                                           frags_from_ranks,
+                                           node_keys_for_ranks,
+                                           donor_finder,
+                                           g2l);
+    return performDonorSearchViaSingleExchange(mp,
+                                               inspector,
+                                               frags_from_ranks,
+                                               node_keys_for_ranks,
+                                               donor_finder,
+                                               g2l);
+}
+
 std::shared_ptr<OversetData> assemblyViaExchange(MessagePasser mp,
                                                  YogaMesh& view,
                                                  int load_balancer_algorithm,
@@ -123,7 +226,7 @@ std::shared_ptr<OversetData> assemblyViaExchange(MessagePasser mp,
                                                  int rcb_agglom_ncells,
                                                  bool should_add_max_receptors,
                                                  const std::vector<int>& component_grid_importance,
-                                                 std::function<bool(double*, int, double*)> is_in_cell) {
+                                                 DonorSearchHistory& history) {
     mp.Barrier();
     auto before_assembly = Parfait::Now();
     Tracer::begin("Domain Assembly");
@@ -151,40 +254,39 @@ std::shared_ptr<OversetData> assemblyViaExchange(MessagePasser mp,
 
 
     auto g2l = GlobalToLocal::buildMap(view);
-    auto fragments_and_affinities = createAndBalanceFragments(mp,
-                                                              view,
-                                                              partition_info,
-                                                              mesh_system_info,
-                                                              g2l,
-                                                              rcb_agglom_ncells,
-                                                              inspector);
-    auto& frags_from_ranks = fragments_and_affinities.first;
-    auto& affinities = fragments_and_affinities.second;
-
-    FragmentDonorFinder donor_finder(frags_from_ranks,is_in_cell);
-    Tracer::traceMemory();
-
-    //addWallDistanceToTransferNodes(mp, view, frags_from_ranks);
-    addWallDistanceToTransferNodesWithChunkedSurfaces(mp,view,frags_from_ranks);
-    if(mesh_system_info.numberOfComponents() == int(component_grid_importance.size())) {
-        modifyDistanceBasedOnComponentImportance(frags_from_ranks, component_grid_importance);
+    history.beginAssembly(mesh_system_info);
+    if(history.bodyFrames() and not history.bodyFrames()->isBuilt()) {
+        Tracer::begin("build body frame search structures");
+        YogaConfiguration config(mp);
+        history.bodyFrames()->build(mp,view,partition_info,mesh_system_info,
+                                    config.maxHoleMapCells(),config.shouldUseDistributedHoleMap());
+        Tracer::end("build body frame search structures");
     }
-
-    auto node_keys_for_ranks =
-        buildNodeKeysForRanks(mp, frags_from_ranks, affinities, donor_finder);
-
-    auto receptors = performDonorSearchViaSingleExchange(mp,
-                                                         inspector,
-                                                         frags_from_ranks,
-                                                         node_keys_for_ranks,
-                                                         donor_finder,
-                                                         g2l);
+    std::vector<Receptor> receptors;
+    if(history.canReuseAllDonors()) {
+        rootPrinter.print("Yoga: no components moved, reusing donors from previous assembly\n");
+    }
+    else {
+        receptors = searchForDonors(mp,
+                                    view,
+                                    partition_info,
+                                    mesh_system_info,
+                                    g2l,
+                                    rcb_agglom_ncells,
+                                    component_grid_importance,
+                                    history,
+                                    history.warmStart(),
+                                    inspector);
+    }
+    Tracer::begin("reuse donors");
+    receptors = mergeWithReusedReceptors(std::move(receptors),history.reusableReceptors(view,mp.Rank()),g2l);
+    history.store(receptors,mesh_system_info);
+    Tracer::end("reuse donors");
+    Tracer::traceMemory();
     addNodeNeighborsToReceptors(receptors,view,g2l);
-    node_keys_for_ranks.clear();
-    frags_from_ranks.clear();
-    donor_finder.clear();
     auto statuses = generateNodeStatuses(mp,partition_info,mesh_system_info,
-                                         view,receptors,g2l,extra_layers,should_add_max_receptors);
+                                         view,receptors,g2l,extra_layers,should_add_max_receptors,
+                                         history.bodyFrames());
     printStats(view, statuses, rootPrinter, mp);
 
 
@@ -217,27 +319,15 @@ std::shared_ptr<OversetData> assemblyViaExchange(MessagePasser mp,
 void modifyDistanceBasedOnComponentImportance(FragmentMap& fragments, const std::vector<int>& component_grid_importance) {
     for(auto& pair:fragments){
         auto& fragment = pair.second;
-        for(auto& node:fragment.transferNodes){
-            auto level = component_grid_importance[node.associatedComponentId];
+        auto& nodes = fragment.transferNodes;
+        for(size_t i=0;i<nodes.size();i++){
+            auto level = component_grid_importance[nodes.associatedComponentIds[i]];
             if(level >= 1)
-                node.distanceToWall /= (level*1.1);
+                nodes.distancesToWall[i] /= (level*1.1);
         }
     }
 }
 
-std::vector<long> countQueryPointsSentToEachRank(MessagePasser mp,
-                                                 std::map<int, std::vector<std::pair<int,int>>>& node_keys_for_ranks){
-    std::vector<long> query_point_counts(mp.NumberOfProcesses(),0);
-    for(auto& key:node_keys_for_ranks) {
-        int target_rank = key.first;
-        long number_of_query_points_i_will_send = key.second.size();
-        query_point_counts[target_rank] += number_of_query_points_i_will_send;
-    }
-    mp.ElementalSum(query_point_counts,0);
-    mp.Broadcast(query_point_counts,0);
-    return query_point_counts;
-}
-
 std::map<int, std::vector<std::pair<int,int>>> extractNodeKeysForCommRound(int current_round,
                                                                             int total_rounds,
                                                                             std::map<int, std::vector<std::pair<int,int>>>& all_node_keys_for_ranks){
@@ -257,7 +347,7 @@ std::vector<Receptor> performDonorSearchViaSingleExchange(MessagePasser mp,
                                                           const std::map<int,VoxelFragment>& frags_from_ranks,
                                                           std::map<int, std::vector<std::pair<int, int>>>&  node_keys_for_ranks,
                                                           FragmentDonorFinder& donor_finder,
-                                                          std::map<long,int>& g2l
+                                                          IdMap& g2l
 ){
     auto query_pts_from_ranks = buildAndExchangeQueryPoints(mp, inspector, frags_from_ranks, node_keys_for_ranks);
     inspector.begin("buildReceptorCollections");
@@ -268,44 +358,85 @@ std::vector<Receptor> performDonorSearchViaSingleExchange(MessagePasser mp,
     return exchangeAndUnpackDonors(mp, g2l, receptor_collections_for_ranks);
 }
 
-std::vector<Receptor> performDonorSearchInChunksToReducePeakMemory(MessagePasser mp,
-                                                                   Parfait::Inspector& inspector,
-                                                                   const std::map<int,VoxelFragment>& frags_from_ranks,
-                                                                   std::map<int, std::vector<std::pair<int, int>>>&  node_keys_for_ranks,
-                                                                   FragmentDonorFinder& donor_finder,
-                                                                   std::map<long,int>& g2l
-                                                                   ){
-    auto query_point_counts = countQueryPointsSentToEachRank(mp,node_keys_for_ranks);
-    inspector.addExternalField("query-points-processed",query_point_counts);
-    long max_query_points_per_round = 50000;
-    int n_comm_rounds = countRequiredCommRounds(max_query_points_per_round,query_point_counts);
-
-    std::vector<Receptor> all_receptors;
+std::vector<Receptor> performPipelinedDonorSearch(MessagePasser mp,
+                                                 Parfait::Inspector& inspector,
+                                                 const std::map<int,VoxelFragment>& frags_from_ranks,
+                                                 std::map<int, std::vector<std::pair<int, int>>>&  node_keys_for_ranks,
+                                                 FragmentDonorFinder& donor_finder,
+                                                 IdMap& g2l){
+    std::map<int,long> query_point_counts;
+    for(auto& pair:node_keys_for_ranks)
+        query_point_counts[pair.first] = pair.second.size();
+    QueryPointPipeline pipeline(mp,query_point_counts,QueryPointPipeline::pointsPerRoundForAvailableMemory(mp));
     RootPrinter rp(mp.Rank());
-    for(int i=0;i<n_comm_rounds;i++) {
-        std::string s = "round "+std::to_string(i)+" of "+std::to_string(n_comm_rounds);
-        Tracer::begin(s);
-        rp.print("-query point exchange "+s+"\n");
-        inspector.begin("extractNodeKeys");
-        auto node_keys = extractNodeKeysForCommRound(i,n_comm_rounds,node_keys_for_ranks);
-        inspector.end("extractNodeKeys");
-        auto query_pts_from_ranks = buildAndExchangeQueryPoints(mp, inspector, frags_from_ranks, node_keys);
+    rp.print("-query point pipeline with "+std::to_string(pipeline.roundCount())+" rounds\n");
+
+    auto pack = [&](int round,int round_count){
+        inspector.begin("pack");
+        std::map<int,std::vector<TransferNode>> query_pts_for_ranks;
+        for(auto& pair:extractNodeKeysForCommRound(round,round_count,node_keys_for_ranks)){
+            auto& query_pts = query_pts_for_ranks[pair.first];
+            for(auto node_key:pair.second)
+                query_pts.push_back(frags_from_ranks.at(node_key.first).transferNodes[node_key.second]);
+        }
+        inspector.end("pack");
+        return query_pts_for_ranks;
+    };
+    auto search = [&](const std::vector<std::vector<TransferNode>>& query_pts_from_ranks){
         inspector.begin("buildReceptorCollections");
-        auto receptor_collections_for_ranks = buildReceptorCollectionsForRanks(mp, donor_finder, query_pts_from_ranks);
+        auto collections = buildReceptorCollectionsForRanks(mp, donor_finder, query_pts_from_ranks);
         inspector.end("buildReceptorCollections");
-        auto receptors = exchangeAndUnpackDonors(mp, g2l, receptor_collections_for_ranks);
-        for(auto& receptor:receptors)
-            all_receptors.push_back(receptor);
-        Tracer::end(s);
+        return collections;
+    };
+    auto replies = pipeline.run(pack,search);
+
+    Tracer::begin("unpack donor info");
+    ReceptorMerger merger(g2l);
+    for(auto& collection:replies)
+        merger.add(collection);
+    replies = std::vector<ReceptorCollection>();
+    auto receptors = merger.extractInLocalOrder();
+    Tracer::end("unpack donor info");
+    Tracer::traceMemory();
+    return receptors;
+}
+
+void ReceptorMerger::add(ReceptorCollection& collection){
+    for(size_t i=0;i<collection.size();i++){
+        auto r = collection.get(i);
+        size_t previous_count = index_of_gid.size();
+        int& index = index_of_gid[r.globalId];
+        if(index_of_gid.size() > previous_count){
+            index = int(receptors.size());
+            receptors.emplace_back(std::move(r));
+        }
+        else{
+            auto& donor_list = receptors[index].candidateDonors;
+            donor_list.insert(donor_list.end(),
+                r.candidateDonors.begin(),r.candidateDonors.end());
+        }
     }
-    return all_receptors;
+}
+
+std::vector<Receptor> ReceptorMerger::extractInLocalOrder(){
+    std::vector<std::pair<int,int>> local_ids_and_indices(receptors.size());
+    for(size_t i=0;i<receptors.size();i++)
+        local_ids_and_indices[i] = {g2l.at(receptors[i].globalId),int(i)};
+    std::sort(local_ids_and_indices.begin(),local_ids_and_indices.end());
+    std::vector<Receptor> sorted;
+    sorted.reserve(receptors.size());
+    for(auto& pair:local_ids_and_indices)
+        sorted.emplace_back(std::move(receptors[pair.second]));
+    receptors = std::vector<Receptor>();
+    index_of_gid = IdMap();
+    return sorted;
 }
 
 std::vector<Receptor> exchangeAndUnpackDonors(const MessagePasser& mp,
-                                            std::map<long, int>& g2l,
+                                            IdMap& g2l,
                                             const std::map<int, ReceptorCollection>& receptor_collections_for_ranks) {
     Tracer::begin("exchange donorGids");
-    auto collection_packer = [](MessagePasser::Message& msg,ReceptorCollection& collection){
+    auto collection_packer = [](MessagePasser::Message& msg,const ReceptorCollection& collection){
       collection.pack(msg);
     };
     auto collection_unpacker = [](MessagePasser::Message& msg,ReceptorCollection& collection){
@@ -317,27 +448,11 @@ std::vector<Receptor> exchangeAndUnpackDonors(const MessagePasser& mp,
     Tracer::traceMemory();
 
     Tracer::begin("unpack donor info");
-    std::map<int,Receptor> receptor_map;
-    for(auto& pair:receptor_collections_from_ranks){
-        auto& collection = pair.second;
-        for(size_t i=0;i<collection.size();i++){
-            auto r = collection.get(i);
-            int local_id = g2l.at(r.globalId);
-            if(receptor_map.count(local_id) == 0){
-                receptor_map[local_id] = r;
-            }
-            else{
-                auto& donor_list = receptor_map[local_id].candidateDonors;
-                donor_list.insert(donor_list.end(),
-                    r.candidateDonors.begin(),r.candidateDonors.end());
-            }
-        }
-    }
+    ReceptorMerger merger(g2l);
+    for(auto& pair:receptor_collections_from_ranks)
+        merger.add(pair.second);
     Tracer::traceMemory();
-    std::vector<Receptor> receptors;
-    for(auto& pair:receptor_map){
-        receptors.push_back(pair.second);
-    }
+    auto receptors = merger.extractInLocalOrder();
     Tracer::end("unpack donor info");
     Tracer::traceMemory();
     return receptors;
@@ -345,7 +460,8 @@ std::vector<Receptor> exchangeAndUnpackDonors(const MessagePasser& mp,
 std::map<int, std::vector<std::pair<int, int>>> buildNodeKeysForRanks(const MessagePasser& mp,
                                                                       const FragmentMap& frags_from_ranks,
                                                                       const AffinityMap& affinities,
-                                                                      const FragmentDonorFinder& donor_finder) {
+                                                                      const FragmentDonorFinder& donor_finder,
+                                                                      const DonorSearchHistory& history) {
     Tracer::begin("gather donor finder extents");
     auto donor_finder_extents = mp.Gather(donor_finder.getExtent());
     Tracer::end("gather donor finder extents");
@@ -355,7 +471,7 @@ std::map<int, std::vector<std::pair<int, int>>> buildNodeKeysForRanks(const Mess
     Tracer::end("build overlap detector");
 
     auto node_keys_for_ranks = mapNodeIdsToRanks(mp.Rank(),
-        frags_from_ranks,overlap_detector,affinities);
+        frags_from_ranks,overlap_detector,affinities,history);
     return node_keys_for_ranks;
 }
 std::vector<NodeStatus> generateNodeStatuses(MessagePasser mp,
@@ -363,9 +479,10 @@ std::vector<NodeStatus> generateNodeStatuses(MessagePasser mp,
                                              const MeshSystemInfo& mesh_system_info,
                                              const YogaMesh& mesh,
                                              std::vector<Receptor>& receptors,
-                                             const std::map<long,int>& g2l,
+                                             const IdMap& g2l,
                                              int extra_layers,
-                                             bool should_add_max_receptors) {
+                                             bool should_add_max_receptors,
+                                             const BodyFrameSearchStructures* body_frames) {
     Tracer::begin("type assignment");
     std::vector<Parfait::Extent<double>> component_grid_extents;
     for(int i=0;i<mesh_system_info.numberOfComponents();i++)
@@ -378,11 +495,15 @@ std::vector<NodeStatus> generateNodeStatuses(MessagePasser mp,
     mp.Barrier();
 
     auto config = YogaConfiguration(mp);
-    auto hole_maps = createHoleMaps(mp,
-                                    mesh,
-                                    partition_info,
-                                    mesh_system_info,
-                                    config.maxHoleMapCells());
+    std::vector<ScalableHoleMap> built_hole_maps;
+    if(nullptr == body_frames)
+        built_hole_maps = createHoleMaps(mp,
+                                         mesh,
+                                         partition_info,
+                                         mesh_system_info,
+                                         config.maxHoleMapCells(),
+                                         config.shouldUseDistributedHoleMap());
+    auto& hole_maps = body_frames ? body_frames->holeMaps() : built_hole_maps;
 
     auto statuses = DruyorTypeAssignment::getNodeStatuses(mesh,
                                                           receptors,
@@ -403,16 +524,39 @@ std::map<int, ReceptorCollection> buildReceptorCollectionsForRanks(
     const MessagePasser& mp,
     FragmentDonorFinder& donor_finder,
     const std::vector<std::vector<TransferNode>>& query_pts_from_ranks) {
-    std::map<int,ReceptorCollection> receptor_collections_for_ranks;
-    for(int rank=0;rank<mp.NumberOfProcesses();rank++){
-        auto& query_pts = query_pts_from_ranks[rank];
-            auto&& receptors = donor_finder.generateCandidateReceptors(query_pts);
+    std::vector<long> offsets(query_pts_from_ranks.size()+1,0);
+    for(size_t rank=0;rank<query_pts_from_ranks.size();rank++)
+        offsets[rank+1] = offsets[rank] + query_pts_from_ranks[rank].size();
+
+    int thread_count = donor_finder.threadCount();
+    std::vector<FragmentDonorFinder::SearchWorkspace> workspaces(thread_count);
+    std::vector<std::map<int,ReceptorCollection>> collections_for_threads(thread_count);
+    donor_finder.prepareForThreadedSearch();
+    forEachThreadRange(thread_count,offsets.back(),[&](int thread,long start,long end){
+        std::vector<Receptor> receptors;
+        for(size_t rank=0;rank<query_pts_from_ranks.size();rank++){
+            long rank_start = std::max(start,offsets[rank]);
+            long rank_end = std::min(end,offsets[rank+1]);
+            if(rank_start >= rank_end) continue;
+            receptors.clear();
+            donor_finder.generateCandidateReceptors(query_pts_from_ranks[rank],
+                                                    rank_start-offsets[rank],
+                                                    rank_end-offsets[rank],
+                                                    workspaces[thread],
+                                                    receptors);
             for (auto& r : receptors) {
                 int owner = r.owner;
-                auto& collection = receptor_collections_for_ranks[owner];
+                auto& collection = collections_for_threads[thread][owner];
                 collection.insert(r);
             }
-    }
+        }
+    });
+    donor_finder.finishSearch(workspaces);
+
+    std::map<int,ReceptorCollection> receptor_collections_for_ranks;
+    for(auto& collections:collections_for_threads)
+        for(auto& pair:collections)
+            receptor_collections_for_ranks[pair.first].append(pair.second);
     Tracer::traceMemory();
     return receptor_collections_for_ranks;
 }
@@ -427,9 +571,9 @@ std::vector<std::vector<TransferNode>> buildAndExchangeQueryPoints(
     for(auto& pair:node_keys_for_ranks){
         int target_rank = pair.first;
         for(auto node_key:pair.second) {
-            auto& tn = frags_from_ranks.at(node_key.first).transferNodes[node_key.second];
-            query_pts_for_ranks[target_rank].push_back(tn);
-            unique_query_points.insert(tn.globalId);
+            auto& nodes = frags_from_ranks.at(node_key.first).transferNodes;
+            query_pts_for_ranks[target_rank].push_back(nodes[node_key.second]);
+            unique_query_points.insert(nodes.globalIds[node_key.second]);
         }
     }
     inspector.end("pack");
@@ -437,7 +581,16 @@ std::vector<std::vector<TransferNode>> buildAndExchangeQueryPoints(
     Tracer::traceMemory();
 
     Tracer::begin("exchange");
-    auto query_pts_from_ranks = mp.Exchange(query_pts_for_ranks);
+    std::map<int,MessagePasser::Message> messages;
+    for(int rank=0;rank<mp.NumberOfProcesses();rank++){
+        if(query_pts_for_ranks[rank].empty()) continue;
+        CompactPacking::packQueryPoints(messages[rank],query_pts_for_ranks[rank]);
+        query_pts_for_ranks[rank] = std::vector<TransferNode>();
+    }
+    messages = mp.Exchange(messages);
+    std::vector<std::vector<TransferNode>> query_pts_from_ranks(mp.NumberOfProcesses());
+    for(auto& pair:messages)
+        CompactPacking::unpackQueryPoints(pair.second,query_pts_from_ranks[pair.first]);
     Tracer::end("exchange");
     Tracer::traceMemory();
     return query_pts_from_ranks;
@@ -455,67 +608,47 @@ void addWallDistanceToTransferNodes(MessagePasser mp,
     NanoFlannDistanceCalculator distanceCalculator(surfaces);
     Tracer::traceMemory();
     for (auto& pair : frags_from_ranks) {
-        for (auto& node : pair.second.transferNodes) {
-            node.distanceToWall = distanceCalculator.calcDistance(
-                node.xyz, node.associatedComponentId);
+        auto& nodes = pair.second.transferNodes;
+        for (size_t i = 0; i < nodes.size(); i++) {
+            nodes.distancesToWall[i] = distanceCalculator.calcDistance(
+                nodes.xyz[i], nodes.associatedComponentIds[i]);
         }
     }
     Tracer::end("distance");
 }
 
-void initializeWallDistanceForTransferNodes(FragmentMap& frags_from_ranks){
-    double massive = std::sqrt(std::numeric_limits<double>::max());
-    for(auto& pair: frags_from_ranks)
-        for(auto& node: pair.second.transferNodes)
-            node.distanceToWall = massive;
-}
-
-void overrideDistanceIfSmallerIsFound(FragmentMap& frags_from_ranks,
-                                      std::vector<Parfait::Point<double>>&& chunk,
-                                      int n_components,
-                                      int current_component){
-    std::vector<std::vector<Parfait::Point<double>>> surface_points_for_components(n_components);
-    surface_points_for_components[current_component] = chunk;
-    NanoFlannDistanceCalculator distance_calculator(surface_points_for_components);
-    for(auto& pair: frags_from_ranks){
-        for(auto& node: pair.second.transferNodes){
-            if(node.associatedComponentId == current_component){
-                double d = distance_calculator.calcDistance(node.xyz,current_component);
-                if(d < node.distanceToWall)
-                    node.distanceToWall = d;
-            }
-        }
+void addFacetWallDistanceToTransferNodes(MessagePasser mp,
+                                         const YogaMesh& mesh,
+                                         FragmentMap& frags_from_ranks,
+                                         const BodyFrameSearchStructures* body_frames) {
+    Tracer::begin("wall distance");
+    std::unique_ptr<DistributedWallDistance> built_wall_distance;
+    if (nullptr == body_frames) built_wall_distance = std::make_unique<DistributedWallDistance>(mp, mesh);
+    auto& wall_distance = body_frames ? body_frames->wallDistance() : *built_wall_distance;
+    std::vector<Parfait::Point<double>> points;
+    std::vector<int> components;
+    for (auto& pair : frags_from_ranks) {
+        auto& nodes = pair.second.transferNodes;
+        points.insert(points.end(), nodes.xyz.begin(), nodes.xyz.end());
+        components.insert(components.end(), nodes.associatedComponentIds.begin(), nodes.associatedComponentIds.end());
     }
-
-}
-
-void addWallDistanceToTransferNodesWithChunkedSurfaces(MessagePasser mp,
-                                    const YogaMesh& mesh,
-                                    FragmentMap& frags_from_ranks) {
-    initializeWallDistanceForTransferNodes(frags_from_ranks);
-    int n = ParallelSurface::countComponents(mp,mesh);
-    for(int component=0;component<n;component++){
-        std::string s = "component_" + std::to_string(component);
-        Tracer::begin(s);
-        auto surface_points = ParallelSurface::getLocalSurfacePointsInComponent(mesh,component);
-        long total_points = mp.ParallelSum(long(surface_points.size()));
-        long max_points_per_chunk = 50000;
-        max_points_per_chunk = std::max(max_points_per_chunk, total_points / 5);
-        ChunkedPointGatherer gatherer(mp,surface_points,max_points_per_chunk);
-        for(int i=0;i<gatherer.chunkCount();i++){
-            Tracer::begin("surface-chunk");
-            auto chunk = gatherer.extractChunkInParallel(i);
-            overrideDistanceIfSmallerIsFound(frags_from_ranks,std::move(chunk),n,component);
-            Tracer::end("surface-chunk");
-        }
-        Tracer::end(s);
+    if (body_frames)
+        for (size_t i = 0; i < points.size(); i++) points[i] = body_frames->toBodyFrame(points[i], components[i]);
+    auto distance = wall_distance.calcDistances(points, components);
+    auto next = distance.begin();
+    for (auto& pair : frags_from_ranks) {
+        auto& distances = pair.second.transferNodes.distancesToWall;
+        std::copy(next, next + distances.size(), distances.begin());
+        next += distances.size();
     }
+    Tracer::end("wall distance");
 }
 
 std::map<int,std::vector<std::pair<int,int>>> mapNodeIdsToRanks(int rank,
                                                                 const std::map<int,VoxelFragment>& fragments,
                                                                 const OverlapDetector& overlap_detector,
-                                                                const std::map<int,std::vector<bool>>& affinities) {
+                                                                const std::map<int,std::vector<bool>>& affinities,
+                                                                const DonorSearchHistory& history) {
 
     std::map<int, std::vector<std::pair<int,int>>> node_ids_to_ranks;
     std::vector<int> ranks;
@@ -526,9 +659,10 @@ std::map<int,std::vector<std::pair<int,int>>> mapNodeIdsToRanks(int rank,
         for(size_t i=0;i<frag.transferNodes.size();i++) {
             bool is_uniquely_claimed_by_fragment = affinities.at(frag_rank)[i];
             if(not is_uniquely_claimed_by_fragment) continue;
-            auto& node = frag.transferNodes[i];
+            auto& p = frag.transferNodes.xyz[i];
+            if(not history.requiresSearch(p,frag.transferNodes.associatedComponentIds[i])) continue;
             ranks.clear();
-            overlap_detector.getOverlappingRanks(node.xyz, ranks);
+            overlap_detector.getOverlappingRanks(p, ranks);
             for (int r : ranks) {
                 node_ids_to_ranks[r].push_back({frag_rank,i});
             }
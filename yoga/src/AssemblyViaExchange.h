@@ -2,6 +2,7 @@
 #include "OversetData.h"
 #include "YogaMesh.h"
 #include "VoxelFragment.h"
+#include "DonorSearchHistory.h"
 
 namespace YOGA {
 std::shared_ptr<OversetData> assemblyViaExchange(MessagePasser mp,
@@ -11,9 +12,17 @@ std::shared_ptr<OversetData> assemblyViaExchange(MessagePasser mp,
                                                  int extra_layers,
                                                  int rcb_agglom_ncells,
                                                  bool should_add_max_receptors,
-                                                 const std::vector<int>& component_grid_importance,
-                                                 std::function<bool(double*, int, double*)> is_in_cell);
+                                                 const std::vector<int>& component_grid_importance);
 
+std::shared_ptr<OversetData> assemblyViaExchange(MessagePasser mp,
+                                                 YogaMesh& view,
+                                                 int load_balancer_algorithm,
+                                                 int target_voxel_size,
+                                                 int extra_layers,
+                                                 int rcb_agglom_ncells,
+                                                 bool should_add_max_receptors,
+                                                 const std::vector<int>& component_grid_importance,
+                                                 DonorSearchHistory& history);
 
 
 int countRequiredCommRounds(long max_per_round,const std::vector<long>& query_point_counts);
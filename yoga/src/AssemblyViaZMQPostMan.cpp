@@ -87,7 +87,12 @@ std::shared_ptr<OversetData> assemblyViaZMQPostMan(MessagePasser mp,
     rootPrinter.print("Total work units: "+std::to_string(loadBalancer->getRemainingVoxelCount())+"\n");
 
     auto config = YOGA::YogaConfiguration(mp);
-    auto hole_maps = createHoleMaps(mp, view, partition_info, mesh_system_info, config.maxHoleMapCells());
+    auto hole_maps = createHoleMaps(mp,
+                                    view,
+                                    partition_info,
+                                    mesh_system_info,
+                                    config.maxHoleMapCells(),
+                                    config.shouldUseDistributedHoleMap());
 
     auto initial_work_unit_mask = getInitialWorkUnitMask(mp, loadBalancer);
     auto initial_work_units = getInitialWorkUnits(mp, loadBalancer);
@@ -144,6 +149,7 @@ std::shared_ptr<OversetData> assemblyViaZMQPostMan(MessagePasser mp,
             initial_work_units,
             host_ranks,
             grid_fetcher);
+    worker->setMortonOrdering(config.shouldMortonOrderDonorSearch());
 
     Tracer::traceMemory();
     Tracer::begin("donor search");
@@ -224,8 +230,8 @@ std::shared_ptr<OversetData> assemblyViaZMQPostMan(MessagePasser mp,
 Parfait::Extent<double> getExtent(std::vector<VoxelFragment> fragments) {
     auto e = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
     for(auto&frag:fragments)
-        for(auto& node : frag.transferNodes)
-            Parfait::ExtentBuilder::add(e,node.xyz);
+        for(auto& p : frag.transferNodes.xyz)
+            Parfait::ExtentBuilder::add(e,p);
     return e;
 }
 
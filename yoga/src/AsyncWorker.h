@@ -36,6 +36,10 @@ class AsyncWorker {
           is_in_cell(is_in_cell),
           overlap_detector(overlap_detector){}
 
+    // Sorts the cells of each work voxel by the Morton key of their centroids
+    // before the donor search builds its ADT over them.
+    void setMortonOrdering(bool enable){morton_ordering = enable;}
+
     void workUntilFinished() {
         auto initial_fragments = sendFragmentsBasedOnInitialWorkUnits();
         if(intitial_work_unit_mask[my_rank]){
@@ -106,6 +110,7 @@ class AsyncWorker {
     std::function<bool(double*, int, double*)> is_in_cell;
     const OverlapDetector& overlap_detector;
     int dci_send_count = 0;
+    bool morton_ordering = false;
     std::vector<int> nodes_per_work_unit;
 
     std::map<int,MessagePasser::Message> sendFragmentsBasedOnInitialWorkUnits(){
@@ -134,6 +139,7 @@ class AsyncWorker {
             extractFragmentsFromMsg(voxel,msg);
         }
 
+        if(morton_ordering) voxel.sortCellsByMortonKey();
         nodes_per_work_unit.push_back(voxel.nodes.size());
         calcAndSetDistanceToNodes(voxel);
         auto n2n = createNodeNeighbors(voxel);
@@ -150,6 +156,7 @@ class AsyncWorker {
         WorkVoxel voxel(e, is_in_cell);
         waitOnFragments(n,voxel);
 
+        if(morton_ordering) voxel.sortCellsByMortonKey();
         nodes_per_work_unit.push_back(voxel.nodes.size());
         calcAndSetDistanceToNodes(voxel);
         auto n2n = createNodeNeighbors(voxel);
@@ -177,14 +184,15 @@ class AsyncWorker {
         post_man.push(0,WorkUnitsComplete,MessagePasser::Message());
     }
 
-    void fillNeighbors(std::vector<std::set<int>>& n2n,const int* cell,int cell_size,
+    template <typename Emit>
+    void fillNeighbors(Emit emit,const int* cell,int cell_size,
         const std::vector<bool>& is_outside_voxel){
         for(int i=0;i<cell_size;i++){
             for(int j=i+1;j<cell_size;j++){
                 int left = cell[i];
                 int right = cell[j];
-                if(not is_outside_voxel[left]) n2n[left].insert(right);
-                if(not is_outside_voxel[right]) n2n[right].insert(left);
+                if(not is_outside_voxel[left]) emit(left,right);
+                if(not is_outside_voxel[right]) emit(right,left);
             }
         }
     }
@@ -196,26 +204,16 @@ class AsyncWorker {
         return is_outside;
     }
 
-    std::vector<std::set<int>> createNodeNeighbors(const WorkVoxel& voxel){
+    Parfait::CompressedRowGraph createNodeNeighbors(const WorkVoxel& voxel){
         Tracer::begin("n2n");
         auto is_outside = flagNodesOutsideVoxel(voxel);
-        std::vector<std::set<int>> n2n(voxel.nodes.size());
-        for(int i=0;i<int(voxel.tets.size());i++){
-            auto& cell = voxel.tets[i];
-            fillNeighbors(n2n,cell.nodeIds.data(),4,is_outside);
-        }
-        for(int i=0;i<int(voxel.pyramids.size());i++){
-            auto& cell = voxel.pyramids[i];
-            fillNeighbors(n2n,cell.nodeIds.data(),5,is_outside);
-        }
-        for(int i=0;i<int(voxel.prisms.size());i++){
-            auto& cell = voxel.prisms[i];
-            fillNeighbors(n2n,cell.nodeIds.data(),6,is_outside);
-        }
-        for(int i=0;i<int(voxel.hexs.size());i++){
-            auto& cell = voxel.hexs[i];
-            fillNeighbors(n2n,cell.nodeIds.data(),8,is_outside);
-        }
+        auto n2n = Parfait::CompressedRowGraph::build(voxel.nodes.size(),[&](auto emit){
+            for(auto& cell:voxel.tets) fillNeighbors(emit,cell.nodeIds.data(),4,is_outside);
+            for(auto& cell:voxel.pyramids) fillNeighbors(emit,cell.nodeIds.data(),5,is_outside);
+            for(auto& cell:voxel.prisms) fillNeighbors(emit,cell.nodeIds.data(),6,is_outside);
+            for(auto& cell:voxel.hexs) fillNeighbors(emit,cell.nodeIds.data(),8,is_outside);
+        });
+        n2n.sortAndRemoveDuplicates();
         Tracer::end("n2n");
         return n2n;
     }
@@ -259,7 +257,7 @@ class AsyncWorker {
 
     void extractFragment(WorkVoxel& voxel, MessagePasser::Message& msg) const {
         VoxelFragment fragment;
-        msg.unpack(fragment.transferNodes);
+        TransferNodes::unpack(msg,fragment.transferNodes);
         msg.unpack(fragment.transferTets);
         msg.unpack(fragment.transferPyramids);
         msg.unpack(fragment.transferPrisms);
@@ -0,0 +1,78 @@
+#pragma once
+#include <MessagePasser/MessagePasser.h>
+#include <parfait/MotionMatrix.h>
+#include <parfait/Point.h>
+#include <memory>
+#include <vector>
+#include "DistributedWallDistance.h"
+#include "HoleCuttingTools.h"
+#include "MeshSystemInfo.h"
+#include "PartitionInfo.h"
+#include "ScalableHoleMap.h"
+#include "YogaMesh.h"
+
+namespace YOGA {
+
+// Wall-distance trees and hole maps for components that only ever move rigidly
+// (e.g. rotor blades moved by PersistentAssembly::moveComponent).
+//
+// Both are built once, and the pose of each component at that time becomes its
+// body frame.  Later motions are only accumulated: a query point is pulled back
+// into the body frame of the component it is tested against with the inverse
+// of that component's motion, so nothing is rebuilt while the blades turn.
+class BodyFrameSearchStructures {
+  public:
+    void setEnabled(bool enable) {
+        if (not enable) clear();
+        is_enabled = enable;
+    }
+    bool isEnabled() const { return is_enabled; }
+    bool isBuilt() const { return wall_distance != nullptr; }
+
+    // Collective.  Does nothing if the structures already exist.
+    void build(MessagePasser mp,
+               const YogaMesh& mesh,
+               const PartitionInfo& partition_info,
+               const MeshSystemInfo& mesh_system_info,
+               int max_hole_map_cells,
+               bool distributed_hole_map) {
+        if (isBuilt()) return;
+        wall_distance = std::make_unique<DistributedWallDistance>(mp, mesh);
+        hole_maps = createHoleMaps(mp, mesh, partition_info, mesh_system_info, max_hole_map_cells, distributed_hole_map);
+        inertial_to_body.assign(mesh_system_info.numberOfComponents(), Parfait::MotionMatrix());
+        body_to_inertial = inertial_to_body;
+    }
+
+    // Motion before the structures are built is already part of the body frame.
+    void addMotion(int component, const Parfait::MotionMatrix& motion) {
+        if (not isBuilt() or component >= int(body_to_inertial.size())) return;
+        body_to_inertial[component].addMotion(motion);
+        inertial_to_body[component] = body_to_inertial[component].inverse();
+        for (auto& hole_map : hole_maps)
+            if (hole_map.getAssociatedComponentId() == component) hole_map.setBodyFrame(inertial_to_body[component]);
+    }
+
+    Parfait::Point<double> toBodyFrame(Parfait::Point<double> p, int component) const {
+        if (component < int(inertial_to_body.size())) inertial_to_body[component].movePoint(p);
+        return p;
+    }
+
+    const DistributedWallDistance& wallDistance() const { return *wall_distance; }
+    const std::vector<ScalableHoleMap>& holeMaps() const { return hole_maps; }
+
+    void clear() {
+        wall_distance.reset();
+        hole_maps.clear();
+        inertial_to_body.clear();
+        body_to_inertial.clear();
+    }
+
+  private:
+    bool is_enabled = false;
+    std::unique_ptr<DistributedWallDistance> wall_distance;
+    std::vector<ScalableHoleMap> hole_maps;
+    std::vector<Parfait::MotionMatrix> body_to_inertial;
+    std::vector<Parfait::MotionMatrix> inertial_to_body;
+};
+
+}
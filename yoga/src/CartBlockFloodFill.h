@@ -41,10 +41,7 @@ class CartBlockFloodFill {
         return cells;
     }
 
-    static void removeSeedsOnPlane(SymmetryPlane& plane,
-                                   Parfait::CartBlock& block,
-                                   std::vector<int>& seeds,
-                                   std::vector<int>& cellStatuses) {
+    static Parfait::Extent<double> getPlaneExtent(SymmetryPlane& plane, const Parfait::CartBlock& block) {
         int direction = plane.getPlane();
         double position = plane.getPosition();
         double pillow = 0.0;
@@ -57,6 +54,14 @@ class CartBlockFloodFill {
         auto planeExtent = Parfait::Extent<double>(block.lo, block.hi);
         planeExtent.lo[direction] = position - pillow;
         planeExtent.hi[direction] = position + pillow;
+        return planeExtent;
+    }
+
+    static void removeSeedsOnPlane(SymmetryPlane& plane,
+                                   Parfait::CartBlock& block,
+                                   std::vector<int>& seeds,
+                                   std::vector<int>& cellStatuses) {
+        auto planeExtent = getPlaneExtent(plane, block);
         for (size_t i = 0; i < seeds.size(); ++i) {
             int cellId = seeds[i];
             if (planeExtent.intersects(block.createExtentFromCell(seeds[i]))) {
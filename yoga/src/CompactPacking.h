@@ -0,0 +1,85 @@
+#pragma once
+#include <MessagePasser/MessagePasser.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "TransferNode.h"
+
+namespace YOGA {
+namespace CompactPacking {
+
+// Integers are written seven bits per byte, low bits first, with the high bit
+// set on every byte but the last.  Signed values are zigzag mapped first so
+// small negative numbers stay short.
+inline void packUnsigned(MessagePasser::Message& msg, unsigned long x) {
+    char bytes[10];
+    int n = 0;
+    while (x >= 0x80) {
+        bytes[n++] = char((x & 0x7f) | 0x80);
+        x >>= 7;
+    }
+    bytes[n++] = char(x);
+    msg.pack(bytes, n);
+}
+
+inline unsigned long unpackUnsigned(MessagePasser::Message& msg) {
+    unsigned long x = 0;
+    for (int shift = 0;; shift += 7) {
+        unsigned char byte = 0;
+        msg.unpack(byte);
+        x |= (unsigned long)(byte & 0x7f) << shift;
+        if (0 == (byte & 0x80)) return x;
+    }
+}
+
+inline void packSigned(MessagePasser::Message& msg, long x) {
+    packUnsigned(msg, (static_cast<unsigned long>(x) << 1) ^ static_cast<unsigned long>(x >> 63));
+}
+
+inline long unpackSigned(MessagePasser::Message& msg) {
+    unsigned long x = unpackUnsigned(msg);
+    return static_cast<long>(x >> 1) ^ -static_cast<long>(x & 1);
+}
+
+// Returns the indices of ids in increasing id order, so the ids can be sent as
+// gaps from the previous one.
+inline std::vector<int> increasingOrder(const std::vector<long>& ids) {
+    std::vector<int> order(ids.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return ids[a] < ids[b]; });
+    return order;
+}
+
+// Query points are searched independently, so they are sent in global id order.
+inline void packQueryPoints(MessagePasser::Message& msg, const std::vector<TransferNode>& nodes) {
+    std::vector<long> ids(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) ids[i] = nodes[i].globalId;
+    packUnsigned(msg, nodes.size());
+    long previous = 0;
+    for (int i : increasingOrder(ids)) {
+        auto& node = nodes[i];
+        packSigned(msg, node.globalId - previous);
+        previous = node.globalId;
+        msg.pack(node.xyz);
+        packSigned(msg, node.associatedComponentId);
+        packSigned(msg, node.owningRank);
+        msg.pack(node.distanceToWall);
+    }
+}
+
+inline void unpackQueryPoints(MessagePasser::Message& msg, std::vector<TransferNode>& nodes) {
+    size_t n = unpackUnsigned(msg);
+    nodes.resize(n);
+    long previous = 0;
+    for (auto& node : nodes) {
+        node.globalId = previous + unpackSigned(msg);
+        previous = node.globalId;
+        msg.unpack(node.xyz);
+        node.associatedComponentId = int(unpackSigned(msg));
+        node.owningRank = int(unpackSigned(msg));
+        msg.unpack(node.distanceToWall);
+    }
+}
+
+}
+}
@@ -5,6 +5,7 @@
 #include <MessagePasser/MessagePasser.h>
 #include <Tracer.h>
 #include "GhostSyncPatternBuilder.h"
+#include "IdMap.h"
 #include "ParallelColorCombinator.h"
 #include "ColorSyncer.h"
 
@@ -28,7 +29,7 @@ class ComponentGridIdentifier {
         auto sync_pattern = YOGA::GhostSyncPatternBuilder::build(   mesh,mp);
         Tracer::end("build sync pattern");
 
-        std::map<long,int> g2l;
+        IdMap g2l;
         for(int i=0;i<mesh.nodeCount();i++)
             g2l[mesh.globalNodeId(i)] = i;
 
@@ -1,5 +1,5 @@
 #include "Connectivity.h"
-#include <thread>
+#include <algorithm>
 #include <Tracer.h>
 
 namespace YOGA {
@@ -15,25 +15,40 @@ std::vector<std::vector<int>> Connectivity::nodeToCell(const YogaMesh& mesh) {
 }
 
 std::vector<std::vector<int>> Connectivity::nodeToNode(const YogaMesh& mesh) {
+    return nodeToNodeCompressed(mesh).toVectorOfVectors();
+}
+
+Parfait::CompressedRowGraph Connectivity::nodeToCellCompressed(const YogaMesh& mesh) {
+    std::vector<int> cell;
+    return Parfait::CompressedRowGraph::build(mesh.nodeCount(), [&](auto emit) {
+        for (int i = 0; i < mesh.numberOfCells(); i++) {
+            cell.resize(mesh.numberOfNodesInCell(i));
+            mesh.getNodesInCell(i, cell.data());
+            for (int node : cell) emit(node, i);
+        }
+    });
+}
+
+Parfait::CompressedRowGraph Connectivity::nodeToNodeCompressed(const YogaMesh& mesh, int thread_count) {
     Tracer::begin("Build n2n");
-    std::vector<std::set<int>> n2n(mesh.nodeCount());
     Tracer::begin("Build n2c");
-    auto n2c = nodeToCell(mesh);
+    auto n2c = nodeToCellCompressed(mesh);
     Tracer::end("Build n2c");
-    std::vector<int> cell;
-    for (int i = 0; i < mesh.nodeCount(); i++) {
-        for (int cell_id : n2c[i]) {
-            cell.resize(mesh.numberOfNodesInCell(cell_id));
-            mesh.getNodesInCell(cell_id, cell.data());
-            for (int nbr : cell)
-                if (nbr != i) n2n[i].insert(nbr);
-        }
-    }
-    Tracer::begin("convert");
-    std::vector<std::vector<int>> node_to_node(n2n.size());
-    for (size_t i = 0; i < n2n.size(); i++) node_to_node[i] = std::vector<int>(n2n[i].begin(), n2n[i].end());
-    Tracer::end("convert");
+    auto n2n = Parfait::CompressedRowGraph::buildByRow(
+        mesh.nodeCount(),
+        [&](long node, std::vector<int>& neighbors) {
+            int cell[8];
+            for (int cell_id : n2c[node]) {
+                int n = mesh.numberOfNodesInCell(cell_id);
+                mesh.getNodesInCell(cell_id, cell);
+                for (int i = 0; i < n; i++)
+                    if (cell[i] != node) neighbors.push_back(cell[i]);
+            }
+            std::sort(neighbors.begin(), neighbors.end());
+            neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        },
+        thread_count);
     Tracer::end("Build n2n");
-    return node_to_node;
+    return n2n;
+}
 }
-}
\ No newline at end of file
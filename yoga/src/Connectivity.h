@@ -1,4 +1,5 @@
 #pragma once
+#include <parfait/CompressedRowGraph.h>
 #include <set>
 #include <vector>
 #include "YogaMesh.h"
@@ -9,5 +10,9 @@ class Connectivity {
   public:
     static std::vector<std::vector<int>> nodeToCell(const YogaMesh& mesh);
     static std::vector<std::vector<int>> nodeToNode(const YogaMesh& mesh);
+
+    // Same adjacency as above, stored as compressed rows (neighbors sorted).
+    static Parfait::CompressedRowGraph nodeToCellCompressed(const YogaMesh& mesh);
+    static Parfait::CompressedRowGraph nodeToNodeCompressed(const YogaMesh& mesh, int thread_count = 1);
 };
-}
\ No newline at end of file
+}
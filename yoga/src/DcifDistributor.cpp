@@ -12,6 +12,20 @@ namespace Dcif {
         }
         return receptors_for_ranks;
     }
+    std::vector<Receptor> redistributeReceptorsByGid(MessagePasser mp,
+                                                     const std::vector<Receptor>& receptors,
+                                                     long global_node_count) {
+        std::map<int, MessagePasser::Message> msgs_for_ranks;
+        for (auto& pair : mapReceptorsToRanks(receptors, global_node_count, mp.NumberOfProcesses())) {
+            auto& msg = msgs_for_ranks[pair.first];
+            msg.pack(long(pair.second.size()));
+            for (auto& receptor : pair.second) receptor.pack(msg);
+        }
+        std::vector<Receptor> resident_receptors;
+        for (auto& pair : mp.Exchange(msgs_for_ranks))
+            for (auto& receptor : unpackReceptors(pair.second)) resident_receptors.emplace_back(receptor);
+        return resident_receptors;
+    }
     std::vector<Receptor> getChunkOfReceptors(const Dcif::FlattenedDomainConnectivity& dcif,
                                                     long begin,
                                                     long end) {
@@ -59,8 +73,8 @@ namespace Dcif {
         }
         return receptors;
     }
-    std::map<long, int> buildGlobalToReceptorIndex(const std::vector<Receptor>& resident_receptors) {
-        std::map<long, int> global_to_receptor_index;
+    IdMap buildGlobalToReceptorIndex(const std::vector<Receptor>& resident_receptors) {
+        IdMap global_to_receptor_index;
         for (int i = 0; i < int(resident_receptors.size()); i++) {
             auto& receptor = resident_receptors[i];
             global_to_receptor_index[receptor.gid] = i;
@@ -3,6 +3,7 @@
 #include <parfait/LinearPartitioner.h>
 #include <parfait/Throw.h>
 #include <MessagePasser/MessagePasser.h>
+#include "IdMap.h"
 
 namespace YOGA{
 namespace Dcif {
@@ -67,7 +68,7 @@ namespace Dcif {
         std::vector<int> iblank;
     };
 
-    std::map<long, int> buildGlobalToReceptorIndex(const std::vector<Receptor>& resident_receptors);
+    IdMap buildGlobalToReceptorIndex(const std::vector<Receptor>& resident_receptors);
 
     std::vector<Receptor> unpackReceptors(MessagePasser::Message& msg);
 
@@ -81,5 +82,10 @@ namespace Dcif {
     std::map<int, std::vector<Receptor>> mapReceptorsToRanks(const std::vector<Receptor>& receptors,
                                                                      long global_node_count,
                                                                      int nranks);
+
+    // Sends each receptor to the rank that holds its gid in a linear partition of the nodes.
+    std::vector<Receptor> redistributeReceptorsByGid(MessagePasser mp,
+                                                     const std::vector<Receptor>& receptors,
+                                                     long global_node_count);
 }
 }
\ No newline at end of file
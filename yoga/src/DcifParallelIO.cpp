@@ -0,0 +1,157 @@
+#include "DcifParallelIO.h"
+#include <parfait/ByteSwap.h>
+#include <parfait/Throw.h>
+#include <algorithm>
+#include <limits>
+
+namespace YOGA {
+namespace Dcif {
+
+    namespace {
+        bool anyCountsAreNegativeOrRidiculouslyBig(long nnodes, long nfringes, long ndonors, int ngrids) {
+            if (nnodes < 0 or ndonors < 0 or nfringes < 0 or ngrids < 0) return true;
+            long ridiculously_big = std::numeric_limits<long>::max() / 2;
+            return nnodes > ridiculously_big or ndonors > ridiculously_big or nfringes > ridiculously_big;
+        }
+
+        template <typename T>
+        void swapBytes(std::vector<T>& v) {
+            if (8 == sizeof(T))
+                for (auto& x : v) bswap_64(&x);
+            else if (4 == sizeof(T))
+                for (auto& x : v) bswap_32(&x);
+        }
+    }
+
+    Slice sliceInRankOrder(MessagePasser mp, long count) {
+        Slice slice{0, 0};
+        MPI_Exscan(&count, &slice.offset, 1, MPI_LONG, MPI_SUM, mp.getCommunicator());
+        if (0 == mp.Rank()) slice.offset = 0;
+        slice.total = mp.ParallelSum(count);
+        return slice;
+    }
+
+    MPI_File openForWriting(MessagePasser mp, const std::string& filename) {
+        MPI_File f;
+        int error = MPI_File_open(
+            mp.getCommunicator(), filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &f);
+        if (MPI_SUCCESS != error) PARFAIT_THROW("Could not open " + filename + " for writing");
+        MPI_File_set_size(f, 0);
+        return f;
+    }
+
+    MPI_File openForReading(MessagePasser mp, const std::string& filename) {
+        MPI_File f;
+        int error = MPI_File_open(mp.getCommunicator(), filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &f);
+        if (MPI_SUCCESS != error) PARFAIT_THROW("Could not open " + filename + " for reading");
+        return f;
+    }
+
+    SliceReader::SliceReader(MessagePasser mp, const std::string& filename) {
+        auto f = openForReading(mp, filename);
+        readHeader(mp, f);
+        readFooter(mp, f);
+        readReceptors(mp, f);
+        readIblank(mp, f);
+        MPI_File_close(&f);
+    }
+
+    std::vector<long> SliceReader::gridNodeIdOffsets() const {
+        std::vector<long> offsets = {0};
+        for (int i = 0; i < ngrids; i++) offsets.push_back(offsets.back() + 1 + grid_stop[i] - grid_start[i]);
+        return offsets;
+    }
+
+    void SliceReader::readHeader(MessagePasser mp, MPI_File f) {
+        std::vector<char> header(Layout::header_bytes);
+        mp.ReadAtAll(f, 0, header.data(), 0 == mp.Rank() ? Layout::header_bytes : 0);
+        mp.Broadcast(header, 0);
+        int64_t counts[3];
+        int32_t grids;
+        std::copy(header.data(), header.data() + 24, reinterpret_cast<char*>(counts));
+        std::copy(header.data() + 24, header.data() + 28, reinterpret_cast<char*>(&grids));
+        if (anyCountsAreNegativeOrRidiculouslyBig(counts[0], counts[1], counts[2], grids)) {
+            should_swap_bytes = true;
+            for (auto& c : counts) bswap_64(&c);
+            bswap_32(&grids);
+        }
+        nnodes = counts[0];
+        nfringes = counts[1];
+        ndonors = counts[2];
+        ngrids = grids;
+        if (anyCountsAreNegativeOrRidiculouslyBig(nnodes, nfringes, ndonors, ngrids))
+            PARFAIT_THROW("Dcif header doesn't make sense.");
+    }
+
+    void SliceReader::readFooter(MessagePasser mp, MPI_File f) {
+        long footer_bytes = ngrids * Layout::footer_bytes_per_grid;
+        std::vector<char> footer(footer_bytes);
+        Layout layout(nnodes, nfringes, ndonors);
+        mp.ReadAtAll(f, layout.footer(), footer.data(), 0 == mp.Rank() ? footer_bytes : 0);
+        mp.Broadcast(footer, 0);
+        grid_start.resize(ngrids);
+        grid_stop.resize(ngrids);
+        grid_imesh.resize(ngrids);
+        for (int i = 0; i < ngrids; i++) {
+            const char* entry = footer.data() + i * Layout::footer_bytes_per_grid;
+            int64_t start, stop;
+            int32_t imesh;
+            std::copy(entry, entry + 8, reinterpret_cast<char*>(&start));
+            std::copy(entry + 8, entry + 16, reinterpret_cast<char*>(&stop));
+            std::copy(entry + 16, entry + 20, reinterpret_cast<char*>(&imesh));
+            if (should_swap_bytes) {
+                bswap_64(&start);
+                bswap_64(&stop);
+                bswap_32(&imesh);
+            }
+            grid_start[i] = start - 1;
+            grid_stop[i] = stop - 1;
+            grid_imesh[i] = imesh;
+        }
+    }
+
+    void SliceReader::readReceptors(MessagePasser mp, MPI_File f) {
+        Layout layout(nnodes, nfringes, ndonors);
+        auto range = Parfait::LinearPartitioner::getRangeForWorker(mp.Rank(), nfringes, mp.NumberOfProcesses());
+        long n = range.end - range.start;
+
+        std::vector<int64_t> fringe_ids(n);
+        std::vector<int8_t> donor_counts(n);
+        mp.ReadAtAll(f, layout.fringeIds() + 8 * range.start, fringe_ids.data(), 8 * n);
+        mp.ReadAtAll(f, layout.donorCounts() + range.start, donor_counts.data(), n);
+
+        long my_donor_count = 0;
+        for (auto count : donor_counts) my_donor_count += count;
+        auto donors = sliceInRankOrder(mp, my_donor_count);
+        std::vector<int64_t> donor_ids(my_donor_count);
+        std::vector<double> donor_weights(my_donor_count);
+        mp.ReadAtAll(f, layout.donorIds() + 8 * donors.offset, donor_ids.data(), 8 * my_donor_count);
+        mp.ReadAtAll(f, layout.donorWeights() + 8 * donors.offset, donor_weights.data(), 8 * my_donor_count);
+
+        if (should_swap_bytes) {
+            swapBytes(fringe_ids);
+            swapBytes(donor_ids);
+            swapBytes(donor_weights);
+        }
+
+        receptor_slice.resize(n);
+        long next_donor = 0;
+        for (long i = 0; i < n; i++) {
+            auto& r = receptor_slice[i];
+            r.gid = fringe_ids[i] - 1;
+            for (int j = 0; j < donor_counts[i]; j++, next_donor++) {
+                r.donor_ids.push_back(donor_ids[next_donor] - 1);
+                r.donor_weights.push_back(donor_weights[next_donor]);
+            }
+        }
+    }
+
+    void SliceReader::readIblank(MessagePasser mp, MPI_File f) {
+        Layout layout(nnodes, nfringes, ndonors);
+        node_range = Parfait::LinearPartitioner::getRangeForWorker(mp.Rank(), nnodes, mp.NumberOfProcesses());
+        long n = node_range.end - node_range.start;
+        iblank_slice.resize(n);
+        mp.ReadAtAll(f, layout.iblank() + node_range.start, iblank_slice.data(), n);
+    }
+}
+}
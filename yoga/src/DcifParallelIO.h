@@ -0,0 +1,85 @@
+#pragma once
+#include <MessagePasser/MessagePasser.h>
+#include <parfait/LinearPartitioner.h>
+#include <string>
+#include <vector>
+#include "DcifDistributor.h"
+
+namespace YOGA {
+namespace Dcif {
+
+    // Byte offsets of the sections of a dcif file:
+    //   nnodes, nfringes, ndonors (int64), ngrids (int32)
+    //   fringe ids (int64), donor counts (int8), donor ids (int64), donor weights (double)
+    //   iblank (int8) in global node id order
+    //   start, stop (int64), imesh (int32) for each grid
+    class Layout {
+      public:
+        static constexpr long header_bytes = 3 * 8 + 4;
+        static constexpr long footer_bytes_per_grid = 8 + 8 + 4;
+
+        Layout(long nnodes, long nfringes, long ndonors) : nnodes(nnodes), nfringes(nfringes), ndonors(ndonors) {}
+        long fringeIds() const { return header_bytes; }
+        long donorCounts() const { return fringeIds() + 8 * nfringes; }
+        long donorIds() const { return donorCounts() + nfringes; }
+        long donorWeights() const { return donorIds() + 8 * ndonors; }
+        long iblank() const { return donorWeights() + 8 * ndonors; }
+        long footer() const { return iblank() + nnodes; }
+
+      private:
+        long nnodes;
+        long nfringes;
+        long ndonors;
+    };
+
+    // Where this rank's entries start in a section that every rank
+    // contributes to in rank order, and how many entries the section has.
+    struct Slice {
+        long offset;
+        long total;
+    };
+    Slice sliceInRankOrder(MessagePasser mp, long count);
+
+    // Collective.
+    MPI_File openForWriting(MessagePasser mp, const std::string& filename);
+    MPI_File openForReading(MessagePasser mp, const std::string& filename);
+
+    // Reads the slice of a dcif file each rank is responsible for, without
+    // any rank holding the whole file.  Receptors are split evenly in file
+    // order, and iblank is split evenly by global node id.  Ids are zero based.
+    class SliceReader {
+      public:
+        // Collective.
+        SliceReader(MessagePasser mp, const std::string& filename);
+
+        long globalNodeCount() const { return nnodes; }
+        long receptorCount() const { return nfringes; }
+        long donorCount() const { return ndonors; }
+        int gridCount() const { return ngrids; }
+        std::vector<long> gridNodeIdOffsets() const;
+        int imeshForComponentGrid(int grid) const { return grid_imesh[grid]; }
+
+        Parfait::LinearPartitioner::Range<long> nodeRange() const { return node_range; }
+        const std::vector<int8_t>& iblank() const { return iblank_slice; }
+        const std::vector<Receptor>& receptors() const { return receptor_slice; }
+
+      private:
+        long nnodes;
+        long nfringes;
+        long ndonors;
+        int ngrids;
+        bool should_swap_bytes = false;
+        std::vector<long> grid_start;
+        std::vector<long> grid_stop;
+        std::vector<int> grid_imesh;
+        Parfait::LinearPartitioner::Range<long> node_range;
+        std::vector<int8_t> iblank_slice;
+        std::vector<Receptor> receptor_slice;
+
+        void readHeader(MessagePasser mp, MPI_File f);
+        void readFooter(MessagePasser mp, MPI_File f);
+        void readReceptors(MessagePasser mp, MPI_File f);
+        void readIblank(MessagePasser mp, MPI_File f);
+    };
+}
+}
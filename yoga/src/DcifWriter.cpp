@@ -1,6 +1,8 @@
 #include <MessagePasser/MessagePasser.h>
 #include <parfait/ByteSwap.h>
+#include <parfait/LinearPartitioner.h>
 #include <cstdio>
+#include "DcifParallelIO.h"
 #include "DcifWriter.h"
 #include "YogaMesh.h"
 
@@ -57,10 +59,153 @@ DcifHeader getDcifHeader(MessagePasser mp, const YogaMesh& mesh, const DomainCon
             closeFileOnRoot(f);
         }
     }
+    void DcifWriter::exportDcifCollectively(std::string name,
+                                            const YogaMesh& mesh,
+                                            const DomainConnectivityInfo<double>& dci) {
+        long nnodes = mp.ParallelSum(YOGA::countOwnedNodes(mp, mesh));
+        int ncomponents = countComponentGridIds(mesh);
+
+        std::vector<long> fringe_ids(dci.receptorGids.begin(), dci.receptorGids.end());
+        convertToFortranIndexing(fringe_ids);
+        std::vector<int8_t> donor_counts;
+        std::vector<long> donor_ids;
+        std::vector<double> donor_weights;
+        for(size_t i=0;i<dci.donorGids.size();i++){
+            donor_counts.push_back(dci.donorGids[i].size());
+            donor_ids.insert(donor_ids.end(), dci.donorGids[i].begin(), dci.donorGids[i].end());
+            donor_weights.insert(donor_weights.end(), dci.weights[i].begin(), dci.weights[i].end());
+        }
+        convertToFortranIndexing(donor_ids);
+
+        auto fringes = Dcif::sliceInRankOrder(mp, fringe_ids.size());
+        auto donors = Dcif::sliceInRankOrder(mp, donor_ids.size());
+        Dcif::Layout layout(nnodes, fringes.total, donors.total);
+
+        auto iblank = redistributeIblankByGlobalId(mesh, dci, nnodes);
+        auto iblank_range = Parfait::LinearPartitioner::getRangeForWorker(mp.Rank(), nnodes, mp.NumberOfProcesses());
+        auto footer = buildFooter(mesh);
+
+        std::vector<char> header;
+        if(mp.Rank() == 0){
+            printf("=======================================\n");
+            printf("========= writing dcif file ===========\n");
+            printf("=======================================\n");
+            printf("nnodes       %li\n", nnodes);
+            printf("nfringes     %li\n", fringes.total);
+            printf("ndonors      %li\n", donors.total);
+            printf("ngrids       %i\n", ncomponents);
+            MessagePasser::Message msg;
+            msg.pack(nnodes);
+            msg.pack(fringes.total);
+            msg.pack(donors.total);
+            msg.pack(ncomponents);
+            header.assign(msg.data(), msg.data() + msg.size());
+        }
+
+        auto f = Dcif::openForWriting(mp, name);
+        mp.WriteAtAll(f, 0, header.data(), header.size());
+        mp.WriteAtAll(f, layout.fringeIds() + 8 * fringes.offset, fringe_ids.data(), 8 * fringe_ids.size());
+        mp.WriteAtAll(f, layout.donorCounts() + fringes.offset, donor_counts.data(), donor_counts.size());
+        mp.WriteAtAll(f, layout.donorIds() + 8 * donors.offset, donor_ids.data(), 8 * donor_ids.size());
+        mp.WriteAtAll(f, layout.donorWeights() + 8 * donors.offset, donor_weights.data(), 8 * donor_weights.size());
+        mp.WriteAtAll(f, layout.iblank() + iblank_range.start, iblank.data(), iblank.size());
+        mp.WriteAtAll(f, layout.footer(), footer.data(), footer.size());
+        MPI_File_close(&f);
+    }
+
+    std::vector<int8_t> DcifWriter::redistributeIblankByGlobalId(const YogaMesh& mesh,
+                                                                 const DomainConnectivityInfo<double>& dci,
+                                                                 long nnodes) {
+        int nranks = mp.NumberOfProcesses();
+        std::map<int, std::vector<long>> gids_for_ranks;
+        std::map<int, std::vector<int8_t>> iblank_for_ranks;
+        int owned = 0;
+        for(int i=0;i<mesh.nodeCount();++i){
+            if(mp.Rank() != mesh.nodeOwner(i)) continue;
+            long gid = mesh.globalNodeId(i);
+            int rank = int(Parfait::LinearPartitioner::getWorkerOfWorkItem(gid, nnodes, nranks));
+            gids_for_ranks[rank].push_back(gid);
+            iblank_for_ranks[rank].push_back(convertStatusToIblank(dci.nodeStatuses[owned++]));
+        }
+        gids_for_ranks = mp.Exchange(gids_for_ranks);
+        iblank_for_ranks = mp.Exchange(iblank_for_ranks);
+
+        auto range = Parfait::LinearPartitioner::getRangeForWorker(mp.Rank(), nnodes, nranks);
+        std::vector<int8_t> iblank(range.end - range.start, -9);
+        for(auto& pair:gids_for_ranks){
+            auto& statuses = iblank_for_ranks[pair.first];
+            for(size_t i=0;i<pair.second.size();++i)
+                iblank[pair.second[i] - range.start] = statuses[i];
+        }
+
+        long n_receptor = 0;
+        long n_in = 0;
+        long n_out = 0;
+        long n_orphan = 0;
+        for(auto s:iblank) {
+            if (-1 == s)
+                n_receptor++;
+            else if (-2 == s)
+                n_orphan++;
+            else if (0 == s)
+                n_out++;
+            else if (1 == s)
+                n_in++;
+            else
+                throw std::logic_error("Unrecognized status: " + std::to_string(s));
+        }
+        n_receptor = mp.ParallelSum(n_receptor, 0);
+        n_in = mp.ParallelSum(n_in, 0);
+        n_out = mp.ParallelSum(n_out, 0);
+        n_orphan = mp.ParallelSum(n_orphan, 0);
+        if(mp.Rank() == 0) {
+            printf("     # receptor: %li\n",n_receptor);
+            printf("     # in:       %li\n",n_in);
+            printf("     # out:      %li\n",n_out);
+            printf("     # orphan:   %li\n",n_orphan);
+            printf("      total:     %li\n",n_receptor+n_in+n_out+n_orphan);
+        }
+        return iblank;
+    }
+
+    std::vector<char> DcifWriter::buildFooter(const YogaMesh& mesh) {
+        int max_component_id = 0;
+        for(int i=0;i<mesh.nodeCount();++i)
+            max_component_id = std::max(max_component_id, mesh.getAssociatedComponentId(i));
+        max_component_id = mp.ParallelMax(max_component_id);
+        std::vector<long> owned_nodes_in_component(max_component_id + 1, 0);
+        for(int i=0;i<mesh.nodeCount();++i)
+            if(mp.Rank() == mesh.nodeOwner(i))
+                owned_nodes_in_component[mesh.getAssociatedComponentId(i)]++;
+        mp.ElementalSum(owned_nodes_in_component, 0);
+
+        std::vector<char> footer;
+        if(mp.Rank() != 0) return footer;
+        int last_component_id = 0;
+        for(int id=0;id<=max_component_id;id++)
+            if(owned_nodes_in_component[id] > 0) last_component_id = id;
+        MessagePasser::Message msg;
+        long offset = 0;
+        for(int id=0;id<=max_component_id;id++){
+            if(0 == owned_nodes_in_component[id]) continue;
+            long start = offset;
+            offset += owned_nodes_in_component[id];
+            long stop = offset;
+            // same convention as writeFooterInfo: the last grid is stationary
+            int imesh = id == last_component_id ? 0 : id + 1;
+            msg.pack(start);
+            msg.pack(stop);
+            msg.pack(imesh);
+        }
+        footer.assign(msg.data(), msg.data() + msg.size());
+        return footer;
+    }
+
     std::vector<std::vector<int>> DcifWriter::gatherComponentIds(const YogaMesh& mesh) {
         std::vector<int> localComponentIds;
         for(int i=0;i<mesh.nodeCount();++i)
-            localComponentIds.push_back(mesh.getAssociatedComponentId(i));
+            if(mp.Rank() == mesh.nodeOwner(i))
+                localComponentIds.push_back(mesh.getAssociatedComponentId(i));
         std::vector<std::vector<int>> globalComponentIds;
         mp.Gather(localComponentIds,globalComponentIds,0);
         return globalComponentIds;
@@ -11,6 +11,10 @@ namespace YOGA {
 
         void exportDcif(std::string name, YogaMesh& mesh, DomainConnectivityInfo<double>& dci);
 
+        // Writes the same file as exportDcif, but every rank writes its own
+        // part with collective MPI-IO, so nothing is gathered to the root.
+        void exportDcifCollectively(std::string name, const YogaMesh& mesh, const DomainConnectivityInfo<double>& dci);
+
         void openFileOnRoot(FILE *&f, std::string name);
         void closeFileOnRoot(FILE *&f);
 
@@ -36,6 +40,10 @@ namespace YOGA {
         int convertStatusToIblank(NodeStatus s);
 
         int countComponentGridIds(const YogaMesh& mesh);
+        std::vector<int8_t> redistributeIblankByGlobalId(const YogaMesh& mesh,
+                                                         const DomainConnectivityInfo<double>& dci,
+                                                         long nnodes);
+        std::vector<char> buildFooter(const YogaMesh& mesh);
         std::vector<std::vector<long>> gatherGlobalFringeIds(const DomainConnectivityInfo<double>& dci);
         std::vector<std::vector<int8_t>> gatherDonorCounts(DomainConnectivityInfo<double>& dci);
         std::vector<std::vector<long>> gatherDonorIds(DomainConnectivityInfo<double>& dci);
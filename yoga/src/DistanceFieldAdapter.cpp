@@ -1,19 +1,15 @@
 #include <Tracer.h>
 #include "DistanceFieldAdapter.h"
-#include "NanoFlannDistanceCalculator.h"
-#include "ParallelSurface.h"
+#include "DistributedWallDistance.h"
 
 namespace YOGA {
 
-std::vector<double> DistanceFieldAdapter::getNodeDistances(
-    const YogaMesh& m, const std::vector<std::vector<Parfait::Point<double>>>& surfaces) {
-    Tracer::begin("build nanoflann tree");
-    NanoFlannDistanceCalculator distance_calculator(surfaces);
-    Tracer::end("build nanoflann tree");
+std::vector<double> DistanceFieldAdapter::getNodeDistances(MessagePasser mp, const YogaMesh& m) {
+    DistributedWallDistance wall_distance(mp, m);
     Tracer::begin("get distances");
     auto query_points = extractQueryPoints(m);
     auto grid_ids_for_nodes = extractGridIds(m);
-    auto d2 = distance_calculator.calculateDistances(query_points, grid_ids_for_nodes);
+    auto d2 = wall_distance.calcDistances(query_points, grid_ids_for_nodes);
     Tracer::end("get distances");
     return d2;
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <MessagePasser/MessagePasser.h>
 #include <parfait/Point.h>
 #include <vector>
 #include "YogaMesh.h"
@@ -7,8 +8,7 @@ namespace YOGA {
 
 class DistanceFieldAdapter {
   public:
-    static std::vector<double> getNodeDistances(const YogaMesh& m,
-                                                const std::vector<std::vector<Parfait::Point<double>>>& surfaces);
+    static std::vector<double> getNodeDistances(MessagePasser mp, const YogaMesh& m);
 
   private:
     static std::vector<Parfait::Point<double>> extractQueryPoints(const YogaMesh& mesh);
@@ -0,0 +1,183 @@
+#include "DistributedWallDistance.h"
+#include <parfait/ExtentBuilder.h>
+#include <parfait/RecursiveBisection.h>
+#include <Tracer.h>
+#include <cmath>
+#include <limits>
+#include "BoundaryConditions.h"
+#include "ParallelSurface.h"
+
+namespace YOGA {
+
+DistributedWallDistance::DistributedWallDistance(MessagePasser mp, const YogaMesh& mesh)
+    : mp(mp), component_count(ParallelSurface::countComponents(mp, mesh)) {
+    Tracer::begin("distribute wall facets");
+    distributeFacets(extractLocalWallFacets(mesh));
+    Tracer::end("distribute wall facets");
+    Tracer::begin("build distance trees");
+    buildTrees();
+    shareRegionExtents();
+    Tracer::end("build distance trees");
+}
+
+double DistributedWallDistance::farAway() { return std::sqrt(std::numeric_limits<double>::max()); }
+
+std::vector<Parfait::Facet> DistributedWallDistance::extractLocalWallFacets(const YogaMesh& mesh) {
+    std::vector<Parfait::Facet> facets;
+    for (int i = 0; i < mesh.numberOfBoundaryFaces(); i++) {
+        if (Solid != mesh.getBoundaryCondition(i)) continue;
+        auto face = mesh.getNodesInBoundaryFace(i);
+        int component = mesh.getAssociatedComponentId(face.front());
+        for (size_t corner = 2; corner < face.size(); corner++) {
+            Parfait::Facet f(mesh.getNode<double>(face[0]),
+                             mesh.getNode<double>(face[corner - 1]),
+                             mesh.getNode<double>(face[corner]));
+            f.tag = component;
+            facets.push_back(f);
+        }
+    }
+    return facets;
+}
+
+void DistributedWallDistance::distributeFacets(std::vector<Parfait::Facet>&& local_facets) {
+    std::vector<Parfait::Point<double>> centroids;
+    for (auto& f : local_facets) centroids.push_back((f[0] + f[1] + f[2]) / 3.0);
+    auto owners = Parfait::recursiveBisection(mp, centroids, mp.NumberOfProcesses(), 1.0e-4);
+    auto facets_for_ranks = Parfait::queueToOwners(local_facets, owners);
+    local_facets = std::vector<Parfait::Facet>();
+
+    facets_in_components.assign(component_count, {});
+    for (auto& facets_from_rank : mp.Exchange(facets_for_ranks))
+        for (auto& f : facets_from_rank.second) facets_in_components[f.tag].emplace_back(f);
+}
+
+void DistributedWallDistance::buildTrees() {
+    trees.clear();
+    trees.resize(component_count);
+    for (int c = 0; c < component_count; c++) {
+        auto& facets = facets_in_components[c];
+        if (facets.empty()) continue;
+        auto domain = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
+        for (auto& f : facets) Parfait::ExtentBuilder::add(domain, f.getExtent());
+        trees[c] = std::make_unique<Parfait::DistanceTree>(domain);
+        trees[c]->setMaxDepth(10);
+        trees[c]->setMaxObjectsPerVoxel(20);
+        for (auto& f : facets) trees[c]->insert(&f);
+        trees[c]->finalize();
+    }
+}
+
+void DistributedWallDistance::shareRegionExtents() {
+    std::vector<Parfait::Extent<double>> my_regions(component_count,
+                                                    Parfait::ExtentBuilder::createEmptyBuildableExtent<double>());
+    for (int c = 0; c < component_count; c++)
+        for (auto& f : facets_in_components[c]) Parfait::ExtentBuilder::add(my_regions[c], f.getExtent());
+    region_extents = mp.Gather(my_regions);
+
+    regions_in_components.clear();
+    regions_in_components.resize(component_count);
+    initial_search_width.assign(component_count, 0.0);
+    for (int c = 0; c < component_count; c++) {
+        std::vector<int> ranks;
+        std::vector<Parfait::Extent<double>> extents;
+        auto domain = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
+        double total_width = 0.0;
+        for (int rank = 0; rank < mp.NumberOfProcesses(); rank++) {
+            auto& e = region_extents[rank][c];
+            if (e.lo[0] > e.hi[0]) continue;
+            ranks.push_back(rank);
+            extents.push_back(e);
+            Parfait::ExtentBuilder::add(domain, e);
+            total_width += e.getLength(e.longestDimension());
+        }
+        if (ranks.empty()) continue;
+        double domain_width = domain.getLength(domain.longestDimension());
+        initial_search_width[c] = std::max(0.5 * total_width / ranks.size(), 1.0e-8 * domain_width);
+        if (0.0 == initial_search_width[c]) initial_search_width[c] = 1.0e-8;
+        regions_in_components[c] = std::make_unique<Parfait::Adt3DExtent>(domain, ranks, extents);
+    }
+}
+
+double DistributedWallDistance::localDistance(const Parfait::Point<double>& p, int component) const {
+    if (nullptr == trees[component]) return farAway();
+    return (trees[component]->closestPoint(p) - p).magnitude();
+}
+
+double DistributedWallDistance::lowerBound(const Parfait::Point<double>& p, int rank, int component) const {
+    auto& e = region_extents[rank][component];
+    return (e.clamp(p) - p).magnitude();
+}
+
+int DistributedWallDistance::nearestRegion(const Parfait::Point<double>& p,
+                                           int component,
+                                           std::vector<int>& ranks) const {
+    auto& regions = regions_in_components[component];
+    if (nullptr == regions) return -1;
+    for (double h = initial_search_width[component]; h < farAway(); h *= 2.0) {
+        Parfait::Extent<double> box{p - Parfait::Point<double>{h, h, h}, p + Parfait::Point<double>{h, h, h}};
+        regions->retrieve(box, ranks);
+        if (ranks.empty()) continue;
+        int nearest = ranks.front();
+        for (int rank : ranks)
+            if (lowerBound(p, rank, component) < lowerBound(p, nearest, component)) nearest = rank;
+        return nearest;
+    }
+    return -1;
+}
+
+void DistributedWallDistance::refine(const std::map<int, std::vector<Query>>& queries_for_ranks,
+                                     const std::map<int, std::vector<int>>& query_ids_for_ranks,
+                                     std::vector<double>& distance) const {
+    std::map<int, std::vector<double>> answers_for_ranks;
+    for (auto& queries_from_rank : mp.Exchange(queries_for_ranks)) {
+        auto& answers = answers_for_ranks[queries_from_rank.first];
+        for (auto& q : queries_from_rank.second) answers.push_back(localDistance(q.p, q.component));
+    }
+    for (auto& answers_from_rank : mp.Exchange(answers_for_ranks)) {
+        auto& ids = query_ids_for_ranks.at(answers_from_rank.first);
+        auto& answers = answers_from_rank.second;
+        for (size_t i = 0; i < answers.size(); i++) distance[ids[i]] = std::min(distance[ids[i]], answers[i]);
+    }
+}
+
+std::vector<double> DistributedWallDistance::calcDistances(const std::vector<Parfait::Point<double>>& points,
+                                                           const std::vector<int>& components) const {
+    std::vector<double> distance(points.size(), farAway());
+    std::vector<int> first_rank(points.size(), -1);
+    std::vector<int> ranks;
+
+    Tracer::begin("nearest region");
+    std::map<int, std::vector<Query>> queries_for_ranks;
+    std::map<int, std::vector<int>> query_ids_for_ranks;
+    for (size_t i = 0; i < points.size(); i++) {
+        int rank = nearestRegion(points[i], components[i], ranks);
+        if (-1 == rank) continue;
+        first_rank[i] = rank;
+        queries_for_ranks[rank].push_back({points[i], components[i]});
+        query_ids_for_ranks[rank].push_back(int(i));
+    }
+    refine(queries_for_ranks, query_ids_for_ranks, distance);
+    Tracer::end("nearest region");
+
+    Tracer::begin("closer regions");
+    queries_for_ranks.clear();
+    query_ids_for_ranks.clear();
+    for (size_t i = 0; i < points.size(); i++) {
+        if (-1 == first_rank[i]) continue;
+        auto& p = points[i];
+        int c = components[i];
+        double d = distance[i];
+        regions_in_components[c]->retrieve({p - Parfait::Point<double>{d, d, d}, p + Parfait::Point<double>{d, d, d}},
+                                           ranks);
+        for (int rank : ranks) {
+            if (rank == first_rank[i] or lowerBound(p, rank, c) >= d) continue;
+            queries_for_ranks[rank].push_back({p, c});
+            query_ids_for_ranks[rank].push_back(int(i));
+        }
+    }
+    refine(queries_for_ranks, query_ids_for_ranks, distance);
+    Tracer::end("closer regions");
+    return distance;
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <MessagePasser/MessagePasser.h>
+#include <parfait/Adt3dExtent.h>
+#include <parfait/DistanceTree.h>
+#include <parfait/Extent.h>
+#include <parfait/Facet.h>
+#include <parfait/Point.h>
+#include <map>
+#include <memory>
+#include <vector>
+#include "YogaMesh.h"
+
+namespace YOGA {
+
+// Exact distance from points to the solid walls of their own component.
+//
+// Solid boundary faces are split into triangles, tagged with their component,
+// and redistributed by recursive bisection of their centroids so each rank
+// owns the facets of one spatial region.  Each rank builds a DistanceTree per
+// component for its region, and the region extents are shared with all ranks.
+//
+// A query is sent first to the rank whose region is nearest, and then only to
+// the ranks whose region is closer than the distance that rank found.
+class DistributedWallDistance {
+  public:
+    DistributedWallDistance(MessagePasser mp, const YogaMesh& mesh);
+    DistributedWallDistance(const DistributedWallDistance&) = delete;
+    DistributedWallDistance& operator=(const DistributedWallDistance&) = delete;
+
+    // Collective.  Points whose component has no walls get farAway().
+    std::vector<double> calcDistances(const std::vector<Parfait::Point<double>>& points,
+                                      const std::vector<int>& components) const;
+
+    int componentCount() const { return component_count; }
+    static double farAway();
+    static std::vector<Parfait::Facet> extractLocalWallFacets(const YogaMesh& mesh);
+
+  private:
+    struct Query {
+        Parfait::Point<double> p;
+        int component;
+    };
+
+    MessagePasser mp;
+    int component_count;
+    std::vector<std::vector<Parfait::FacetSegment>> facets_in_components;
+    std::vector<std::unique_ptr<Parfait::DistanceTree>> trees;
+    std::vector<std::vector<Parfait::Extent<double>>> region_extents;
+    std::vector<std::unique_ptr<Parfait::Adt3DExtent>> regions_in_components;
+    std::vector<double> initial_search_width;
+
+    void distributeFacets(std::vector<Parfait::Facet>&& local_facets);
+    void buildTrees();
+    void shareRegionExtents();
+    double localDistance(const Parfait::Point<double>& p, int component) const;
+    double lowerBound(const Parfait::Point<double>& p, int rank, int component) const;
+    int nearestRegion(const Parfait::Point<double>& p, int component, std::vector<int>& ranks) const;
+    void refine(const std::map<int, std::vector<Query>>& queries_for_ranks,
+                const std::map<int, std::vector<int>>& query_ids_for_ranks,
+                std::vector<double>& distance) const;
+};
+
+}
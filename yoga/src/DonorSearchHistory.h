@@ -0,0 +1,119 @@
+#pragma once
+#include <parfait/Extent.h>
+#include <parfait/ExtentBuilder.h>
+#include <map>
+#include <set>
+#include <vector>
+#include "BodyFrameSearchStructures.h"
+#include "DonorWarmStart.h"
+#include "MeshSystemInfo.h"
+#include "Receptor.h"
+#include "YogaMesh.h"
+
+namespace YOGA {
+
+// Remembers the candidate donors found during the previous assembly so that,
+// after rigid motion of some components, only query points whose donors could
+// have changed need to be searched again.
+//
+// A query point must be re-searched if its own component moved, or if it lies
+// in the region swept by a moved component (the union of that component's
+// extent before and after the motion).  Every other point keeps the candidate
+// donors it had last time.  Type assignment always runs from scratch, so stale
+// validity/status information is never carried over.
+//
+// When enabled, the wall-distance trees and hole maps are also kept across
+// assemblies in the body frames of the components (see
+// BodyFrameSearchStructures), so rigid motion never forces them to be rebuilt.
+class DonorSearchHistory {
+  public:
+    explicit DonorSearchHistory(bool should_record = true) : is_recording(should_record) {}
+
+    void markComponentMoved(int component) { moved_components.insert(component); }
+
+    void markComponentMoved(int component, const Parfait::MotionMatrix& motion) {
+        markComponentMoved(component);
+        body_frames.addMotion(component, motion);
+    }
+
+    void enableWarmStart(bool enable) { warm_start.setEnabled(enable and is_recording); }
+
+    DonorWarmStart* warmStart() { return warm_start.isEnabled() ? &warm_start : nullptr; }
+
+    void enableBodyFrameSearchStructures(bool enable) { body_frames.setEnabled(enable and is_recording); }
+
+    BodyFrameSearchStructures* bodyFrames() { return body_frames.isEnabled() ? &body_frames : nullptr; }
+    const BodyFrameSearchStructures* bodyFrames() const {
+        return body_frames.isEnabled() ? &body_frames : nullptr;
+    }
+
+    bool hasPreviousAssembly() const { return has_previous_assembly; }
+
+    bool canReuseAllDonors() const { return has_previous_assembly and moved_components.empty(); }
+
+    void beginAssembly(const MeshSystemInfo& mesh_system_info) {
+        swept_extents.clear();
+        if (not has_previous_assembly) return;
+        for (int component : moved_components) {
+            auto e = mesh_system_info.getComponentExtent(component);
+            if (component < int(previous_component_extents.size()))
+                Parfait::ExtentBuilder::add(e, previous_component_extents[component]);
+            swept_extents.push_back(e);
+        }
+    }
+
+    bool requiresSearch(const Parfait::Point<double>& p, int component) const {
+        if (not has_previous_assembly) return true;
+        if (moved_components.count(component) == 1) return true;
+        for (auto& e : swept_extents)
+            if (e.intersects(p)) return true;
+        return false;
+    }
+
+    std::vector<Receptor> reusableReceptors(const YogaMesh& mesh, int rank) const {
+        std::vector<Receptor> reused;
+        if (not has_previous_assembly) return reused;
+        for (int i = 0; i < mesh.nodeCount(); i++) {
+            if (mesh.nodeOwner(i) != rank) continue;
+            auto p = mesh.getNode<double>(i);
+            if (requiresSearch(p, mesh.getAssociatedComponentId(i))) continue;
+            auto it = previous_receptors.find(mesh.globalNodeId(i));
+            if (it != previous_receptors.end()) reused.push_back(it->second);
+        }
+        return reused;
+    }
+
+    void store(const std::vector<Receptor>& receptors, const MeshSystemInfo& mesh_system_info) {
+        if (not is_recording) return;
+        previous_receptors.clear();
+        for (auto& r : receptors) previous_receptors[r.globalId] = r;
+        previous_component_extents.clear();
+        for (int i = 0; i < mesh_system_info.numberOfComponents(); i++)
+            previous_component_extents.push_back(mesh_system_info.getComponentExtent(i));
+        moved_components.clear();
+        swept_extents.clear();
+        has_previous_assembly = true;
+    }
+
+    void clear() {
+        previous_receptors.clear();
+        previous_component_extents.clear();
+        moved_components.clear();
+        swept_extents.clear();
+        warm_start.clear();
+        body_frames.clear();
+        has_previous_assembly = false;
+    }
+
+  private:
+    bool is_recording;
+    bool has_previous_assembly = false;
+    std::set<int> moved_components;
+    std::vector<Parfait::Extent<double>> swept_extents;
+    std::vector<Parfait::Extent<double>> previous_component_extents;
+    std::map<long, Receptor> previous_receptors;
+    DonorWarmStart warm_start;
+    BodyFrameSearchStructures body_frames;
+};
+
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <parfait/ThreadRanges.h>
+
+namespace YOGA {
+
+// The threaded donor search splits its query points with
+// Parfait::forEachThreadRange.  Configuring yoga with YOGA_DONOR_SEARCH_OPENMP
+// switches its backend to OpenMP.
+using Parfait::forEachThreadRange;
+
+}
@@ -0,0 +1,71 @@
+#include "DonorValidityPlan.h"
+#include <set>
+
+namespace YOGA {
+
+DonorValidityPlan::DonorValidityPlan(MessagePasser world, const std::vector<Receptor>& receptors)
+    : mp(world.split(world.getCommunicator(), 0)) {
+    std::map<int, std::vector<int>> cells_for_ranks;
+    for (size_t i = 0; i < receptors.size(); i++) {
+        auto& donors = receptors[i].candidateDonors;
+        for (size_t j = 0; j < donors.size(); j++) {
+            int owner = donors[j].cellOwner;
+            cells_for_ranks[owner].push_back(donors[j].cellId);
+            donors_held_by_ranks[owner].push_back({int(i), int(j)});
+        }
+    }
+    cells_to_check_for_ranks = mp.Exchange(cells_for_ranks);
+}
+
+DonorValidityPlan::~DonorValidityPlan() { mp.destroyComm(); }
+
+int DonorValidityPlan::neighborCount() const {
+    std::set<int> neighbors;
+    for (auto& pair : cells_to_check_for_ranks)
+        if (not pair.second.empty()) neighbors.insert(pair.first);
+    for (auto& pair : donors_held_by_ranks) neighbors.insert(pair.first);
+    return int(neighbors.size());
+}
+
+std::vector<unsigned char> DonorValidityPlan::packBits(const std::vector<bool>& bits) {
+    std::vector<unsigned char> bytes((bits.size() + 7) / 8, 0);
+    for (size_t i = 0; i < bits.size(); i++)
+        if (bits[i]) bytes[i / 8] |= (unsigned char)(1u << (i % 8));
+    return bytes;
+}
+
+bool DonorValidityPlan::unpackBit(const std::vector<unsigned char>& bytes, size_t i) {
+    return 0 != (bytes[i / 8] & (1u << (i % 8)));
+}
+
+void DonorValidityPlan::update(std::vector<Receptor>& receptors, const CellCheck& is_valid_donor) const {
+    std::map<int, std::vector<unsigned char>> replies;
+    std::vector<MessagePasser::MessageStatus> receives;
+    for (auto& pair : donors_held_by_ranks) {
+        int length = int((pair.second.size() + 7) / 8);
+        receives.push_back(mp.NonBlockingRecv(replies[pair.first], length, pair.first));
+    }
+
+    std::map<int, std::vector<unsigned char>> answers;
+    std::vector<MessagePasser::MessageStatus> sends;
+    for (auto& pair : cells_to_check_for_ranks) {
+        if (pair.second.empty()) continue;
+        std::vector<bool> valid(pair.second.size());
+        for (size_t i = 0; i < valid.size(); i++) valid[i] = is_valid_donor(pair.second[i]);
+        auto& bytes = answers[pair.first];
+        bytes = packBits(valid);
+        sends.push_back(mp.NonBlockingSend(bytes, pair.first));
+    }
+
+    for (auto& status : receives) status.wait();
+    for (auto& pair : replies) {
+        auto& slots = donors_held_by_ranks.at(pair.first);
+        for (size_t i = 0; i < slots.size(); i++) {
+            auto& donor = receptors[slots[i].receptor_index].candidateDonors[slots[i].donor_index];
+            donor.isValid = unpackBit(pair.second, i) ? 1 : 0;
+        }
+    }
+    for (auto& status : sends) status.wait();
+}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <MessagePasser/MessagePasser.h>
+#include <functional>
+#include <map>
+#include <vector>
+#include "Receptor.h"
+
+namespace YOGA {
+
+// Refreshes CandidateDonor::isValid for a fixed set of receptors.
+//
+// Type assignment re-checks the same donors several times as node statuses
+// change.  The plan is built with one exchange: each rank learns which of its
+// cells are donors for which ranks.  After that an update only sends one bit
+// per donor, point to point, from the rank holding the donor cell to the rank
+// holding the receptor; ranks that share no donors never talk.
+//
+// The receptors must not be added, removed, or reordered while the plan is used.
+class DonorValidityPlan {
+  public:
+    using CellCheck = std::function<bool(int cell_id)>;
+
+    // Collective.
+    DonorValidityPlan(MessagePasser mp, const std::vector<Receptor>& receptors);
+    ~DonorValidityPlan();
+    DonorValidityPlan(const DonorValidityPlan&) = delete;
+    DonorValidityPlan& operator=(const DonorValidityPlan&) = delete;
+
+    // Collective.  is_valid_donor is called on the rank that owns each donor cell.
+    void update(std::vector<Receptor>& receptors, const CellCheck& is_valid_donor) const;
+
+    int neighborCount() const;
+
+    static std::vector<unsigned char> packBits(const std::vector<bool>& bits);
+    static bool unpackBit(const std::vector<unsigned char>& bytes, size_t i);
+
+  private:
+    struct DonorSlot {
+        int receptor_index;
+        int donor_index;
+    };
+
+    MessagePasser mp;
+    std::map<int, std::vector<int>> cells_to_check_for_ranks;
+    std::map<int, std::vector<DonorSlot>> donors_held_by_ranks;
+};
+
+}
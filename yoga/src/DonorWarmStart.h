@@ -0,0 +1,45 @@
+#pragma once
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace YOGA {
+
+// Rank-local record of the donor cells found for each query point during the
+// previous donor search.  Cells are identified the same way as in
+// CandidateDonor: (owning rank, cell id on that rank), which is stable across
+// time steps as long as the mesh topology does not change.  The donor finder
+// uses these as starting points for a short neighbor walk before falling back
+// to a full ADT traversal.
+class DonorWarmStart {
+  public:
+    using DonorCell = std::pair<int, int>;
+
+    void setEnabled(bool enable) {
+        is_enabled = enable;
+        if (not is_enabled) previous_donors.clear();
+    }
+    bool isEnabled() const { return is_enabled; }
+
+    const std::vector<DonorCell>& previousDonors(long global_id) const {
+        auto it = previous_donors.find(global_id);
+        if (it == previous_donors.end()) return none;
+        return it->second;
+    }
+
+    void update(long global_id, std::vector<DonorCell>&& donors) {
+        if (donors.empty())
+            previous_donors.erase(global_id);
+        else
+            previous_donors[global_id] = std::move(donors);
+    }
+
+    void clear() { previous_donors.clear(); }
+
+  private:
+    bool is_enabled = false;
+    std::unordered_map<long, std::vector<DonorCell>> previous_donors;
+    const std::vector<DonorCell> none;
+};
+
+}
@@ -18,6 +18,7 @@ void visualizeHoleMaps(MessagePasser mp,const std::vector<ScalableHoleMap>& hole
         MessagePasser root_only(MPI_COMM_SELF);
         int i = 0;
         for (auto hm : hole_maps) {
+            if (hm.is_distributed) continue;
             int nx = hm.block.numberOfCells_X();
             int ny = hm.block.numberOfCells_Y();
             int nz = hm.block.numberOfCells_Z();
@@ -33,7 +34,7 @@ void visualizeHoleMaps(MessagePasser mp,const std::vector<ScalableHoleMap>& hole
 
 DruyorTypeAssignment::DruyorTypeAssignment(const YogaMesh& mesh,
                                            std::vector<Receptor>& receptors,
-                                           const std::map<long, int>& g2l,
+                                           const IdMap& g2l,
                                            Parfait::SyncPattern& syncPattern,
                                            const PartitionInfo& partitionInfo,
                                            const MeshSystemInfo& mesh_system_info,
@@ -50,11 +51,12 @@ DruyorTypeAssignment::DruyorTypeAssignment(const YogaMesh& mesh,
       partition_info(partitionInfo),
       mesh_system_info(mesh_system_info),
       mp(mp),
-      node_to_node(Connectivity::nodeToNode(mesh))
+      node_to_node(Connectivity::nodeToNodeCompressed(mesh)),
+      defer_status_counts(YogaConfiguration(mp).shouldDeferStatusCounts())
 {
     //visualizeHoleMaps(mp,hole_maps);
     auto candidate_hole_points = getIdsOfHoleNodes(mesh,hole_maps);
-    std::map<long,int> global_to_receptor_index;
+    IdMap global_to_receptor_index;
     for(int i=0;i<long(receptors.size());i++){
         auto& r = receptors[i];
         global_to_receptor_index[r.globalId] = i;
@@ -107,7 +109,7 @@ void DruyorTypeAssignment::turnOutIntoReceptorIfValidDonorsExist(std::vector<Sta
 
 std::vector<StatusKeeper> DruyorTypeAssignment::getNodeStatuses(const YogaMesh& mesh,
                                                               std::vector<Receptor>& receptors,
-                                                              const std::map<long, int>& g2l,
+                                                              const IdMap& g2l,
                                                               Parfait::SyncPattern& syncPattern,
                                                               const PartitionInfo& partitionInfo,
                                                               const MeshSystemInfo& system_info,
@@ -176,14 +178,14 @@ void DruyorTypeAssignment::convertRemainingCandidates(std::vector<StatusKeeper>&
         }
     }
     for(int id=0;id<mesh.nodeCount();id++){
-        auto& nbrs = node_to_node[id];
+        auto nbrs = node_to_node[id];
         if(distance_to_out[id] == far and doSelectedNodesContain(nbrs,NodeStatus::OutNode,statuses)){
             distance_to_out[id] = adjacent;
         }
     }
     syncVector(mp, distance_to_out, globalToLocal, sync_pattern);
     for(int id=0;id<mesh.nodeCount();id++){
-        auto& nbrs = node_to_node[id];
+        auto nbrs = node_to_node[id];
         bool has_adj_nbr = false;
         for(int nbr:nbrs){
             if(distance_to_out[nbr] == adjacent) has_adj_nbr = true;
@@ -199,7 +201,7 @@ void DruyorTypeAssignment::convertRemainingCandidates(std::vector<StatusKeeper>&
         for (int id = 0; id < mesh.nodeCount(); id++) {
             auto& s = statuses[id];
             if (ReceptorCandidate == s.value()) {
-                auto& nbrs = node_to_node[id];
+                auto nbrs = node_to_node[id];
                 if (doSelectedNodesContain(nbrs, NodeStatus::InNode, statuses) and distance_to_out[id] == far) {
                     s.transition(InNode);
                     n_changed++;
@@ -248,27 +250,92 @@ std::vector<int> DruyorTypeAssignment::getReceptorIndices() const {
     return receptor_indices;
 }
 
-void DruyorTypeAssignment::updateCounts(const std::vector<StatusKeeper>& node_statuses,
-    DruyorTypeAssignment::StatusCounts& counts,
-    const std::vector<bool>& is_mine) {
+namespace {
+std::vector<long> flatten(const DruyorTypeAssignment::StatusCounts& counts) {
+    return {counts.in, counts.out, counts.candidate, counts.receptor, counts.orphan, counts.mandatory_receptor,
+            counts.unknown};
+}
+DruyorTypeAssignment::StatusCounts unflatten(const long* v) {
+    DruyorTypeAssignment::StatusCounts counts;
+    counts.in = v[0];
+    counts.out = v[1];
+    counts.candidate = v[2];
+    counts.receptor = v[3];
+    counts.orphan = v[4];
+    counts.mandatory_receptor = v[5];
+    counts.unknown = v[6];
+    return counts;
+}
+const int status_count_fields = 7;
+}
+
+DruyorTypeAssignment::StatusCounts DruyorTypeAssignment::tallyStatuses(const std::vector<StatusKeeper>& node_statuses,
+                                                                       const std::vector<bool>& is_mine) {
+    StatusCounts counts;
+    for (size_t i = 0; i < node_statuses.size(); i++) {
+        if (not is_mine[i]) continue;
+        switch (node_statuses[i].value()) {
+            case InNode: counts.in++; break;
+            case OutNode: counts.out++; break;
+            case FringeNode: counts.receptor++; break;
+            case Orphan: counts.orphan++; break;
+            case Unknown: counts.unknown++; break;
+            case ReceptorCandidate: counts.candidate++; break;
+            case MandatoryReceptor: counts.mandatory_receptor++; break;
+        }
+    }
+    return counts;
+}
+
+void DruyorTypeAssignment::recordCounts(const std::string& phase,
+                                        const std::vector<StatusKeeper>& node_statuses,
+                                        const std::vector<bool>& is_mine) {
     Tracer::begin("update counts");
-    counts.candidate = countStatus(node_statuses, ReceptorCandidate,is_mine);
-    counts.out = countStatus(node_statuses, OutNode,is_mine);
-    counts.in = countStatus(node_statuses, InNode,is_mine);
-    counts.unknown = countStatus(node_statuses, Unknown,is_mine);
-    counts.receptor = countStatus(node_statuses, FringeNode,is_mine);
-    counts.orphan = countStatus(node_statuses, Orphan,is_mine);
-    counts.mandatory_receptor = countStatus(node_statuses,MandatoryReceptor,is_mine);
-
-    counts.candidate = mp.ParallelSum(counts.candidate);
-    counts.out = mp.ParallelSum(counts.out);
-    counts.in = mp.ParallelSum(counts.in);
-    counts.unknown = mp.ParallelSum(counts.unknown);
-    counts.orphan = mp.ParallelSum(counts.orphan);
-    counts.receptor = mp.ParallelSum(counts.receptor);
-    counts.mandatory_receptor = mp.ParallelSum(counts.mandatory_receptor);
+    auto counts = tallyStatuses(node_statuses, is_mine);
+    Tracer::counter(phase,
+                    {{"in", counts.in},
+                     {"out", counts.out},
+                     {"receptor", counts.receptor},
+                     {"orphan", counts.orphan},
+                     {"cand", counts.candidate},
+                     {"unk", counts.unknown},
+                     {"mand", counts.mandatory_receptor}});
+    if (defer_status_counts) {
+        deferred_counts.push_back({phase, counts});
+    } else {
+        auto v = flatten(counts);
+        mp.ElementalSum(v, 0);
+        printCounts(phase, unflatten(v.data()));
+    }
     Tracer::end("update counts");
 }
+
+void DruyorTypeAssignment::startDeferredCountReduction() {
+    if (not defer_status_counts) return;
+    deferred_local_counts.clear();
+    for (auto& phase : deferred_counts) {
+        auto v = flatten(phase.second);
+        deferred_local_counts.insert(deferred_local_counts.end(), v.begin(), v.end());
+    }
+    deferred_global_counts.resize(deferred_local_counts.size());
+    MPI_Ireduce(deferred_local_counts.data(),
+                deferred_global_counts.data(),
+                int(deferred_local_counts.size()),
+                MPI_LONG,
+                MPI_SUM,
+                0,
+                mp.getCommunicator(),
+                &deferred_count_request);
+}
+
+void DruyorTypeAssignment::finishDeferredCountReduction() {
+    if (not defer_status_counts) return;
+    MPI_Wait(&deferred_count_request, MPI_STATUS_IGNORE);
+    for (size_t i = 0; i < deferred_counts.size(); i++)
+        printCounts(deferred_counts[i].first, unflatten(&deferred_global_counts[i * status_count_fields]));
+    deferred_counts.clear();
+}
+
 void DruyorTypeAssignment::printCounts(const std::string& msg,const DruyorTypeAssignment::StatusCounts& counts) const {
     if (mp.Rank() == 0) {
         printf("%s\n",msg.c_str());
@@ -360,7 +427,7 @@ void DruyorTypeAssignment::markDefiniteInPoints(std::vector<StatusKeeper>& node_
     for (size_t i = 0; i < node_statuses.size(); i++) {
         if (not is_node_mine[i]) continue;
         if (node_statuses[i].value() == MandatoryReceptor) continue;
-        const auto& nbrs = node_to_node[i];
+        const auto nbrs = node_to_node[i];
         if (doSelectedNodesContain(nbrs, OutNode, node_statuses)){
             continue;
         }
@@ -391,7 +458,7 @@ void DruyorTypeAssignment::markNodesClosestToTheirGeometry(std::vector<StatusKee
         if (not is_node_mine[localId]) continue;
         double nodeDistance = r.distance;
         if (node_statuses[localId].value() == MandatoryReceptor) continue;
-        auto& nbrs = node_to_node[localId];
+        auto nbrs = node_to_node[localId];
         if (doSelectedNodesContain(nbrs, OutNode, node_statuses)) continue;
         if (getMinDonorDistance(localId, r.candidateDonors) > nodeDistance) {
             node_statuses[localId].transition(InNode);
@@ -424,14 +491,25 @@ void DruyorTypeAssignment::markCandidateReceptors(std::vector<StatusKeeper>& nod
     syncStatuses(node_statuses);
 }
 
-bool DruyorTypeAssignment::doSelectedNodesContain(const std::vector<int>& selected_nodes,
-                                                  const NodeStatus s,
-                                                  const std::vector<StatusKeeper>& node_statuses) const {
+template <typename Nodes>
+bool doNodesContain(const Nodes& selected_nodes, const NodeStatus s, const std::vector<StatusKeeper>& node_statuses) {
     for (int id : selected_nodes)
         if (s == node_statuses[id].value()) return true;
     return false;
 }
 
+bool DruyorTypeAssignment::doSelectedNodesContain(const std::vector<int>& selected_nodes,
+                                                  const NodeStatus s,
+                                                  const std::vector<StatusKeeper>& node_statuses) const {
+    return doNodesContain(selected_nodes, s, node_statuses);
+}
+
+bool DruyorTypeAssignment::doSelectedNodesContain(Parfait::CompressedRowGraph::Row selected_nodes,
+                                                  const NodeStatus s,
+                                                  const std::vector<StatusKeeper>& node_statuses) const {
+    return doNodesContain(selected_nodes, s, node_statuses);
+}
+
 void DruyorTypeAssignment::convertCandidatesToReceptorsIfHaveValidDonor(std::vector<StatusKeeper>& statuses, const std::vector<bool>& is_node_mine) {
     for (auto& r : receptors) {
         int node_id = globalToLocal.at(r.globalId);
@@ -451,80 +529,14 @@ bool DruyorTypeAssignment::hasValidDonor(const Receptor& r) {
     return false;
 }
 
-void DruyorTypeAssignment::updateDonorValidity(const YogaMesh& mesh,
-                                               std::vector<Receptor>& receptors,
-                                               std::vector<StatusKeeper>& node_statuses,
-                                               const std::map<long, int>& g2l
-                                               ) {
-    std::vector<std::vector<int>> cell_ids_to_check(mp.NumberOfProcesses());
-    std::vector<std::vector<int>> receptor_indices(mp.NumberOfProcesses());
-    std::vector<std::vector<Parfait::Point<double>>> receptor_xyz(mp.NumberOfProcesses());
-    std::vector<std::vector<int>> donor_indices(mp.NumberOfProcesses());
-    for (size_t i=0;i<receptors.size();i++) {
-        auto& r = receptors[i];
-        for(size_t j=0;j<r.candidateDonors.size();j++){
-            auto& d = r.candidateDonors[j];
-            int target_rank = d.cellOwner;
-            cell_ids_to_check[target_rank].push_back(d.cellId);
-            receptor_indices[target_rank].push_back(i);
-            receptor_xyz[target_rank].push_back(mesh.getNode<double>(g2l.at(r.globalId)));
-            donor_indices[target_rank].push_back(j);
-        }
-    }
-
-    auto cell_ids_to_check_from_ranks = mp.Exchange(cell_ids_to_check);
-    auto xyzs_to_check_from_ranks = mp.Exchange(receptor_xyz);
-
-    auto donor_validity = verifyDonorValidityLocally(cell_ids_to_check_from_ranks,node_statuses);
-    applyDonorValidityUpdate(donor_validity, cell_ids_to_check, receptor_indices, donor_indices);
-}
-
-void DruyorTypeAssignment::applyDonorValidityUpdate(const std::vector<std::vector<int>>& donor_validity,
-                                                    const std::vector<std::vector<int>>& cell_ids_to_check,
-                                                    const std::vector<std::vector<int>>& receptor_indices,
-                                                    const std::vector<std::vector<int>>& donor_indices){
-    auto reply = mp.Exchange(donor_validity);
-    for (int rank = 0; rank < mp.NumberOfProcesses(); rank++) {
-        for (size_t i = 0; i < cell_ids_to_check[rank].size(); i++) {
-            int receptor_index = receptor_indices[rank][i];
-            int donor_index = donor_indices[rank][i];
-            if (0 == reply[rank][i]) {
-                receptors[receptor_index].candidateDonors[donor_index].isValid = false;
-            } else {
-                receptors[receptor_index].candidateDonors[donor_index].isValid = true;
-            }
-        }
-    }
-}
-
-std::vector<std::vector<int>> DruyorTypeAssignment::verifyDonorValidityLocally(const std::vector<std::vector<int>>& cell_ids_to_check_from_ranks,
-    const std::vector<StatusKeeper>& node_statuses){
-
-    std::vector<std::vector<int>> donor_validity(mp.NumberOfProcesses());
-    for (int rank = 0; rank < mp.NumberOfProcesses(); rank++) {
-        std::vector<int> cell;
-        auto& cell_ids = cell_ids_to_check_from_ranks[rank];
-        for (int cell_id : cell_ids) {
-            cell.resize(mesh.numberOfNodesInCell(cell_id));
-            mesh.getNodesInCell(cell_id, cell.data());
-            if (has_at_least_one_valid_node(node_statuses, cell)) {
-                donor_validity[rank].push_back(1);
-            }
-            else {
-                donor_validity[rank].push_back(0);
-            }
-        }
-    }
-
-    return donor_validity;
-}
-
-int DruyorTypeAssignment::countStatus(const std::vector<StatusKeeper>& statuses, const NodeStatus s,
-    const std::vector<bool>& is_mine) {
-    int n = 0;
-    for (size_t i=0;i<statuses.size();i++)
-        if (s == statuses[i].value() and is_mine[i]) n++;
-    return n;
+void DruyorTypeAssignment::updateDonorValidity(const std::vector<StatusKeeper>& node_statuses) {
+    if (nullptr == donor_validity_plan) donor_validity_plan = std::make_unique<DonorValidityPlan>(mp, receptors);
+    std::vector<int> cell;
+    donor_validity_plan->update(receptors, [&](int cell_id) {
+        cell.resize(mesh.numberOfNodesInCell(cell_id));
+        mesh.getNodesInCell(cell_id, cell.data());
+        return has_at_least_one_valid_node(node_statuses, cell);
+    });
 }
 
 double DruyorTypeAssignment::getMinDonorDistance(int local_node_id,const std::vector<CandidateDonor>& candidates) {
@@ -686,9 +698,7 @@ std::vector<StatusKeeper> DruyorTypeAssignment::determineNodeStatuses2() {
 
     auto is_mine = getIsNodeMine();
     std::vector<StatusKeeper> statuses(mesh.nodeCount());
-    StatusCounts counts;
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Initialize statuses",counts);
+    recordCounts("Initialize statuses", statuses, is_mine);
 
     //auto tinf_mesh = std::make_shared<YogaToTInfinityAdapter>(mesh,globalToLocal,mp);
     //auto selector = std::make_shared<CompositeSelector>();
@@ -705,8 +715,7 @@ std::vector<StatusKeeper> DruyorTypeAssignment::determineNodeStatuses2() {
 
     auto receptor_indices = getReceptorIndices();
     markMandatoryReceptors(statuses, is_mine, mesh);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Mark mandatory receptors",counts);
+    recordCounts("Mark mandatory receptors", statuses, is_mine);
 
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_1.vtk",mp,component_0_mesh,{filtered_status});
@@ -714,14 +723,12 @@ std::vector<StatusKeeper> DruyorTypeAssignment::determineNodeStatuses2() {
     for(int i=0;i<extra_layers_for_bcs;i++) {
         markNeighborsOfMandatoryReceptors(statuses,is_mine);
     }
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Add receptor layers",counts);
+    recordCounts("Add receptor layers", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_2.vtk",mp,component_0_mesh,{filtered_status});
 
     markHolePointsOut(statuses, is_mine, hole_nodes);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Mark hole points",counts);
+    recordCounts("Mark hole points", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_3.vtk",mp,component_0_mesh,{filtered_status});
 
@@ -730,79 +737,70 @@ std::vector<StatusKeeper> DruyorTypeAssignment::determineNodeStatuses2() {
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_4.vtk",mp,component_0_mesh,{filtered_status});
 
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Improve multi-overlap regions",counts);
+    recordCounts("Improve multi-overlap regions", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_5.vtk",mp,component_0_mesh,{filtered_status});
 
 
 
     markNodesOfStraddlingCellsIn(statuses, is_mine);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Mark nodes in straddling cells",counts);
+    recordCounts("Mark nodes in straddling cells", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_6.vtk",mp,component_0_mesh,{filtered_status});
 
     markSurfaceNodesIn(statuses, is_mine);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Mark surface nodes",counts);
+    recordCounts("Mark surface nodes", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_7.vtk",mp,component_0_mesh,{filtered_status});
 
     markNodesClosestToTheirGeometry(statuses, is_mine,partition_info);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Apply distance criteria",counts);
+    recordCounts("Apply distance criteria", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_8.vtk",mp,component_0_mesh,{filtered_status});
 
     markDefiniteInPoints(statuses, is_mine);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Mark definite in points",counts);
-    updateDonorValidity(mesh,receptors,statuses,globalToLocal);
+    recordCounts("Mark definite in points", statuses, is_mine);
+    updateDonorValidity(statuses);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_9.vtk",mp,component_0_mesh,{filtered_status});
 
     markCandidateReceptors(statuses, is_mine);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Mark Candidate receptors",counts);
+    recordCounts("Mark Candidate receptors", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_10.vtk",mp,component_0_mesh,{filtered_status});
 
 
-    updateDonorValidity(mesh,receptors,statuses,globalToLocal);
+    updateDonorValidity(statuses);
     convertCandidatesToReceptorsIfHaveValidDonor(statuses,is_mine);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Convert candidates",counts);
+    recordCounts("Convert candidates", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_11.vtk",mp,component_0_mesh,{filtered_status});
 
-    updateDonorValidity(mesh,receptors,statuses,globalToLocal);
+    updateDonorValidity(statuses);
     convertMandatoryReceptorsToOutIfDonorHasBetterDistance(statuses,receptor_indices,is_mine);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Discard mandatory receptors based on distance criteria",counts);
+    recordCounts("Discard mandatory receptors based on distance criteria", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_12.vtk",mp,component_0_mesh,{filtered_status});
 
     convertMandatoryReceptors(statuses,receptor_indices,is_mine);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Convert mandatory receptors",counts);
+    recordCounts("Convert mandatory receptors", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_13.vtk",mp,component_0_mesh,{filtered_status});
 
     convertUnknownToOut(statuses);
     convertRemainingCandidates(statuses);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Convert remaining",counts);
+    recordCounts("Convert remaining", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_14.vtk",mp,component_0_mesh,{filtered_status});
 
     filterOrphansThatAreOutsideComputationalDomain(statuses);
-    updateCounts(statuses,counts,is_mine);
-    printCounts("Filter orphans outside computational domain",counts);
+    recordCounts("Filter orphans outside computational domain", statuses, is_mine);
     //filtered_status = getFilteredStatusField(statuses,filter);
     //shortcut::visualize("step_15.vtk",mp,component_0_mesh,{filtered_status});
     
+    startDeferredCountReduction();
     performSanityChecks(statuses);
+    finishDeferredCountReduction();
 
     return statuses;
 }
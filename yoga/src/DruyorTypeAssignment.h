@@ -2,8 +2,11 @@
 #pragma once
 
 #include <parfait/SyncPattern.h>
+#include <memory>
 #include "Connectivity.h"
 #include "DonorCollector.h"
+#include "DonorValidityPlan.h"
+#include "IdMap.h"
 #include "PartitionInfo.h"
 #include "ScalableHoleMap.h"
 #include "YogaMesh.h"
@@ -14,7 +17,7 @@ class DruyorTypeAssignment {
   public:
     DruyorTypeAssignment(const YogaMesh& mesh,
                          std::vector<Receptor>& receptors,
-                         const std::map<long, int>& g2l,
+                         const IdMap& g2l,
                          Parfait::SyncPattern& syncPattern,
                          const PartitionInfo& partitionInfo,
                          const MeshSystemInfo& mesh_system_info,
@@ -28,7 +31,7 @@ class DruyorTypeAssignment {
 
     static std::vector<StatusKeeper> getNodeStatuses(const YogaMesh& mesh,
                                                    std::vector<Receptor>& receptors,
-                                                   const std::map<long, int>& g2l,
+                                                   const IdMap& g2l,
                                                    Parfait::SyncPattern& syncPattern,
                                                    const PartitionInfo& partitionInfo,
                                                    const MeshSystemInfo& system_info,
@@ -74,13 +77,13 @@ class DruyorTypeAssignment {
     bool doSelectedNodesContain(const std::vector<int>& selected_nodes,
                                 const NodeStatus s,
                                 const std::vector<StatusKeeper>& node_statuses) const;
+    bool doSelectedNodesContain(Parfait::CompressedRowGraph::Row selected_nodes,
+                                const NodeStatus s,
+                                const std::vector<StatusKeeper>& node_statuses) const;
 
     bool hasValidDonor(const Receptor& r);
 
-    void updateDonorValidity(const YogaMesh& mesh,
-                             std::vector<Receptor>& receptors,
-                             std::vector<StatusKeeper>& node_statuses,
-                             const std::map<long, int>& g2l);
+    void updateDonorValidity(const std::vector<StatusKeeper>& node_statuses);
 
     void markNeighborsOfMandatoryReceptors(std::vector<StatusKeeper>& statuses,
         const std::vector<bool>& is_mine);
@@ -94,35 +97,41 @@ class DruyorTypeAssignment {
         long mandatory_receptor = 0;
         long unknown = 0;
     };
+    static StatusCounts tallyStatuses(const std::vector<StatusKeeper>& node_statuses, const std::vector<bool>& is_mine);
   private:
     const YogaMesh& mesh;
     const int extra_layers_for_bcs;
     std::vector<long> hole_nodes;
     std::vector<Receptor>& receptors;
-    const std::map<long, int>& globalToLocal;
+    const IdMap& globalToLocal;
     const Parfait::SyncPattern& sync_pattern;
     const PartitionInfo& partition_info;
     const MeshSystemInfo& mesh_system_info;
     MessagePasser mp;
-    std::vector<std::vector<int>> node_to_node;
+    Parfait::CompressedRowGraph node_to_node;
+    std::unique_ptr<DonorValidityPlan> donor_validity_plan;
+    const bool defer_status_counts;
+    std::vector<std::pair<std::string, StatusCounts>> deferred_counts;
+    std::vector<long> deferred_local_counts;
+    std::vector<long> deferred_global_counts;
+    MPI_Request deferred_count_request;
 
 
-    int countStatus(const std::vector<StatusKeeper>& statuses, const NodeStatus s,const std::vector<bool>& is_mine);
     double getMinDonorDistance(int local_node_id,const std::vector<CandidateDonor>& candidates);
     bool has_at_least_one_valid_node(const std::vector<YOGA::StatusKeeper>& node_statuses, const std::vector<int>& cell);
     std::vector<bool> getIsNodeMine();
-    std::vector<std::vector<int>> verifyDonorValidityLocally(const std::vector<std::vector<int>>& cell_ids_to_check_from_ranks,
-                                                                                   const std::vector<StatusKeeper>& node_statuses);
-    void applyDonorValidityUpdate(const std::vector<std::vector<int>>& donor_validity,
-                                  const std::vector<std::vector<int>>& cell_ids_to_check,
-                                  const std::vector<std::vector<int>>& receptor_indices,
-                                  const std::vector<std::vector<int>>& donor_indices);
 
     std::vector<std::pair<int, int>> getIdsOfHoleNodes(const YogaMesh& mesh,
                                                                              const std::vector<ScalableHoleMap>& h);
     void printCounts(const std::string& msg,const StatusCounts& counts) const;
     std::vector<std::vector<int>> buildNodeToNode(const YogaMesh& m) const;
-    void updateCounts(const std::vector<StatusKeeper>& node_statuses, StatusCounts& counts, const std::vector<bool>& is_mine);
+    // Reduces and prints the counts after each phase, or, when quiet, keeps
+    // them until one nonblocking reduction at the end of type assignment.
+    void recordCounts(const std::string& phase,
+                      const std::vector<StatusKeeper>& node_statuses,
+                      const std::vector<bool>& is_mine);
+    void startDeferredCountReduction();
+    void finishDeferredCountReduction();
     std::vector<int> getReceptorIndices() const;
     void convertMandatoryReceptors(std::vector<StatusKeeper>& statuses,
         const std::vector<int>& receptor_indices,
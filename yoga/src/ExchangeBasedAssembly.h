@@ -1,111 +1,383 @@
 #pragma once
 
+#include <parfait/BatchCellContainmentChecker.h>
+#include <parfait/CellContainmentChecker.h>
+#include <parfait/CompressedRowGraph.h>
+#include <unordered_map>
+#include "DonorWarmStart.h"
 #include "InterpolationTools.h"
+#include "MortonOrdering.h"
+#include "Receptor.h"
 #include "VoxelFragment.h"
 namespace YOGA{
 
 class FragmentDonorFinder{
   public:
     FragmentDonorFinder(const std::map<int,VoxelFragment>& frags_from_ranks,
-                        std::function<bool(double*, int, double*)> is_in_cell)
+                        DonorWarmStart* warm_start = nullptr)
     :fragments_from_ranks(frags_from_ranks),
     extent(Parfait::ExtentBuilder::createEmptyBuildableExtent<double>()),
-    is_in_cell(is_in_cell){
+    warm_start(warm_start){
         for(auto& pair:fragments_from_ranks){
             int rank = pair.first;
             auto& frag = pair.second;
             auto e = calcFragmentExtent(frag);
             Parfait::ExtentBuilder::add(extent,e);
             std::set<int> component_ids;
-            for(auto& node:frag.transferNodes) component_ids.insert(node.associatedComponentId);
+            component_ids.insert(frag.transferNodes.associatedComponentIds.begin(),
+                                 frag.transferNodes.associatedComponentIds.end());
             for(int component:component_ids){
                 adts[rank][component] = std::make_shared<Parfait::Adt3DExtent>(e);
                 auto& adt = *adts[rank][component];
                 addCellsToAdt(adt,frag,component);
             }
+            if(warm_start != nullptr)
+                fragment_cell_ids[rank] = mapDonorCellsToFragmentIds(frag);
         }
     }
 
     void clear(){
         adts.clear();
+        fragment_cell_ids.clear();
+        node_to_cell.clear();
     }
 
+    void setThreadCount(int n){thread_count = std::max(1,n);}
+    int threadCount() const {return thread_count;}
+
+    // Searches query points in Morton order of their location, so that
+    // consecutive searches touch the same ADT branches and donor cells.
+    // Receptors are still returned in query order.
+    void setMortonOrdering(bool enable){morton_ordering = enable;}
+    bool isMortonOrdering() const {return morton_ordering;}
+
+    struct WarmStartStats {
+        long hits = 0;
+        long misses = 0;
+        long walk_steps = 0;
+        long adt_searches = 0;
+    };
+
+    // A cell that may contain a query point.  Cells found by the ADT are
+    // verified in one batch per block of query points; cells found by walking
+    // are already known to contain the point (batch_index < 0).
+    struct CandidateCell {
+        int query_index;
+        int fragment_index;
+        int component;
+        int id;
+        int batch_index;
+    };
+
+    // Scratch space and deferred warm-start updates for one search thread.
+    struct SearchWorkspace {
+        std::vector<CandidateCell> candidate_cells;
+        Parfait::BatchCellContainmentChecker containment_batch;
+        WarmStartStats stats;
+        std::vector<std::pair<long,std::vector<DonorWarmStart::DonorCell>>> warm_start_updates;
+        std::vector<int> receptor_queries;
+    };
+
     std::vector<Receptor> generateCandidateReceptors(const std::vector<TransferNode>& query_pts){
+        std::vector<SearchWorkspace> workspaces(1);
         std::vector<Receptor> candidate_receptors;
-        std::vector<int> donor_ids;
-        for(auto& query_pt:query_pts){
-            auto& p = query_pt.xyz;
-            int query_component = query_pt.associatedComponentId;
-            Receptor receptor;
-            receptor.globalId = query_pt.globalId;
-            receptor.owner = query_pt.owningRank;
-            receptor.distance = query_pt.distanceToWall;
-            for(auto& pair:adts){
-                int fragment_index = pair.first;
-                auto& frag = fragments_from_ranks.at(fragment_index);
-                for(auto& pair2:pair.second) {
-                    int adt_component = pair2.first;
-                    if(adt_component != query_component) {
-                        auto& adt = *pair2.second;
-                        adt.retrieve({p, p}, donor_ids);
-                        removeNonContainingDonors(fragment_index, p, donor_ids);
-                        for(int id:donor_ids){
-                            int cell_size,index_in_type;
-                            getCellSizeAndIndex(frag,id,cell_size,index_in_type);
-                            int local_cell_id = getLocalCellId(frag,cell_size,index_in_type);
-                            int donor_owner = getCellOwner(frag,cell_size,index_in_type);
-                            double donor_distance = calcInterpolatedDistance(frag,p,id);
-                            CandidateDonor::CellType cell_type = cellType(frag,cell_size);
-                            receptor.candidateDonors.emplace_back(CandidateDonor(
-                                adt_component, local_cell_id, donor_owner, donor_distance, cell_type));
-                        }
-                    }
-                    donor_ids.clear();
-                }
-            }
-            if(receptor.candidateDonors.size() > 0) {
-                candidate_receptors.emplace_back(receptor);
-            }
-        }
+        generateCandidateReceptors(query_pts,0,query_pts.size(),workspaces.front(),candidate_receptors);
+        finishSearch(workspaces);
         return candidate_receptors;
     }
 
+    // Searches query_pts[begin,end).  Several threads may call this at once,
+    // each with its own workspace, after prepareForThreadedSearch().
+    void generateCandidateReceptors(const std::vector<TransferNode>& query_pts,size_t begin,size_t end,
+                                    SearchWorkspace& workspace,std::vector<Receptor>& candidate_receptors){
+        auto order = searchOrder(query_pts,begin,end);
+        size_t first_receptor = candidate_receptors.size();
+        size_t first_update = workspace.warm_start_updates.size();
+        workspace.receptor_queries.clear();
+        for(size_t block_begin=0;block_begin<order.size();block_begin+=query_block_size){
+            size_t block_end = std::min(order.size(),block_begin+query_block_size);
+            gatherCandidateCells(query_pts,order,block_begin,block_end,workspace);
+            workspace.containment_batch.check();
+            addVerifiedDonors(query_pts,order,block_begin,block_end,workspace,candidate_receptors);
+        }
+        if(morton_ordering)
+            restoreQueryOrder(order,first_receptor,first_update,workspace,candidate_receptors);
+    }
+
+    // Builds everything the search would otherwise create lazily, so that the
+    // finder is only read during a threaded search.
+    void prepareForThreadedSearch(){
+        if(warm_start == nullptr) return;
+        for(auto& pair:fragments_from_ranks) getNodeToCell(pair.first);
+    }
+
+    // Applies the warm-start updates of every workspace, in order.
+    void finishSearch(std::vector<SearchWorkspace>& workspaces){
+        if(warm_start == nullptr) return;
+        WarmStartStats stats;
+        for(auto& workspace:workspaces){
+            for(auto& update:workspace.warm_start_updates)
+                warm_start->update(update.first,std::move(update.second));
+            workspace.warm_start_updates.clear();
+            stats.hits += workspace.stats.hits;
+            stats.misses += workspace.stats.misses;
+            stats.walk_steps += workspace.stats.walk_steps;
+            stats.adt_searches += workspace.stats.adt_searches;
+        }
+        Tracer::counter("donor warm start",{{"hits",stats.hits},
+                                            {"misses",stats.misses},
+                                            {"walk steps",stats.walk_steps},
+                                            {"adt searches",stats.adt_searches}});
+    }
+
     Parfait::Extent<double> getExtent() const {return extent;}
 
   private:
     const std::map<int,VoxelFragment>& fragments_from_ranks;
     Parfait::Extent<double> extent;
-    std::function<bool(double*, int, double*)> is_in_cell;
     std::map<int,std::map<int,std::shared_ptr<Parfait::Adt3DExtent>>> adts;
+    DonorWarmStart* warm_start;
+    std::map<int,std::unordered_map<long,int>> fragment_cell_ids;
+    std::map<int,std::vector<std::vector<int>>> node_to_cell;
+    int thread_count = 1;
+    bool morton_ordering = false;
+    const int max_walk_steps = 8;
+    const size_t query_block_size = 1024;
 
-    Parfait::Extent<double> calcFragmentExtent(const VoxelFragment& frag){
-        auto e = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
-        for(auto& node:frag.transferNodes) Parfait::ExtentBuilder::add(e,node.xyz);
-        return e;
+    static long donorCellKey(int owner,int cell_id){
+        return (long(owner) << 32) + long(cell_id);
+    }
+
+    std::unordered_map<long,int> mapDonorCellsToFragmentIds(const VoxelFragment& frag) const {
+        std::unordered_map<long,int> ids;
+        int id = 0;
+        for(auto& cell:frag.transferTets) ids[donorCellKey(cell.owningRank,cell.cellId)] = id++;
+        for(auto& cell:frag.transferPyramids) ids[donorCellKey(cell.owningRank,cell.cellId)] = id++;
+        for(auto& cell:frag.transferPrisms) ids[donorCellKey(cell.owningRank,cell.cellId)] = id++;
+        for(auto& cell:frag.transferHexs) ids[donorCellKey(cell.owningRank,cell.cellId)] = id++;
+        return ids;
     }
 
-    void removeNonContainingDonors(int fragment_index,const Parfait::Point<double>& p,std::vector<int>& donor_ids){
-        std::set<int> ids_to_remove;
+    const std::vector<std::vector<int>>& getNodeToCell(int fragment_index){
+        auto it = node_to_cell.find(fragment_index);
+        if(it != node_to_cell.end()) return it->second;
         auto& frag = fragments_from_ranks.at(fragment_index);
-        std::vector<Parfait::Point<double>> cell;
-        for(int id:donor_ids){
+        auto& n2c = node_to_cell[fragment_index];
+        n2c.resize(frag.transferNodes.size());
+        int ncells = frag.transferTets.size() + frag.transferPyramids.size()
+                     + frag.transferPrisms.size() + frag.transferHexs.size();
+        for(int id=0;id<ncells;id++){
             int n;
             const int* ptr;
             getCellSizeAndPointer(frag,id,n,ptr);
-            cell.resize(n);
-            fillCell(frag,cell,ptr,n);
-            if(not is_in_cell(cell.front().data(),n,(double*)p.data())){
-                ids_to_remove.insert(id);
+            for(int i=0;i<n;i++) n2c[ptr[i]].push_back(id);
+        }
+        return n2c;
+    }
+
+    bool doesCellContain(const VoxelFragment& frag,int id,const Parfait::Point<double>& p){
+        int n;
+        const int* ptr;
+        getCellSizeAndPointer(frag,id,n,ptr);
+        std::array<Parfait::Point<double>,8> cell;
+        for(int i=0;i<n;i++) cell[i] = frag.transferNodes.xyz[ptr[i]];
+        return Parfait::CellContainmentChecker::isInCell_c(cell.front().data(),n,(double*)p.data());
+    }
+
+    Parfait::Point<double> cellCentroid(const VoxelFragment& frag,int id){
+        int n;
+        const int* ptr;
+        getCellSizeAndPointer(frag,id,n,ptr);
+        Parfait::Point<double> c{0,0,0};
+        for(int i=0;i<n;i++) c += frag.transferNodes.xyz[ptr[i]];
+        return c / double(n);
+    }
+
+    int cellComponent(const VoxelFragment& frag,int id){
+        int n;
+        const int* ptr;
+        getCellSizeAndPointer(frag,id,n,ptr);
+        return frag.transferNodes.associatedComponentIds[ptr[0]];
+    }
+
+    bool findDonorByWalking(int fragment_index,
+                            const Parfait::Point<double>& p,
+                            long global_id,
+                            int component,
+                            std::vector<int>& donor_ids,
+                            WarmStartStats& stats){
+        auto& frag = fragments_from_ranks.at(fragment_index);
+        auto& ids = fragment_cell_ids.at(fragment_index);
+        for(auto& donor:warm_start->previousDonors(global_id)){
+            auto it = ids.find(donorCellKey(donor.first,donor.second));
+            if(it == ids.end()) continue;
+            int current = it->second;
+            if(cellComponent(frag,current) != component) continue;
+            std::set<int> visited = {current};
+            for(int step=0;step<=max_walk_steps;step++){
+                if(doesCellContain(frag,current,p)){
+                    donor_ids.push_back(current);
+                    stats.hits++;
+                    stats.walk_steps += step;
+                    return true;
+                }
+                int next = walkTowards(frag,getNodeToCell(fragment_index),current,p,component,visited);
+                if(next < 0) break;
+                visited.insert(next);
+                current = next;
+            }
+            stats.misses++;
+            return false;
+        }
+        return false;
+    }
+
+    int walkTowards(const VoxelFragment& frag,
+                    const std::vector<std::vector<int>>& n2c,
+                    int current,
+                    const Parfait::Point<double>& p,
+                    int component,
+                    const std::set<int>& visited){
+        int n;
+        const int* ptr;
+        getCellSizeAndPointer(frag,current,n,ptr);
+        int best = -1;
+        double best_distance = std::numeric_limits<double>::max();
+        for(int i=0;i<n;i++){
+            for(int nbr:n2c[ptr[i]]){
+                if(visited.count(nbr) == 1) continue;
+                if(cellComponent(frag,nbr) != component) continue;
+                double d = (cellCentroid(frag,nbr) - p).magnitude();
+                if(d < best_distance){
+                    best_distance = d;
+                    best = nbr;
+                }
+            }
+        }
+        return best;
+    }
+
+    Parfait::Extent<double> calcFragmentExtent(const VoxelFragment& frag){
+        auto e = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
+        for(auto& p:frag.transferNodes.xyz) Parfait::ExtentBuilder::add(e,p);
+        return e;
+    }
+
+    std::vector<int> searchOrder(const std::vector<TransferNode>& query_pts,size_t begin,size_t end) const {
+        std::vector<int> order(end-begin);
+        std::iota(order.begin(),order.end(),int(begin));
+        if(not morton_ordering) return order;
+        std::vector<uint64_t> keys(order.size());
+        for(size_t i=0;i<order.size();i++) keys[i] = mortonKeyInExtent(extent,query_pts[order[i]].xyz);
+        auto by_key = orderByKey(keys);
+        for(auto& i:by_key) i += int(begin);
+        return by_key;
+    }
+
+    // Puts the receptors and warm-start updates found since first_receptor and
+    // first_update back in the order of their query points.
+    void restoreQueryOrder(const std::vector<int>& order,size_t first_receptor,size_t first_update,
+                           SearchWorkspace& workspace,std::vector<Receptor>& candidate_receptors) const {
+        auto& queries = workspace.receptor_queries;
+        std::vector<int> by_query(queries.size());
+        std::iota(by_query.begin(),by_query.end(),0);
+        std::sort(by_query.begin(),by_query.end(),[&](int a,int b){return queries[a] < queries[b];});
+        std::vector<Receptor> receptors;
+        receptors.reserve(by_query.size());
+        for(int i:by_query) receptors.emplace_back(std::move(candidate_receptors[first_receptor+i]));
+        std::move(receptors.begin(),receptors.end(),candidate_receptors.begin()+first_receptor);
+
+        auto& updates = workspace.warm_start_updates;
+        if(updates.size() == first_update) return;
+        int first_query = *std::min_element(order.begin(),order.end());
+        std::vector<std::pair<long,std::vector<DonorWarmStart::DonorCell>>> in_order(order.size());
+        for(size_t i=0;i<order.size();i++) in_order[order[i]-first_query] = std::move(updates[first_update+i]);
+        std::move(in_order.begin(),in_order.end(),updates.begin()+first_update);
+    }
+
+    void gatherCandidateCells(const std::vector<TransferNode>& query_pts,const std::vector<int>& order,
+                              size_t begin,size_t end,SearchWorkspace& workspace){
+        auto& candidate_cells = workspace.candidate_cells;
+        auto& containment_batch = workspace.containment_batch;
+        auto& stats = workspace.stats;
+        candidate_cells.clear();
+        containment_batch.clear();
+        std::vector<int> donor_ids;
+        for(size_t i=begin;i<end;i++){
+            int q = order[i];
+            auto& query_pt = query_pts[q];
+            auto& p = query_pt.xyz;
+            for(auto& pair:adts){
+                int fragment_index = pair.first;
+                auto& frag = fragments_from_ranks.at(fragment_index);
+                for(auto& pair2:pair.second) {
+                    int adt_component = pair2.first;
+                    if(adt_component == query_pt.associatedComponentId) continue;
+                    donor_ids.clear();
+                    bool found_by_walk = warm_start != nullptr and
+                        findDonorByWalking(fragment_index,p,query_pt.globalId,adt_component,donor_ids,stats);
+                    if(found_by_walk) {
+                        for(int id:donor_ids)
+                            candidate_cells.push_back({q,fragment_index,adt_component,id,-1});
+                        continue;
+                    }
+                    pair2.second->retrieve({p, p}, donor_ids);
+                    stats.adt_searches++;
+                    for(int id:donor_ids){
+                        int n;
+                        const int* ptr;
+                        getCellSizeAndPointer(frag,id,n,ptr);
+                        int batch_index = containment_batch.add(n,ptr,frag.transferNodes.xyz,p.data());
+                        candidate_cells.push_back({q,fragment_index,adt_component,id,batch_index});
+                    }
+                }
+            }
+        }
+    }
+
+    void addVerifiedDonors(const std::vector<TransferNode>& query_pts,const std::vector<int>& order,
+                           size_t begin,size_t end,
+                           SearchWorkspace& workspace,std::vector<Receptor>& candidate_receptors){
+        auto& candidate_cells = workspace.candidate_cells;
+        auto& containment_batch = workspace.containment_batch;
+        std::vector<DonorWarmStart::DonorCell> found_donors;
+        auto candidate = candidate_cells.begin();
+        for(size_t i=begin;i<end;i++){
+            int q = order[i];
+            auto& query_pt = query_pts[q];
+            auto& p = query_pt.xyz;
+            Receptor receptor;
+            receptor.globalId = query_pt.globalId;
+            receptor.owner = query_pt.owningRank;
+            receptor.distance = query_pt.distanceToWall;
+            found_donors.clear();
+            for(;candidate != candidate_cells.end() and candidate->query_index == q;++candidate){
+                if(candidate->batch_index >= 0 and not containment_batch.isInCell(candidate->batch_index))
+                    continue;
+                auto& frag = fragments_from_ranks.at(candidate->fragment_index);
+                int cell_size,index_in_type;
+                getCellSizeAndIndex(frag,candidate->id,cell_size,index_in_type);
+                int local_cell_id = getLocalCellId(frag,cell_size,index_in_type);
+                int donor_owner = getCellOwner(frag,cell_size,index_in_type);
+                double donor_distance = calcInterpolatedDistance(frag,p,candidate->id);
+                CandidateDonor::CellType cell_type = cellType(frag,cell_size);
+                receptor.candidateDonors.emplace_back(CandidateDonor(
+                    candidate->component, local_cell_id, donor_owner, donor_distance, cell_type));
+                found_donors.push_back({donor_owner,local_cell_id});
+            }
+            if(warm_start != nullptr)
+                workspace.warm_start_updates.emplace_back(query_pt.globalId,found_donors);
+            if(receptor.candidateDonors.size() > 0) {
+                candidate_receptors.emplace_back(receptor);
+                workspace.receptor_queries.push_back(q);
             }
         }
-        auto end = std::remove_if(donor_ids.begin(),donor_ids.end(),[&](int id){return ids_to_remove.count(id)==1;});
-        donor_ids.resize(std::distance(donor_ids.begin(),end));
     }
 
     void fillCell(const VoxelFragment& frag,std::vector<Parfait::Point<double>>& cell,const int* ptr,int n) const{
         for(int i=0;i<n;i++){
             int node_id = ptr[i];
-            cell[i] = frag.transferNodes[node_id].xyz;
+            cell[i] = frag.transferNodes.xyz[node_id];
         }
     }
 
@@ -140,7 +412,7 @@ class FragmentDonorFinder{
         std::vector<double> vertex_distances(n);
         for(int i=0;i<n;i++){
             int vertex_node_id = ptr[i];
-            vertex_distances[i] = frag.transferNodes[vertex_node_id].distanceToWall;
+            vertex_distances[i] = frag.transferNodes.distancesToWall[vertex_node_id];
         }
         return least_squares_interpolate(n,cell.front().data(),vertex_distances.data(),p.data());
     }
@@ -180,73 +452,74 @@ class FragmentDonorFinder{
 
     template<typename Cell>
     int componentOfCell(const VoxelFragment& frag,const Cell& cell) const {
-        return frag.transferNodes[cell.nodeIds.front()].associatedComponentId;
+        return frag.transferNodes.associatedComponentIds[cell.nodeIds.front()];
     }
 
     void addCellsToAdt(Parfait::Adt3DExtent& adt,const VoxelFragment& frag,const int component_id){
+        std::vector<int> cell_ids;
+        std::vector<Parfait::Extent<double>> cell_extents;
         int local_cell_id = 0;
         for(auto& tet:frag.transferTets){
             if(component_id == componentOfCell(frag,tet)) {
-                adt.store(local_cell_id, createExtentFromCell(frag, tet.nodeIds.data(), 4));
+                cell_ids.push_back(local_cell_id);
+                cell_extents.push_back(createExtentFromCell(frag, tet.nodeIds.data(), 4));
             }
             local_cell_id++;
         }
         for(auto& pyramid:frag.transferPyramids){
             if(component_id == componentOfCell(frag,pyramid)) {
-                adt.store(local_cell_id, createExtentFromCell(frag, pyramid.nodeIds.data(), 5));
+                cell_ids.push_back(local_cell_id);
+                cell_extents.push_back(createExtentFromCell(frag, pyramid.nodeIds.data(), 5));
             }
             local_cell_id++;
         }
         for(auto& prism:frag.transferPrisms){
             if(component_id == componentOfCell(frag,prism)) {
-                adt.store(local_cell_id, createExtentFromCell(frag, prism.nodeIds.data(), 6));
+                cell_ids.push_back(local_cell_id);
+                cell_extents.push_back(createExtentFromCell(frag, prism.nodeIds.data(), 6));
             }
             local_cell_id++;
         }
         for(auto& hex:frag.transferHexs){
             if(component_id == componentOfCell(frag,hex)) {
-                adt.store(local_cell_id, createExtentFromCell(frag, hex.nodeIds.data(), 8));
+                cell_ids.push_back(local_cell_id);
+                cell_extents.push_back(createExtentFromCell(frag, hex.nodeIds.data(), 8));
             }
             local_cell_id++;
         }
+        adt.bulkLoad(cell_ids,cell_extents);
     }
 
     Parfait::Extent<double> createExtentFromCell(const VoxelFragment& frag,
             const int* cell,int n){
         auto e = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
         for(int i=0;i<n;i++) {
-            auto vertex = frag.transferNodes[cell[i]].xyz;
-            Parfait::ExtentBuilder::add(e,vertex);
+            Parfait::ExtentBuilder::add(e,frag.transferNodes.xyz[cell[i]]);
         }
         return e;
     }
 
-    void fillNeighbors(std::vector<std::set<int>>& n2n,const int* cell,int cell_size){
+    template <typename Emit>
+    void fillNeighbors(Emit emit,const int* cell,int cell_size){
         for(int i=0;i<cell_size;i++){
             for(int j=i+1;j<cell_size;j++){
                 int left = cell[i];
                 int right = cell[j];
-                n2n[left].insert(right);
-                n2n[right].insert(left);
+                emit(left,right);
+                emit(right,left);
             }
         }
     }
 
-    std::vector<std::set<int>> createNodeNeighbors(const VoxelFragment& fragment){
+    Parfait::CompressedRowGraph createNodeNeighbors(const VoxelFragment& fragment){
         Tracer::begin("n2n");
-        std::vector<std::set<int>> n2n(fragment.transferNodes.size());
-        for(const auto & cell : fragment.transferTets){
-            fillNeighbors(n2n,cell.nodeIds.data(),4);
-        }
-        for(const auto & cell : fragment.transferPyramids){
-            fillNeighbors(n2n,cell.nodeIds.data(),5);
-        }
-        for(const auto & cell : fragment.transferPrisms){
-            fillNeighbors(n2n,cell.nodeIds.data(),6);
-        }
-        for(const auto & cell : fragment.transferHexs){
-            fillNeighbors(n2n,cell.nodeIds.data(),8);
-        }
+        auto n2n = Parfait::CompressedRowGraph::build(fragment.transferNodes.size(),[&](auto emit){
+            for(const auto & cell : fragment.transferTets) fillNeighbors(emit,cell.nodeIds.data(),4);
+            for(const auto & cell : fragment.transferPyramids) fillNeighbors(emit,cell.nodeIds.data(),5);
+            for(const auto & cell : fragment.transferPrisms) fillNeighbors(emit,cell.nodeIds.data(),6);
+            for(const auto & cell : fragment.transferHexs) fillNeighbors(emit,cell.nodeIds.data(),8);
+        });
+        n2n.sortAndRemoveDuplicates();
         Tracer::end("n2n");
         return n2n;
     }
@@ -1,6 +1,7 @@
 #pragma once
 #include <DomainConnectivityInfo.h>
 #include <YogaMesh.h>
+#include "IdMap.h"
 
 namespace YOGA {
 template<typename T>
@@ -12,7 +13,7 @@ class FUN3DAdjointData {
                      const std::vector<NodeStatus>& statuses,
                      const std::map<int, OversetData::DonorCell>& receptors)
     :dci(DomainConnectivityInfo<T>(mp,mesh,statuses,receptors)){
-        std::map<long,int> g2l;
+        IdMap g2l;
         for(int i=0;i<mesh.nodeCount();i++)
             g2l[mesh.globalNodeId(i)] = i;
         int nreceptors = dci.receptorGids.size();
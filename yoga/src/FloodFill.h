@@ -1,4 +1,5 @@
 #pragma once
+#include <parfait/CompressedRowGraph.h>
 #include <set>
 #include <map>
 #include <queue>
@@ -7,7 +8,8 @@
 namespace YOGA {
 class FloodFill {
   public:
-    FloodFill(const std::vector<std::vector<int>>& node_to_node) : n2n(node_to_node) {}
+    FloodFill(const Parfait::CompressedRowGraph& node_to_node) : n2n(node_to_node) {}
+    FloodFill(const std::vector<std::vector<int>>& node_to_node) : owned_n2n(node_to_node), n2n(owned_n2n) {}
     void fill(std::vector<int>& node_values, std::set<int> seeds,const std::map<int,int>& allowed_transitions) {
         std::queue<int> queue;
         for (auto seed : seeds) queue.push(seed);
@@ -51,7 +53,8 @@ class FloodFill {
     }
 
   private:
-    const std::vector<std::vector<int>>& n2n;
+    Parfait::CompressedRowGraph owned_n2n;
+    const Parfait::CompressedRowGraph& n2n;
     int count(const std::vector<int>& values, int target) {
         int n = 0;
         for (int v : values)
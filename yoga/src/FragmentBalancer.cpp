@@ -15,7 +15,7 @@ std::pair<FragmentMap, AffinityMap> createAndBalanceFragments(MessagePasser mp,
                                                               const YogaMesh& mesh,
                                                               const PartitionInfo& partition_info,
                                                               const MeshSystemInfo& mesh_system_info,
-                                                              const std::map<long, int>& g2l,
+                                                              const IdMap& g2l,
                                                               int rcb_agglom_ncells,
                                                               Parfait::Inspector& inspector) {
     auto agglomeration = agglomerateCells(mesh, inspector, partition_info, mesh_system_info, rcb_agglom_ncells);
@@ -42,7 +42,7 @@ std::pair<FragmentMap, AffinityMap> createAndBalanceFragments(MessagePasser mp,
 }
 
 std::map<int, std::vector<bool>> buildNodeAffinities(const YogaMesh& view,
-                                                     const std::map<long, int>& g2l,
+                                                     const IdMap& g2l,
                                                      const std::map<int, VoxelFragment>& fragments_for_ranks) {
     std::vector<bool> is_node_claimed_by_fragment(view.nodeCount(), false);
     std::map<int, std::vector<bool>> node_fragment_affinity;
@@ -51,8 +51,7 @@ std::map<int, std::vector<bool>> buildNodeAffinities(const YogaMesh& view,
         auto& frag = pair.second;
         node_fragment_affinity[rank].resize(frag.transferNodes.size(), false);
         for (size_t i = 0; i < frag.transferNodes.size(); i++) {
-            auto& node = frag.transferNodes[i];
-            int local_id = g2l.at(node.globalId);
+            int local_id = g2l.at(frag.transferNodes.globalIds[i]);
             if (not is_node_claimed_by_fragment[local_id]) {
                 is_node_claimed_by_fragment[local_id] = true;
                 node_fragment_affinity[rank][i] = true;
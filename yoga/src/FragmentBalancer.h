@@ -2,6 +2,7 @@
 #include <vector>
 #include <parfait/Point.h>
 #include "YogaMesh.h"
+#include "IdMap.h"
 #include <parfait/Inspector.h>
 #include "PartitionInfo.h"
 #include "VoxelFragment.h"
@@ -16,13 +17,13 @@ std::pair<FragmentMap, AffinityMap> createAndBalanceFragments(MessagePasser mp,
                                                               const YogaMesh& mesh,
                                                               const PartitionInfo& partition_info,
                                                               const MeshSystemInfo& mesh_system_info,
-                                                              const std::map<long, int>& g2l,
+                                                              const IdMap& g2l,
                                                               int rcb_agglom_ncells,
                                                               Parfait::Inspector& inspector);
 
 
 std::map<int, std::vector<bool>> buildNodeAffinities(const YogaMesh& view,
-                                                     const std::map<long, int>& g2l,
+                                                     const IdMap& g2l,
                                                      const std::map<int, VoxelFragment>& fragments_for_ranks);
 struct Agglomeration {
     std::vector<Parfait::Point<double>> points;
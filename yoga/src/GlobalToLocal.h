@@ -1,13 +1,13 @@
 #pragma once
-#include <map>
+#include "IdMap.h"
 #include "YogaMesh.h"
 
 namespace YOGA {
 
 class GlobalToLocal {
   public:
-    static std::map<long, int> buildMap(const YogaMesh& mesh) {
-        std::map<long, int> g2l;
+    static IdMap buildMap(const YogaMesh& mesh) {
+        IdMap g2l(mesh.nodeCount());
         for (int i = 0; i < mesh.nodeCount(); ++i) g2l[mesh.globalNodeId(i)] = i;
         return g2l;
     }
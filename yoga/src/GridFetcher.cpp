@@ -34,7 +34,7 @@ std::vector<std::shared_ptr<MessagePasser::Message>> GridFetcher::buildFragmentM
     for(auto& frag:frags){
         msgs.push_back(std::make_shared<MessagePasser::Message>());
         auto& msg = msgs.back();
-        msg->pack(frag.transferNodes);
+        TransferNodes::pack(*msg,frag.transferNodes);
         msg->pack(frag.transferTets);
         msg->pack(frag.transferPyramids);
         msg->pack(frag.transferPrisms);
@@ -47,8 +47,8 @@ std::vector<Parfait::Extent<double>> GridFetcher::buildFragmentExtents(const std
     std::vector<Parfait::Extent<double>> extents;
     for(auto& frag:frags){
         auto e = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
-        for(auto& tn:frag.transferNodes){
-            Parfait::ExtentBuilder::add(e,tn.xyz);
+        for(auto& p:frag.transferNodes.xyz){
+            Parfait::ExtentBuilder::add(e,p);
         }
         extents.emplace_back(e);
     }
@@ -6,10 +6,11 @@ std::vector<ScalableHoleMap> createHoleMaps(MessagePasser mp,
                                             const YogaMesh& view,
                                             const PartitionInfo& partitionInfo,
                                             const MeshSystemInfo& meshSystemInfo,
-                                            int max_cells_per_hole_map) {
+                                            int max_cells_per_hole_map,
+                                            bool distributed) {
     std::vector<ScalableHoleMap> hole_maps;
     for (int i = 0; i < meshSystemInfo.numberOfBodies(); i++) {
-        hole_maps.emplace_back(ScalableHoleMap(mp, view, partitionInfo, meshSystemInfo, i, max_cells_per_hole_map));
+        hole_maps.emplace_back(ScalableHoleMap(mp, view, partitionInfo, meshSystemInfo, i, max_cells_per_hole_map, distributed));
     }
     return hole_maps;
 }
@@ -79,7 +80,7 @@ std::vector<Parfait::Extent<double>> getInitialWorkUnits(MessagePasser mp, std::
 
 std::vector<Receptor> removeNonReceptors(const std::vector<Receptor>& receptors,
                                          const std::vector<NodeStatus>& node_statuses,
-                                         const std::map<long, int>& global_to_local_node_id) {
+                                         const IdMap& global_to_local_node_id) {
     std::vector<Receptor> actual_receptors;
     for (auto& r : receptors) {
         int node_id = global_to_local_node_id.at(r.globalId);
@@ -1,6 +1,7 @@
 #pragma once
 #include <MessagePasser/MessagePasser.h>
 #include "LoadBalancer.h"
+#include "IdMap.h"
 #include "MeshSystemInfo.h"
 #include "PartitionInfo.h"
 #include "Receptor.h"
@@ -14,7 +15,8 @@ std::vector<ScalableHoleMap> createHoleMaps(MessagePasser mp,
                                             const YogaMesh& view,
                                             const PartitionInfo& partitionInfo,
                                             const MeshSystemInfo& meshSystemInfo,
-                                            int max_cells_per_hole_map);
+                                            int max_cells_per_hole_map,
+                                            bool distributed = false);
 std::vector<Parfait::Extent<double>> getComponentExtents(const MeshSystemInfo& info);
 bool doesOverlapOtherComponent(const std::vector<Parfait::Extent<double>>& component_extents,
                                const Parfait::Point<double>& p,
@@ -28,6 +30,6 @@ std::vector<bool> getInitialWorkUnitMask(MessagePasser mp, std::shared_ptr<LoadB
 std::vector<Parfait::Extent<double>> getInitialWorkUnits(MessagePasser mp, std::shared_ptr<LoadBalancer> load_balancer);
 std::vector<Receptor> removeNonReceptors(const std::vector<Receptor>& receptors,
                                          const std::vector<NodeStatus>& node_statuses,
-                                         const std::map<long, int>& global_to_local_node_id);
+                                         const IdMap& global_to_local_node_id);
 
 }
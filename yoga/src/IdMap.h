@@ -0,0 +1,108 @@
+#pragma once
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace YOGA {
+
+// Maps global ids to local ids in one flat open-addressing table with linear
+// probing, instead of one heap node per entry as std::map does.
+//
+// It provides the part of the std::map interface used for id lookups
+// (operator[], at, count, insert, size).  Entries are unordered, so there is no
+// iteration.  The smallest long is reserved to mark empty slots.
+class IdMap {
+  public:
+    IdMap() { rehash(16); }
+    explicit IdMap(size_t expected_size) {
+        rehash(16);
+        reserve(expected_size);
+    }
+
+    void reserve(size_t n) {
+        if (n > maxSize()) rehash(capacityFor(n));
+    }
+
+    size_t size() const { return entry_count; }
+    bool empty() const { return 0 == entry_count; }
+    size_t count(long key) const { return holds(findSlot(key), key) ? 1 : 0; }
+
+    int at(long key) const {
+        size_t i = findSlot(key);
+        if (not holds(i, key)) throw std::out_of_range("IdMap: no entry for id " + std::to_string(key));
+        return slots[i].value;
+    }
+
+    int& operator[](long key) {
+        size_t i = findSlot(key);
+        if (not holds(i, key)) i = insertAt(i, key, 0);
+        return slots[i].value;
+    }
+
+    // Returns false, leaving the value unchanged, if the key is already mapped.
+    bool insert(long key, int value) {
+        size_t i = findSlot(key);
+        if (holds(i, key)) return false;
+        insertAt(i, key, value);
+        return true;
+    }
+
+    size_t bytes() const { return slots.capacity() * sizeof(Slot); }
+
+  private:
+    struct Slot {
+        long key;
+        int value;
+    };
+    static constexpr long empty_key = std::numeric_limits<long>::min();
+
+    std::vector<Slot> slots;
+    int shift = 64;
+    size_t entry_count = 0;
+
+    // Keeps the table at most three quarters full.
+    size_t maxSize() const { return slots.size() / 4 * 3; }
+
+    static size_t capacityFor(size_t n) {
+        size_t capacity = 16;
+        while (capacity / 4 * 3 < n) capacity *= 2;
+        return capacity;
+    }
+
+    // Fibonacci hashing: the high bits of the product spread consecutive ids.
+    size_t home(long key) const { return size_t((unsigned long)key * 11400714819323198485ul >> shift); }
+
+    size_t findSlot(long key) const {
+        size_t mask = slots.size() - 1;
+        size_t i = home(key);
+        while (key != slots[i].key and empty_key != slots[i].key) i = (i + 1) & mask;
+        return i;
+    }
+
+    bool holds(size_t i, long key) const { return empty_key != key and key == slots[i].key; }
+
+    size_t insertAt(size_t i, long key, int value) {
+        if (empty_key == key) throw std::domain_error("IdMap: id " + std::to_string(key) + " is reserved");
+        if (entry_count + 1 > maxSize()) {
+            rehash(slots.size() * 2);
+            i = findSlot(key);
+        }
+        slots[i] = {key, value};
+        entry_count++;
+        return i;
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<Slot> old(capacity, Slot{empty_key, 0});
+        old.swap(slots);
+        shift = 64;
+        for (size_t c = capacity; c > 1; c /= 2) shift--;
+        for (auto& slot : old) {
+            if (empty_key == slot.key) continue;
+            slots[findSlot(slot.key)] = slot;
+        }
+    }
+};
+
+}
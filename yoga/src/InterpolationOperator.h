@@ -0,0 +1,182 @@
+#pragma once
+#include <MessagePasser/MessagePasser.h>
+#include <functional>
+#include <map>
+#include <vector>
+#include "InverseReceptor.h"
+#include "OversetData.h"
+#include "WeightBasedInterpolator.h"
+#include "YogaMesh.h"
+
+namespace YOGA {
+
+// Communication for receptor updates, frozen after assembly.  Each rank fills
+// one row of nvar values per inverse receptor, grouped by the rank that owns
+// the receptors and in the order that rank listed them.  Every group is sent
+// straight out of one contiguous buffer with a persistent request, and lands
+// in a persistent receive that is scattered to the receptor nodes.
+class ReceptorUpdateExchange {
+  public:
+    template <typename T>
+    ReceptorUpdateExchange(MessagePasser mp,
+                           int nvar,
+                           const std::map<int, OversetData::DonorCell>& receptors,
+                           const std::map<int, std::vector<InverseReceptor<T>>>& inverse_receptors)
+        : nvar(nvar) {
+        send_offsets.push_back(0);
+        for (auto& pair : inverse_receptors) {
+            send_ranks.push_back(pair.first);
+            send_offsets.push_back(send_offsets.back() + int(pair.second.size()));
+        }
+        std::map<int, std::vector<int>> ids_expected_from_rank;
+        for (auto& pair : receptors) ids_expected_from_rank[pair.second.owningRank].push_back(pair.first);
+        recv_offsets.push_back(0);
+        for (auto& pair : ids_expected_from_rank) {
+            recv_ranks.push_back(pair.first);
+            recv_node_ids.insert(recv_node_ids.end(), pair.second.begin(), pair.second.end());
+            recv_offsets.push_back(int(recv_node_ids.size()));
+        }
+        send_buffer.resize(size_t(nvar) * send_offsets.back());
+        recv_buffer.resize(size_t(nvar) * recv_offsets.back());
+        createPersistentRequests(mp.getCommunicator());
+    }
+
+    ReceptorUpdateExchange(const ReceptorUpdateExchange&) = delete;
+    ReceptorUpdateExchange& operator=(const ReceptorUpdateExchange&) = delete;
+
+    ~ReceptorUpdateExchange() {
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+        if (finalized) return;
+        for (auto& r : recv_requests) MPI_Request_free(&r);
+        for (auto& r : send_requests) MPI_Request_free(&r);
+    }
+
+    int rowCount() const { return send_offsets.back(); }
+    int nvariables() const { return nvar; }
+    double* row(int index) { return &send_buffer[size_t(nvar) * index]; }
+
+    // Receives can be posted before the rows are filled.
+    void beginReceives() {
+        if (not recv_requests.empty()) MPI_Startall(int(recv_requests.size()), recv_requests.data());
+    }
+
+    // Sends the filled rows and writes everything received into the receptor
+    // nodes of solution_at_nodes (nvar values per node).
+    void finish(double* solution_at_nodes) {
+        if (not send_requests.empty()) MPI_Startall(int(send_requests.size()), send_requests.data());
+        if (not recv_requests.empty())
+            MPI_Waitall(int(recv_requests.size()), recv_requests.data(), MPI_STATUSES_IGNORE);
+        for (size_t i = 0; i < recv_node_ids.size(); i++) {
+            const double* q = &recv_buffer[size_t(nvar) * i];
+            std::copy(q, q + nvar, solution_at_nodes + size_t(nvar) * recv_node_ids[i]);
+        }
+        if (not send_requests.empty())
+            MPI_Waitall(int(send_requests.size()), send_requests.data(), MPI_STATUSES_IGNORE);
+    }
+
+  private:
+    const int nvar;
+    std::vector<int> send_ranks;
+    std::vector<int> send_offsets;
+    std::vector<int> recv_ranks;
+    std::vector<int> recv_offsets;
+    std::vector<int> recv_node_ids;
+    std::vector<double> send_buffer;
+    std::vector<double> recv_buffer;
+    std::vector<MPI_Request> send_requests;
+    std::vector<MPI_Request> recv_requests;
+
+    void createPersistentRequests(MPI_Comm comm) {
+        const int receptor_update_tag = 31100;
+        recv_requests.resize(recv_ranks.size());
+        for (size_t i = 0; i < recv_ranks.size(); i++) {
+            int count = MessagePasser::bigToInt(long(nvar) * (recv_offsets[i + 1] - recv_offsets[i]));
+            MPI_Recv_init(&recv_buffer[size_t(nvar) * recv_offsets[i]],
+                          count, MPI_DOUBLE, recv_ranks[i], receptor_update_tag, comm, &recv_requests[i]);
+        }
+        send_requests.resize(send_ranks.size());
+        for (size_t i = 0; i < send_ranks.size(); i++) {
+            int count = MessagePasser::bigToInt(long(nvar) * (send_offsets[i + 1] - send_offsets[i]));
+            MPI_Send_init(&send_buffer[size_t(nvar) * send_offsets[i]],
+                          count, MPI_DOUBLE, send_ranks[i], receptor_update_tag, comm, &send_requests[i]);
+        }
+    }
+};
+
+// Donor stencils frozen after assembly as a CSR matrix: one row per inverse
+// receptor, in ReceptorUpdateExchange row order, and one column per distinct
+// donor node.  Applying it is one sparse mat-vec over nvar-strided values
+// followed by the receptor update exchange.
+class InterpolationOperator {
+  public:
+    template <typename WeightCalculator>
+    InterpolationOperator(MessagePasser mp,
+                          int nvar,
+                          const YogaMesh& mesh,
+                          const std::map<int, OversetData::DonorCell>& receptors,
+                          const std::map<int, std::vector<InverseReceptor<double>>>& inverse_receptors,
+                          WeightCalculator weight_calculator)
+        : nvar(nvar), exchange(mp, nvar, receptors, inverse_receptors) {
+        auto donor_clouds = generateDonorCloudsForInverseReceptors(mesh, inverse_receptors, weight_calculator);
+        std::vector<int> column_of_node(mesh.nodeCount(), -1);
+        row_offsets.push_back(0);
+        for (auto& pair : donor_clouds) {
+            for (auto& cloud : pair.second) {
+                for (size_t i = 0; i < cloud.node_ids.size(); i++) {
+                    int node_id = cloud.node_ids[i];
+                    if (column_of_node[node_id] < 0) {
+                        column_of_node[node_id] = int(donor_nodes.size());
+                        donor_nodes.push_back(node_id);
+                    }
+                    columns.push_back(column_of_node[node_id]);
+                    weights.push_back(cloud.weights[i]);
+                }
+                row_offsets.push_back(int(columns.size()));
+            }
+        }
+        donor_values.resize(size_t(nvar) * donor_nodes.size());
+    }
+
+    int rowCount() const { return int(row_offsets.size()) - 1; }
+    int donorNodeCount() const { return int(donor_nodes.size()); }
+
+    // Asks the solver for each donor node once.
+    void apply(const std::function<void(int, double*)>& getSolutionAtNode, std::vector<double>& solution_at_nodes) {
+        exchange.beginReceives();
+        for (size_t c = 0; c < donor_nodes.size(); c++) getSolutionAtNode(donor_nodes[c], &donor_values[size_t(nvar) * c]);
+        multiply(donor_values.data(), [](int column) { return column; });
+        exchange.finish(solution_at_nodes.data());
+    }
+
+    // Reads donor values from a contiguous array with nvar values per local node.
+    void apply(const double* solution, std::vector<double>& solution_at_nodes) {
+        exchange.beginReceives();
+        multiply(solution, [&](int column) { return donor_nodes[column]; });
+        exchange.finish(solution_at_nodes.data());
+    }
+
+  private:
+    const int nvar;
+    ReceptorUpdateExchange exchange;
+    std::vector<int> row_offsets;
+    std::vector<int> columns;
+    std::vector<double> weights;
+    std::vector<int> donor_nodes;
+    std::vector<double> donor_values;
+
+    template <typename IndexOfColumn>
+    void multiply(const double* values, IndexOfColumn index_of_column) {
+        for (int r = 0; r < rowCount(); r++) {
+            double* q = exchange.row(r);
+            std::fill(q, q + nvar, 0.0);
+            for (int k = row_offsets[r]; k < row_offsets[r + 1]; k++) {
+                const double* v = values + size_t(nvar) * index_of_column(columns[k]);
+                double w = weights[k];
+                for (int j = 0; j < nvar; j++) q[j] += v[j] * w;
+            }
+        }
+    }
+};
+
+}
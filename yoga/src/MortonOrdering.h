@@ -0,0 +1,34 @@
+#pragma once
+#include <algorithm>
+#include <numeric>
+#include <stdint.h>
+#include <vector>
+#include <parfait/Extent.h>
+#include <parfait/Morton.h>
+#include <parfait/Point.h>
+
+namespace YOGA {
+
+// Morton key of p within e, 21 bits per axis.  Points outside e are clamped to
+// its boundary, so any point gets a key and nearby points get nearby keys.
+inline uint64_t mortonKeyInExtent(const Parfait::Extent<double>& e, const Parfait::Point<double>& p) {
+    const double max_coordinate = double((1u << 21) - 1);
+    unsigned int ijk[3];
+    for (int i = 0; i < 3; i++) {
+        double length = e.hi[i] - e.lo[i];
+        double s = length > 0.0 ? (p[i] - e.lo[i]) / length : 0.0;
+        s = std::min(1.0, std::max(0.0, s));
+        ijk[i] = static_cast<unsigned int>(s * max_coordinate);
+    }
+    return Parfait::mortonEncode_magicbits(ijk[0], ijk[1], ijk[2]);
+}
+
+// Indices of keys in increasing key order; ties keep their original order.
+inline std::vector<int> orderByKey(const std::vector<uint64_t>& keys) {
+    std::vector<int> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return keys[a] < keys[b]; });
+    return order;
+}
+
+}
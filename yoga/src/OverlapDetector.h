@@ -1,14 +1,13 @@
 #pragma once
 #include <parfait/Adt3dExtent.h>
+#include <numeric>
 
 namespace YOGA {
 
 class OverlapDetector {
   public:
     OverlapDetector(const std::vector<Parfait::Extent<double>>& extents)
-        : adt(Parfait::ExtentBuilder::getBoundingBox(extents)), extents(extents) {
-        for (size_t i = 0; i < extents.size(); i++) adt.store(i, extents[i]);
-    }
+        : adt(Parfait::ExtentBuilder::getBoundingBox(extents), rankIds(extents.size()), extents), extents(extents) {}
 
     bool doesOverlap(const Parfait::Extent<double>& e, int rank) const {
         return e.intersects(extents[rank]);
@@ -25,6 +24,12 @@ class OverlapDetector {
   private:
     Parfait::Adt3DExtent adt;
     const std::vector<Parfait::Extent<double>>& extents;
+
+    static std::vector<int> rankIds(size_t n) {
+        std::vector<int> ids(n);
+        std::iota(ids.begin(), ids.end(), 0);
+        return ids;
+    }
 };
 
 }
\ No newline at end of file
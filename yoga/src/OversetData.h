@@ -1,5 +1,6 @@
 #pragma once
 #include "Receptor.h"
+#include "IdMap.h"
 #include "YogaStatuses.h"
 #include <Tracer.h>
 
@@ -9,7 +10,7 @@ class OversetData {
   public:
     OversetData(std::vector<NodeStatus>&& nodeStatuses,
                 const std::vector<Receptor>&& receptorCandidates,
-                const std::map<long, int>&& globalToLocal)
+                const IdMap&& globalToLocal)
         : statuses(nodeStatuses), receptors(createReceptors(receptorCandidates, globalToLocal)) {
         verify();
     }
@@ -39,7 +40,7 @@ class OversetData {
     }
 
     std::map<int, DonorCell> createReceptors(const std::vector<Receptor>& receptorCandidates,
-                                             const std::map<long, int>& globalToLocal) {
+                                             const IdMap& globalToLocal) {
         Tracer::begin("create receptor map");
         std::map<int, DonorCell> receptorMap;
         for (auto& r : receptorCandidates) {
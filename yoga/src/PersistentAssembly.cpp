@@ -0,0 +1,36 @@
+#include "PersistentAssembly.h"
+#include <Tracer.h>
+#include "AssemblyViaExchange.h"
+#include "YogaConfiguration.h"
+
+namespace YOGA {
+
+PersistentAssembly::PersistentAssembly(MessagePasser mp, YogaMesh& mesh) : mp(mp), mesh(mesh) {}
+
+void PersistentAssembly::moveComponent(int component, const Parfait::MotionMatrix& motion) {
+    Tracer::begin("move component");
+    mesh.setXyzForNodes([&](int node_id, double* xyz) {
+        if (mesh.getAssociatedComponentId(node_id) == component) motion.movePoint(xyz);
+    });
+    history.markComponentMoved(component, motion);
+    Tracer::end("move component");
+}
+
+std::shared_ptr<OversetData> PersistentAssembly::assemble() {
+    auto config = YogaConfiguration(mp);
+    history.enableWarmStart(config.shouldWarmStartDonorSearch());
+    history.enableBodyFrameSearchStructures(config.shouldKeepBodyFrameSearchStructures());
+    return assemblyViaExchange(mp,
+                               mesh,
+                               config.selectedLoadBalancer(),
+                               config.selectedTargetVoxelSize(),
+                               config.numberOfExtraLayersForInterpBcs(),
+                               config.rcbAgglomerationSize(),
+                               config.shouldAddExtraReceptors(),
+                               config.getComponentGridImportance(),
+                               history);
+}
+
+void PersistentAssembly::reset() { history.clear(); }
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <MessagePasser/MessagePasser.h>
+#include <parfait/MotionMatrix.h>
+#include <memory>
+#include "DonorSearchHistory.h"
+#include "OversetData.h"
+#include "YogaMesh.h"
+
+namespace YOGA {
+
+// Domain assembly that lives across time steps of a moving-body simulation.
+// Components are moved rigidly with moveComponent(), and the next call to
+// assemble() only re-searches donors for the query points that the motion
+// could have affected.  All other receptors reuse their previous candidates.
+class PersistentAssembly {
+  public:
+    PersistentAssembly(MessagePasser mp, YogaMesh& mesh);
+
+    // Local: moves this rank's nodes only and does no communication.  Every rank
+    // must still record the same motions before the next (collective) assemble().
+    void moveComponent(int component, const Parfait::MotionMatrix& motion);
+    std::shared_ptr<OversetData> assemble();
+    void reset();
+
+  private:
+    MessagePasser mp;
+    YogaMesh& mesh;
+    DonorSearchHistory history;
+};
+
+}
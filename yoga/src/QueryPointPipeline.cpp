@@ -0,0 +1,124 @@
+#include "QueryPointPipeline.h"
+#include <parfait/LinearPartitioner.h>
+#include <Tracer.h>
+#include <algorithm>
+#include <string>
+
+namespace YOGA {
+
+QueryPointPipeline::QueryPointPipeline(MessagePasser mp,
+                                       const std::map<int, long>& counts_for_ranks,
+                                       long max_points_per_round)
+    : mp(mp) {
+    std::map<int, std::vector<long>> counts_to_send;
+    long outgoing = 0;
+    for (auto& pair : counts_for_ranks) {
+        if (0 == pair.second) continue;
+        counts_to_send[pair.first] = {pair.second};
+        outgoing += pair.second;
+    }
+    long incoming = 0;
+    for (auto& pair : mp.Exchange(counts_to_send)) {
+        counts_from_ranks[pair.first] = pair.second.front();
+        incoming += pair.second.front();
+    }
+    max_points_per_round = std::max(1l, max_points_per_round);
+    long rounds_needed = std::max(incoming, outgoing) / max_points_per_round + 1;
+    round_count = int(mp.ParallelMax(rounds_needed));
+}
+
+long QueryPointPipeline::roundSize(int round, int round_count, long total) {
+    auto range = Parfait::LinearPartitioner::getRangeForWorker(round, total, round_count);
+    return range.end - range.start;
+}
+
+long QueryPointPipeline::pointsPerRoundForAvailableMemory(MessagePasser mp) {
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(mp.getCommunicator(), MPI_COMM_TYPE_SHARED, mp.Rank(), MPI_INFO_NULL, &node_comm);
+    int ranks_on_node = 1;
+    MPI_Comm_size(node_comm, &ranks_on_node);
+    MPI_Comm_free(&node_comm);
+
+    double budget = 0.25 * 1024.0 * 1024.0 * double(Tracer::availableMemoryMB()) / ranks_on_node;
+    // two rounds of points in each direction, plus a few donors per reply
+    double bytes_per_point = 4.0 * sizeof(TransferNode) + 128.0;
+    long min_points_per_round = 10000;
+    return std::max(min_points_per_round, long(budget / bytes_per_point));
+}
+
+void QueryPointPipeline::postRound(MessagePasser query_mp, int round, const PackRound& pack, Round& r) const {
+    r.outgoing = pack(round, round_count);
+    r.sends.clear();
+    for (auto& pair : r.outgoing) {
+        if (pair.second.empty()) continue;
+        r.sends.push_back(query_mp.NonBlockingSend(pair.second, pair.first));
+    }
+    r.incoming.assign(mp.NumberOfProcesses(), {});
+    r.receives.clear();
+    for (auto& pair : counts_from_ranks) {
+        long n = roundSize(round, round_count, pair.second);
+        if (0 == n) continue;
+        r.receives.push_back(query_mp.NonBlockingRecv(r.incoming[pair.first], int(n), pair.first));
+    }
+}
+
+void QueryPointPipeline::receiveArrivedReplies(MessagePasser reply_mp,
+                                               std::vector<ReceptorCollection>& replies) const {
+    for (auto probe = reply_mp.Probe(); probe.hasMessage(); probe = reply_mp.Probe()) {
+        MessagePasser::Message msg;
+        reply_mp.Recv(msg, probe.sourceRank());
+        replies.emplace_back();
+        replies.back().unpack(msg);
+    }
+}
+
+std::vector<ReceptorCollection> QueryPointPipeline::run(PackRound pack, SearchRound search) {
+    MessagePasser query_mp(mp.split(mp.getCommunicator(), 0));
+    MessagePasser reply_mp(mp.split(mp.getCommunicator(), 0));
+
+    std::array<Round, 2> rounds;
+    std::vector<MessagePasser::Promise> reply_sends;
+    std::map<int, std::vector<long>> reply_counts_for_ranks;
+    std::vector<ReceptorCollection> replies;
+
+    postRound(query_mp, 0, pack, rounds[0]);
+    for (int round = 0; round < round_count; round++) {
+        std::string s = "pipeline round " + std::to_string(round) + " of " + std::to_string(round_count);
+        Tracer::begin(s);
+        if (round + 1 < round_count) postRound(query_mp, round + 1, pack, rounds[(round + 1) % 2]);
+        auto& r = rounds[round % 2];
+        Tracer::begin("wait for query points");
+        for (auto& status : r.receives) status.wait();
+        Tracer::end("wait for query points");
+
+        auto replies_for_ranks = search(r.incoming);
+        r.incoming = std::vector<std::vector<TransferNode>>();
+        for (auto& pair : replies_for_ranks) {
+            MessagePasser::Message msg;
+            pair.second.pack(msg);
+            reply_sends.push_back(reply_mp.NonBlockingSend(std::move(msg), pair.first));
+            auto& count = reply_counts_for_ranks[pair.first];
+            if (count.empty()) count.push_back(0);
+            count.front()++;
+        }
+
+        for (auto& status : r.sends) status.wait();
+        r.outgoing.clear();
+        receiveArrivedReplies(reply_mp, replies);
+        Tracer::end(s);
+        Tracer::traceMemory();
+    }
+
+    Tracer::begin("drain replies");
+    long expected_replies = 0;
+    for (auto& pair : mp.Exchange(reply_counts_for_ranks)) expected_replies += pair.second.front();
+    while (long(replies.size()) < expected_replies) receiveArrivedReplies(reply_mp, replies);
+    for (auto& promise : reply_sends) promise.wait();
+    Tracer::end("drain replies");
+
+    query_mp.destroyComm();
+    reply_mp.destroyComm();
+    return replies;
+}
+
+}
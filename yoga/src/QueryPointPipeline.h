@@ -0,0 +1,65 @@
+#pragma once
+#include <MessagePasser/MessagePasser.h>
+#include <array>
+#include <functional>
+#include <map>
+#include <vector>
+#include "Receptor.h"
+#include "TransferNode.h"
+
+namespace YOGA {
+
+// Streams query points to the ranks that search them in rounds.
+//
+// Query points travel with nonblocking sends, so round k+1 is in flight while
+// round k is searched.  The replies of a round are sent back on their own
+// communicator as soon as the round is searched and are received between
+// rounds, so at most two rounds of query points are held at once and no round
+// waits for the slowest rank.
+//
+// The number of points sent to a rank in each round is fixed by the total sent
+// to it, split evenly over the rounds with LinearPartitioner, so receivers post
+// their receives with exact lengths.
+class QueryPointPipeline {
+  public:
+    // Returns the query points sent to each rank in a round.  There must be
+    // roundSize(round, round_count, total) of them, where total is the count
+    // given to the constructor for that rank.
+    using PackRound = std::function<std::map<int, std::vector<TransferNode>>(int round, int round_count)>;
+    // Searches the query points received from each rank and returns the
+    // replies for each rank.
+    using SearchRound =
+        std::function<std::map<int, ReceptorCollection>(const std::vector<std::vector<TransferNode>>&)>;
+
+    // Collective.  counts_for_ranks holds the total number of query points
+    // this rank sends to each rank.  No rank sends or receives more than
+    // max_points_per_round in a round.
+    QueryPointPipeline(MessagePasser mp, const std::map<int, long>& counts_for_ranks, long max_points_per_round);
+
+    // Collective.  Returns the replies from all ranks in arrival order.
+    std::vector<ReceptorCollection> run(PackRound pack, SearchRound search);
+
+    int roundCount() const { return round_count; }
+    static long roundSize(int round, int round_count, long total);
+
+    // Collective.  Free memory is shared by every rank on a node, so each rank
+    // budgets a quarter of its share for query points and replies in flight.
+    static long pointsPerRoundForAvailableMemory(MessagePasser mp);
+
+  private:
+    struct Round {
+        std::map<int, std::vector<TransferNode>> outgoing;
+        std::vector<std::vector<TransferNode>> incoming;
+        std::vector<MessagePasser::MessageStatus> sends;
+        std::vector<MessagePasser::MessageStatus> receives;
+    };
+
+    MessagePasser mp;
+    std::map<int, long> counts_from_ranks;
+    int round_count;
+
+    void postRound(MessagePasser query_mp, int round, const PackRound& pack, Round& r) const;
+    void receiveArrivedReplies(MessagePasser reply_mp, std::vector<ReceptorCollection>& replies) const;
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <MessagePasser/MessagePasser.h>
 #include <algorithm>
+#include "CompactPacking.h"
 namespace YOGA {
 
 struct CandidateDonor {
@@ -77,6 +78,22 @@ class ReceptorCollection{
         }
     }
 
+    // Appends all receptors of another collection, keeping their order.
+    void append(const ReceptorCollection& other){
+        int offset = getIndex();
+        gids.insert(gids.end(),other.gids.begin(),other.gids.end());
+        owners.insert(owners.end(),other.owners.begin(),other.owners.end());
+        distance.insert(distance.end(),other.distance.begin(),other.distance.end());
+        donor_counts.insert(donor_counts.end(),other.donor_counts.begin(),other.donor_counts.end());
+        for(int idx:other.index_of_first_donor)
+            index_of_first_donor.push_back(offset+idx);
+        donor_owning_ranks.insert(donor_owning_ranks.end(),other.donor_owning_ranks.begin(),other.donor_owning_ranks.end());
+        donor_cell_ids.insert(donor_cell_ids.end(),other.donor_cell_ids.begin(),other.donor_cell_ids.end());
+        donor_component_ids.insert(donor_component_ids.end(),other.donor_component_ids.begin(),other.donor_component_ids.end());
+        donor_cell_type.insert(donor_cell_type.end(),other.donor_cell_type.begin(),other.donor_cell_type.end());
+        donor_distance.insert(donor_distance.end(),other.donor_distance.begin(),other.donor_distance.end());
+    }
+
     Receptor get(int i){
         Receptor r;
         r.globalId = gids[i];
@@ -96,29 +113,49 @@ class ReceptorCollection{
         return r;
     }
 
-    void pack(MessagePasser::Message& msg){
-        msg.pack(gids);
-        msg.pack(owners);
-        msg.pack(distance);
-        msg.pack(donor_counts);
-        msg.pack(index_of_first_donor);
-        msg.pack(donor_owning_ranks);
-        msg.pack(donor_cell_ids);
-        msg.pack(donor_component_ids);
-        msg.pack(donor_cell_type);
-        msg.pack(donor_distance);
+    // Receptors are sent in global id order, with ids as gaps from the previous
+    // one and integers as variable-length bytes.  Distances are compared
+    // exactly during type assignment, so they stay in double precision.
+    void pack(MessagePasser::Message& msg) const {
+        CompactPacking::packUnsigned(msg, gids.size());
+        long previous = 0;
+        for (int i : CompactPacking::increasingOrder(gids)) {
+            CompactPacking::packSigned(msg, gids[i] - previous);
+            previous = gids[i];
+            CompactPacking::packSigned(msg, owners[i]);
+            msg.pack(distance[i]);
+            CompactPacking::packUnsigned(msg, donor_counts[i]);
+            for (int j = index_of_first_donor[i]; j < index_of_first_donor[i] + donor_counts[i]; j++) {
+                CompactPacking::packSigned(msg, donor_owning_ranks[j]);
+                CompactPacking::packSigned(msg, donor_cell_ids[j]);
+                CompactPacking::packSigned(msg, donor_component_ids[j]);
+                CompactPacking::packSigned(msg, donor_cell_type[j]);
+                msg.pack(donor_distance[j]);
+            }
+        }
     }
     void unpack(MessagePasser::Message& msg){
-        msg.unpack(gids);
-        msg.unpack(owners);
-        msg.unpack(distance);
-        msg.unpack(donor_counts);
-        msg.unpack(index_of_first_donor);
-        msg.unpack(donor_owning_ranks);
-        msg.unpack(donor_cell_ids);
-        msg.unpack(donor_component_ids);
-        msg.unpack(donor_cell_type);
-        msg.unpack(donor_distance);
+        *this = ReceptorCollection();
+        size_t n = CompactPacking::unpackUnsigned(msg);
+        long previous = 0;
+        for (size_t i = 0; i < n; i++) {
+            index_of_first_donor.push_back(getIndex());
+            previous += CompactPacking::unpackSigned(msg);
+            gids.push_back(previous);
+            owners.push_back(int(CompactPacking::unpackSigned(msg)));
+            distance.push_back(0.0);
+            msg.unpack(distance.back());
+            int count = int(CompactPacking::unpackUnsigned(msg));
+            donor_counts.push_back(count);
+            for (int j = 0; j < count; j++) {
+                donor_owning_ranks.push_back(int(CompactPacking::unpackSigned(msg)));
+                donor_cell_ids.push_back(int(CompactPacking::unpackSigned(msg)));
+                donor_component_ids.push_back(int(CompactPacking::unpackSigned(msg)));
+                donor_cell_type.push_back(int(CompactPacking::unpackSigned(msg)));
+                donor_distance.push_back(0.0);
+                msg.unpack(donor_distance.back());
+            }
+        }
     }
   private:
     std::vector<long> gids;
@@ -1,8 +1,18 @@
 #include "ScalableHoleMap.h"
+#include <parfait/ExtentBuilder.h>
+#include <parfait/LinearPartitioner.h>
+#include <algorithm>
 
 namespace YOGA {
 bool ScalableHoleMap::doesOverlapHole(Parfait::Extent<double>& e) const {
-    auto slice = block.getRangeOfOverlappingCells(e);
+    auto slice = block.getRangeOfOverlappingCells(has_body_frame ? moveToBodyFrame(e) : e);
+    if (is_distributed) {
+        int ny = block.numberOfCells_Y();
+        for (int k = slice.lo[2]; k < slice.hi[2]; k++)
+            for (int j = slice.lo[1]; j < slice.hi[1]; j++)
+                if (doesOverlapHoleRun(j + k * ny, slice.lo[0], slice.hi[0])) return true;
+        return false;
+    }
     for (int i = slice.lo[0]; i < slice.hi[0]; i++) {
         for (int j = slice.lo[1]; j < slice.hi[1]; j++) {
             for (int k = slice.lo[2]; k < slice.hi[2]; k++) {
@@ -15,7 +25,29 @@ bool ScalableHoleMap::doesOverlapHole(Parfait::Extent<double>& e) const {
     return false;
 }
 
-void ScalableHoleMap::blankLocally() {
+bool ScalableHoleMap::doesOverlapHoleRun(int line, int i_begin, int i_end) const {
+    for (int r = line_offsets[line]; r < line_offsets[line + 1]; r++)
+        if (run_begin[r] < i_end and i_begin < run_end[r]) return true;
+    return false;
+}
+
+// A rotated box is no longer axis aligned, so the query is replaced by the
+// axis-aligned box around its 8 moved corners.  That box contains every point of
+// the moved query, so the answer can only gain hole cells: a query may be
+// reported as overlapping the hole when it doesn't, never the reverse.
+Parfait::Extent<double> ScalableHoleMap::moveToBodyFrame(const Parfait::Extent<double>& e) const {
+    auto moved = Parfait::ExtentBuilder::createEmptyBuildableExtent<double>();
+    for (int corner = 0; corner < 8; corner++) {
+        Parfait::Point<double> p{corner & 1 ? e.hi[0] : e.lo[0],
+                                 corner & 2 ? e.hi[1] : e.lo[1],
+                                 corner & 4 ? e.hi[2] : e.lo[2]};
+        to_body_frame.movePoint(p);
+        Parfait::ExtentBuilder::add(moved, p);
+    }
+    return moved;
+}
+
+void ScalableHoleMap::blankLocally(const PartitionInfo& partition_info) {
     for (int i = 0; i < mesh.numberOfBoundaryFaces(); i++)
         if (partition_info.getAssociatedComponentIdForFace(i) == associatedComponentId)
             if (Solid == mesh.getBoundaryCondition(i)) blankWithExtent(partition_info.getExtentForFace(i));
@@ -23,14 +55,47 @@ void ScalableHoleMap::blankLocally() {
 
 void ScalableHoleMap::blankWithExtent(const Parfait::Extent<double>& e) {
     auto ids = block.getCellIdsInExtent(e);
+    if (is_distributed) {
+        crossing_cells.insert(crossing_cells.end(), ids.begin(), ids.end());
+        return;
+    }
     for (auto& id : ids) cell_statuses[id] = CartBlockFloodFill::Crossing;
 }
 
 void ScalableHoleMap::sync() {
-    cell_statuses = mp.ElementalMax(cell_statuses);
+    if (is_distributed)
+        syncCrossingCellsToSlabs();
+    else
+        cell_statuses = mp.ElementalMax(cell_statuses);
+}
+
+int ScalableHoleMap::slabOwner(int k) const {
+    return int(Parfait::LinearPartitioner::getWorkerOfWorkItem(k, block.numberOfCells_Z(), mp.NumberOfProcesses()));
+}
+
+void ScalableHoleMap::syncCrossingCellsToSlabs() {
+    auto slab = Parfait::LinearPartitioner::getRangeForWorker(mp.Rank(), block.numberOfCells_Z(), mp.NumberOfProcesses());
+    slab_begin = int(slab.start);
+    slab_end = int(slab.end);
+    int plane_size = block.numberOfCells_X() * block.numberOfCells_Y();
+
+    std::sort(crossing_cells.begin(), crossing_cells.end());
+    crossing_cells.erase(std::unique(crossing_cells.begin(), crossing_cells.end()), crossing_cells.end());
+    std::map<int, std::vector<int>> cells_for_owners;
+    for (int id : crossing_cells) cells_for_owners[slabOwner(id / plane_size)].push_back(id);
+    crossing_cells = std::vector<int>();
+
+    slab_statuses.assign(plane_size * (slab_end - slab_begin), CartBlockFloodFill::Untouched);
+    int offset = slab_begin * plane_size;
+    for (auto& cells_from_rank : mp.Exchange(cells_for_owners))
+        for (int id : cells_from_rank.second) slab_statuses[id - offset] = CartBlockFloodFill::Crossing;
 }
 
 void ScalableHoleMap::floodFill() {
+    if (is_distributed) {
+        floodFillSlab();
+        return;
+    }
     auto seeds = CartBlockFloodFill::identifyAndMarkOuterCells(block, cell_statuses);
     SymmetryFinder symmetryFinder(mp, mesh);
     auto planes = symmetryFinder.findSymmetryPlanes();
@@ -43,4 +108,126 @@ void ScalableHoleMap::floodFill() {
     CartBlockFloodFill::stackFill(seeds, block, cell_statuses);
 }
 
+void ScalableHoleMap::floodFillSlab() {
+    SymmetryFinder symmetryFinder(mp, mesh);
+    auto planes = symmetryFinder.findSymmetryPlanes();
+    bool has_symmetry_plane = false;
+    Parfait::Extent<double> symmetry_plane_extent;
+    for (auto plane : planes) {
+        if (plane.componentId() == associatedComponentId) {
+            symmetry_plane_extent = CartBlockFloodFill::getPlaneExtent(plane, block);
+            has_symmetry_plane = true;
+            break;
+        }
+    }
+
+    const int nx = block.numberOfCells_X();
+    const int ny = block.numberOfCells_Y();
+    const int nz = block.numberOfCells_Z();
+    int offset = slab_begin * nx * ny;
+    std::vector<int> seeds;
+    std::vector<int> newly_out;
+    for (int k = slab_begin; k < slab_end; k++) {
+        for (int j = 0; j < ny; j++) {
+            for (int i = 0; i < nx; i++) {
+                bool is_outer = 0 == i or 0 == j or 0 == k or nx - 1 == i or ny - 1 == j or nz - 1 == k;
+                if (not is_outer) continue;
+                int id = block.convert_ijk_ToCellId(i, j, k);
+                if (CartBlockFloodFill::Untouched != slab_statuses[id - offset]) continue;
+                if (has_symmetry_plane and symmetry_plane_extent.intersects(block.createExtentFromCell(id))) continue;
+                slab_statuses[id - offset] = CartBlockFloodFill::OutOfHole;
+                seeds.push_back(id);
+                newly_out.push_back(id);
+            }
+        }
+    }
+    fillSlabFromSeeds(seeds, newly_out);
+
+    auto cells_for_neighbors = cellsAcrossSlabFaces(newly_out);
+    while (mp.ParallelOr(not cells_for_neighbors.empty())) {
+        auto cells_from_neighbors = mp.Exchange(cells_for_neighbors);
+        newly_out.clear();
+        for (auto& cells_from_rank : cells_from_neighbors) {
+            for (int id : cells_from_rank.second) {
+                if (CartBlockFloodFill::Untouched == slab_statuses[id - offset]) {
+                    slab_statuses[id - offset] = CartBlockFloodFill::OutOfHole;
+                    seeds.push_back(id);
+                    newly_out.push_back(id);
+                }
+            }
+        }
+        fillSlabFromSeeds(seeds, newly_out);
+        cells_for_neighbors = cellsAcrossSlabFaces(newly_out);
+    }
+
+    for (auto& s : slab_statuses)
+        if (CartBlockFloodFill::Untouched == s) s = CartBlockFloodFill::InHole;
+    shareHoleRuns();
+}
+
+void ScalableHoleMap::fillSlabFromSeeds(std::vector<int>& seeds, std::vector<int>& newly_out) {
+    int plane_size = block.numberOfCells_X() * block.numberOfCells_Y();
+    int offset = slab_begin * plane_size;
+    while (not seeds.empty()) {
+        int cell = seeds.back();
+        seeds.pop_back();
+        for (int id : CartBlockFloodFill::getNeighbors(cell, block)) {
+            int k = id / plane_size;
+            if (k < slab_begin or k >= slab_end) continue;
+            if (CartBlockFloodFill::Untouched == slab_statuses[id - offset]) {
+                slab_statuses[id - offset] = CartBlockFloodFill::OutOfHole;
+                seeds.push_back(id);
+                newly_out.push_back(id);
+            }
+        }
+    }
+}
+
+std::map<int, std::vector<int>> ScalableHoleMap::cellsAcrossSlabFaces(const std::vector<int>& newly_out) const {
+    int plane_size = block.numberOfCells_X() * block.numberOfCells_Y();
+    std::map<int, std::vector<int>> cells_for_neighbors;
+    for (int id : newly_out) {
+        int k = id / plane_size;
+        if (k == slab_begin and k > 0) cells_for_neighbors[slabOwner(k - 1)].push_back(id - plane_size);
+        if (k == slab_end - 1 and k + 1 < block.numberOfCells_Z())
+            cells_for_neighbors[slabOwner(k + 1)].push_back(id + plane_size);
+    }
+    return cells_for_neighbors;
+}
+
+void ScalableHoleMap::shareHoleRuns() {
+    const int nx = block.numberOfCells_X();
+    const int ny = block.numberOfCells_Y();
+    std::vector<int> local_runs;
+    for (int k = slab_begin; k < slab_end; k++) {
+        for (int j = 0; j < ny; j++) {
+            const int* line = &slab_statuses[(k - slab_begin) * nx * ny + j * nx];
+            for (int i = 0; i < nx;) {
+                if (CartBlockFloodFill::OutOfHole == line[i]) {
+                    i++;
+                    continue;
+                }
+                int begin = i;
+                while (i < nx and CartBlockFloodFill::OutOfHole != line[i]) i++;
+                local_runs.insert(local_runs.end(), {j + k * ny, begin, i});
+            }
+        }
+    }
+    slab_statuses = std::vector<int>();
+
+    // Slabs are ordered by rank, so the gathered runs are already sorted by line.
+    std::vector<int> runs;
+    std::vector<int> rank_offsets;
+    mp.Gather(local_runs, runs, rank_offsets);
+    line_offsets.assign(ny * block.numberOfCells_Z() + 1, 0);
+    run_begin.clear();
+    run_end.clear();
+    for (size_t r = 0; r < runs.size(); r += 3) {
+        line_offsets[runs[r] + 1]++;
+        run_begin.push_back(runs[r + 1]);
+        run_end.push_back(runs[r + 2]);
+    }
+    for (size_t i = 1; i < line_offsets.size(); i++) line_offsets[i] += line_offsets[i - 1];
+}
+
 }
@@ -3,7 +3,9 @@
 #include <MessagePasser/MessagePasser.h>
 #include <parfait/CartBlock.h>
 #include <parfait/Extent.h>
+#include <parfait/MotionMatrix.h>
 #include <Tracer.h>
+#include <map>
 #include <vector>
 #include "CartBlockFloodFill.h"
 #include "MeshSystemInfo.h"
@@ -14,18 +16,35 @@
 
 namespace YOGA {
 
+// Cartesian map of the cells of a body's extent that cross or lie inside it.
+//
+// By default every rank holds the whole block: crossing cells are combined with
+// an allreduce and every rank flood fills the full block.  In distributed mode
+// each rank owns a slab of k-planes instead.  Crossing cells are sent only to
+// the rank that owns them, the flood fill runs on the slabs and trades
+// OutOfHole cells across slab faces until nothing changes, and the resulting
+// hole cells are shared as runs along i, so no rank stores the dense block.
+//
+// A map can be kept across rigid motion of its body: setBodyFrame() gives the
+// motion that takes the current inertial frame back to the pose the map was
+// built in, and queries are moved by it before they are looked up.
 class ScalableHoleMap {
   public:
-    ScalableHoleMap(
-        MessagePasser mp, const YogaMesh& m, const PartitionInfo& info, const MeshSystemInfo& info2, int indexOfBody, int max_cells)
+    ScalableHoleMap(MessagePasser mp,
+                    const YogaMesh& m,
+                    const PartitionInfo& info,
+                    const MeshSystemInfo& info2,
+                    int indexOfBody,
+                    int max_cells,
+                    bool distributed = false)
         : mp(mp),
           associatedComponentId(info2.getComponentIdForBody(indexOfBody)),
           mesh(m),
-          partition_info(info),
           block(generateCartBlock(info2.getBodyExtent(indexOfBody),max_cells)),
-          cell_statuses(block.numberOfCells(), CartBlockFloodFill::Untouched) {
+          is_distributed(distributed) {
+        if (not is_distributed) cell_statuses.assign(block.numberOfCells(), CartBlockFloodFill::Untouched);
         Tracer::begin("blank");
-        blankLocally();
+        blankLocally(info);
         Tracer::end("blank");
         Tracer::begin("sync");
         sync();
@@ -37,18 +56,42 @@ class ScalableHoleMap {
 
     bool doesOverlapHole(Parfait::Extent<double>& e) const;
     int getAssociatedComponentId() const { return associatedComponentId; }
+    void setBodyFrame(const Parfait::MotionMatrix& inertial_to_body) {
+        to_body_frame = inertial_to_body;
+        has_body_frame = true;
+    }
 
   //private:
     MessagePasser mp;
     int associatedComponentId;
     const YogaMesh& mesh;
-    const PartitionInfo& partition_info;
     Parfait::CartBlock block;
     std::vector<int> cell_statuses;
+    bool is_distributed;
+    bool has_body_frame = false;
+    Parfait::MotionMatrix to_body_frame;
+
+    // distributed mode
+    int slab_begin = 0;
+    int slab_end = 0;
+    std::vector<int> crossing_cells;
+    std::vector<int> slab_statuses;
+    std::vector<int> line_offsets;
+    std::vector<int> run_begin;
+    std::vector<int> run_end;
 
-    void blankLocally();
+    void blankLocally(const PartitionInfo& partition_info);
+    Parfait::Extent<double> moveToBodyFrame(const Parfait::Extent<double>& e) const;
     void floodFill();
     void blankWithExtent(const Parfait::Extent<double>& e);
     void sync();
+
+    bool doesOverlapHoleRun(int line, int i_begin, int i_end) const;
+    int slabOwner(int k) const;
+    void syncCrossingCellsToSlabs();
+    void floodFillSlab();
+    void fillSlabFromSeeds(std::vector<int>& seeds, std::vector<int>& newly_out);
+    std::map<int, std::vector<int>> cellsAcrossSlabFaces(const std::vector<int>& newly_out) const;
+    void shareHoleRuns();
 };
 }
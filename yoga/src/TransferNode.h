@@ -1,5 +1,7 @@
 #pragma once
+#include <MessagePasser/MessagePasser.h>
 #include <parfait/Point.h>
+#include <vector>
 #include "BoundaryConditions.h"
 namespace YOGA {
 
@@ -26,4 +28,60 @@ struct TransferNode {
     int owningRank;
     double distanceToWall;
 };
+
+// The members of many TransferNodes, one array each.  A fragment's nodes are
+// sent as five contiguous buffers, and searches only stream the arrays they
+// read (usually just xyz).
+class TransferNodes {
+  public:
+    std::vector<long> globalIds;
+    std::vector<Parfait::Point<double>> xyz;
+    std::vector<int> associatedComponentIds;
+    std::vector<int> owningRanks;
+    std::vector<double> distancesToWall;
+
+    size_t size() const { return globalIds.size(); }
+    bool empty() const { return globalIds.empty(); }
+
+    void resize(size_t n) {
+        globalIds.resize(n);
+        xyz.resize(n);
+        associatedComponentIds.resize(n);
+        owningRanks.resize(n);
+        distancesToWall.resize(n);
+    }
+
+    void set(size_t i, const TransferNode& node) {
+        globalIds[i] = node.globalId;
+        xyz[i] = node.xyz;
+        associatedComponentIds[i] = node.associatedComponentId;
+        owningRanks[i] = node.owningRank;
+        distancesToWall[i] = node.distanceToWall;
+    }
+
+    void push_back(const TransferNode& node) {
+        resize(size() + 1);
+        set(size() - 1, node);
+    }
+
+    TransferNode operator[](size_t i) const {
+        return TransferNode(globalIds[i], xyz[i], distancesToWall[i], associatedComponentIds[i], owningRanks[i]);
+    }
+
+    static void pack(MessagePasser::Message& msg, const TransferNodes& nodes) {
+        msg.pack(nodes.globalIds);
+        msg.pack(nodes.xyz);
+        msg.pack(nodes.associatedComponentIds);
+        msg.pack(nodes.owningRanks);
+        msg.pack(nodes.distancesToWall);
+    }
+
+    static void unpack(MessagePasser::Message& msg, TransferNodes& nodes) {
+        msg.unpack(nodes.globalIds);
+        msg.unpack(nodes.xyz);
+        msg.unpack(nodes.associatedComponentIds);
+        msg.unpack(nodes.owningRanks);
+        msg.unpack(nodes.distancesToWall);
+    }
+};
 }
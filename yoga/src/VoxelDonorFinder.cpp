@@ -32,7 +32,7 @@ std::vector<bool> VoxelDonorFinder::flagNodesOutsideVoxel(WorkVoxel& w) {
 std::vector<Receptor> VoxelDonorFinder::buildCandidateReceptors(
     WorkVoxel& workVoxel,
     const std::vector<std::vector<CandidateDonor>>& candidateDonors,
-    const std::vector<std::set<int>>& n2n) {
+    const Parfait::CompressedRowGraph& n2n) {
     std::vector<Receptor> candidateReceptors;
     for (size_t i = 0; i < candidateDonors.size(); ++i) {
         if (candidateDonors[i].size() > 0) {
@@ -52,7 +52,7 @@ std::vector<Receptor> VoxelDonorFinder::buildCandidateReceptors(
 }
 std::vector<Receptor> VoxelDonorFinder::getCandidateReceptors(WorkVoxel& workVoxel,
                                                               const Parfait::Extent<double>& extent,
-                                                              const std::vector<std::set<int>>& n2n) {
+                                                              const Parfait::CompressedRowGraph& n2n) {
     auto is_node_outside_voxel = flagNodesOutsideVoxel(workVoxel);
     auto candidate_donors = buildCandidateDonorList(workVoxel,is_node_outside_voxel);
     return buildCandidateReceptors(workVoxel,candidate_donors,n2n);
@@ -1,4 +1,5 @@
 #pragma once
+#include <parfait/CompressedRowGraph.h>
 #include "AdtDonorFinder.h"
 #include "Receptor.h"
 #include "ScalableHoleMap.h"
@@ -10,7 +11,7 @@ class VoxelDonorFinder {
     static std::vector<Receptor> getCandidateReceptors(
         WorkVoxel& workVoxel,
         const Parfait::Extent<double>& extent,
-        const std::vector<std::set<int>>& n2n);
+        const Parfait::CompressedRowGraph& n2n);
     //1static std::vector<int> getLocalIdsOfInterpolationBoundaryNodes(std::vector<TransferNode>& nodes);
     static std::vector<bool> flagNodesOutsideVoxel(WorkVoxel& w);
 
@@ -21,7 +22,7 @@ class VoxelDonorFinder {
     static std::vector<Receptor> buildCandidateReceptors(
         WorkVoxel& workVoxel,
         const std::vector<std::vector<CandidateDonor>>& candidateDonors,
-        const std::vector<std::set<int>>& n2n);
+        const Parfait::CompressedRowGraph& n2n);
 };
 
 }
@@ -29,8 +29,8 @@ class VoxelFragment {
        fillFragment(m,node_bcs,overlapping_cell_ids,rank);
     }
 
-    static void pack(MessagePasser::Message& msg,VoxelFragment& fragment){
-        msg.pack(fragment.transferNodes);
+    static void pack(MessagePasser::Message& msg,const VoxelFragment& fragment){
+        TransferNodes::pack(msg,fragment.transferNodes);
         msg.pack(fragment.transferTets);
         msg.pack(fragment.transferPyramids);
         msg.pack(fragment.transferPrisms);
@@ -38,7 +38,7 @@ class VoxelFragment {
 
     }
     static void unpack(MessagePasser::Message& msg,VoxelFragment& fragment){
-        msg.unpack(fragment.transferNodes);
+        TransferNodes::unpack(msg,fragment.transferNodes);
         msg.unpack(fragment.transferTets);
         msg.unpack(fragment.transferPyramids);
         msg.unpack(fragment.transferPrisms);
@@ -66,10 +66,12 @@ class VoxelFragment {
         transferNodes.resize(nodes_in_fragment);
         for (int i = 0; i < m.nodeCount(); ++i) {
             if (fragment_node_id[i] != NOT_IN_FRAGMENT) {
-                transferNodes[fragment_node_id[i]] = TransferNode(m.globalNodeId(i),
-                                                                  m.getNode<double>(i),
-                                                                  0.0,
-                                                                  m.getAssociatedComponentId(i), m.nodeOwner(i));
+                int id = fragment_node_id[i];
+                transferNodes.globalIds[id] = m.globalNodeId(i);
+                transferNodes.xyz[id] = m.getNode<double>(i);
+                transferNodes.associatedComponentIds[id] = m.getAssociatedComponentId(i);
+                transferNodes.owningRanks[id] = m.nodeOwner(i);
+                transferNodes.distancesToWall[id] = 0.0;
             }
         }
         transferTets.resize(counts.tet);
@@ -84,7 +86,7 @@ class VoxelFragment {
         }
     }
 
-    std::vector<TransferNode> transferNodes;
+    TransferNodes transferNodes;
     std::vector<TransferCell<4>> transferTets;
     std::vector<TransferCell<5>> transferPyramids;
     std::vector<TransferCell<6>> transferPrisms;
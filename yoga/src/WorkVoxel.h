@@ -1,8 +1,9 @@
 #pragma once
 
-#include <map>
 #include <mutex>
 #include <vector>
+#include "IdMap.h"
+#include "MortonOrdering.h"
 #include "TransferNode.h"
 #include "VoxelFragment.h"
 
@@ -19,18 +20,19 @@ class WorkVoxel {
         tets.reserve(2*n);
     }
     const Parfait::Extent<double> extent;
-    std::map<long, int> global_to_local;
+    IdMap global_to_local;
     std::function<bool(double*,int,double*)> is_in_cell;
 
-    void addNodes(const std::vector<TransferNode>& moreNodes,std::vector<int>& new_local_ids);
-    void addTets(const std::vector<TransferCell<4>>& moreTets, const std::vector<TransferNode>& transfer_nodes,
+    void addNodes(const TransferNodes& moreNodes,std::vector<int>& new_local_ids);
+    void addTets(const std::vector<TransferCell<4>>& moreTets, const TransferNodes& transfer_nodes,
         const std::vector<int>& new_local_ids);
-    void addPyramids(const std::vector<TransferCell<5>>& morePyramids, const std::vector<TransferNode>& transfer_nodes,
+    void addPyramids(const std::vector<TransferCell<5>>& morePyramids, const TransferNodes& transfer_nodes,
         const std::vector<int>& new_local_ids);
-    void addPrisms(const std::vector<TransferCell<6>>& morePrisms, const std::vector<TransferNode>& transfer_nodes,
+    void addPrisms(const std::vector<TransferCell<6>>& morePrisms, const TransferNodes& transfer_nodes,
         const std::vector<int>& new_local_ids);
-    void addHexs(const std::vector<TransferCell<8>>& moreHexs, const std::vector<TransferNode>& transfer_nodes,
+    void addHexs(const std::vector<TransferCell<8>>& moreHexs, const TransferNodes& transfer_nodes,
         const std::vector<int>& new_local_ids);
+    void sortCellsByMortonKey();
 
     std::vector<TransferNode> nodes;
     std::vector<TransferCell<4>> tets;
@@ -39,6 +41,19 @@ class WorkVoxel {
     std::vector<TransferCell<8>> hexs;
 
   private:
+    template <int N>
+    void sortByMortonKey(std::vector<TransferCell<N>>& cells) const {
+        std::vector<uint64_t> keys(cells.size());
+        for (size_t i = 0; i < cells.size(); i++) {
+            Parfait::Point<double> centroid{0, 0, 0};
+            for (int id : cells[i].nodeIds) centroid += nodes[id].xyz;
+            keys[i] = mortonKeyInExtent(extent, centroid / double(N));
+        }
+        std::vector<TransferCell<N>> sorted;
+        sorted.reserve(cells.size());
+        for (int i : orderByKey(keys)) sorted.push_back(cells[i]);
+        cells.swap(sorted);
+    }
     template <int N>
     void convertToWorkCell(std::array<int, N>& cell, const std::vector<int>& new_local_ids) {
         for (int i = 0; i < N; ++i) {
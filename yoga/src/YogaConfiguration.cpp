@@ -2,6 +2,7 @@
 #include <parfait/FileTools.h>
 #include <parfait/StringTools.h>
 #include <unistd.h>
+#include <algorithm>
 #include <fstream>
 #include <set>
 #include <string>
@@ -95,6 +96,8 @@ void YogaConfiguration::processKeyWord(int& index, const std::vector<std::string
         if (Parfait::StringTools::isInteger(word)) {
             max_hole_map_cells = std::atoi(word.c_str());
         }
+    } else if ("distributed-hole-map" == keyword) {
+        should_use_distributed_hole_map = true;
     } else if ("max-receptors" == keyword) {
         use_max_donors = true;
     } else if ("load-balancer" == keyword) {
@@ -106,6 +109,21 @@ void YogaConfiguration::processKeyWord(int& index, const std::vector<std::string
         should_dump_stats = true;
     } else if ("zmq-path" == keyword) {
         should_use_zmq_path = true;
+    } else if ("donor-warm-start" == keyword) {
+        should_warm_start_donor_search = true;
+    } else if ("morton-ordered-donor-search" == keyword) {
+        should_morton_order_donor_search = true;
+    } else if ("body-frame-search-structures" == keyword) {
+        should_keep_body_frame_search_structures = true;
+    } else if ("donor-search-threads" == keyword) {
+        auto word = words[++index];
+        if (Parfait::StringTools::isInteger(word)) {
+            donor_search_threads = std::max(1, std::atoi(word.c_str()));
+        }
+    } else if ("pipelined-donor-search" == keyword) {
+        should_pipeline_donor_search = true;
+    } else if ("quiet-type-assignment" == keyword) {
+        should_defer_status_counts = true;
     }
     else if("trace-basename" == keyword){
         trace_basename = words[++index];
@@ -151,10 +169,17 @@ std::set<std::string> YogaConfiguration::getOptionList() const {
             "donor-algorithm",
             "max-receptors",
             "max-hole-map-cells",
+            "distributed-hole-map",
             "load-balancer",
             "target-voxel-size",
             "dump-stats",
             "zmq-path",
+            "donor-warm-start",
+            "morton-ordered-donor-search",
+            "body-frame-search-structures",
+            "donor-search-threads",
+            "pipelined-donor-search",
+            "quiet-type-assignment",
             "extra-layers-for-interpolation-bcs",
             "trace-basename",
             "rcb",
@@ -166,16 +191,31 @@ void YogaConfiguration::setDefaults() {
     use_max_donors = false;
     load_balancer_algorithm = 0;
     max_hole_map_cells = 8000;
+    should_use_distributed_hole_map = false;
     target_voxel_size = 25000;
     extra_receptors_for_interp_bcs = 1;
     should_dump_stats = false;
     should_use_zmq_path = false;
+    should_warm_start_donor_search = false;
+    should_morton_order_donor_search = false;
+    should_keep_body_frame_search_structures = false;
+    donor_search_threads = 1;
+    should_pipeline_donor_search = false;
+    should_defer_status_counts = false;
     should_dump_part_file = false;
     trace_basename = "yoga";
     rcb_agglom_size = 256;
 }
 bool YogaConfiguration::shouldDumpStats() const { return should_dump_stats; }
 bool YogaConfiguration::shouldUseZMQPath() const { return should_use_zmq_path; }
+bool YogaConfiguration::shouldWarmStartDonorSearch() const { return should_warm_start_donor_search; }
+bool YogaConfiguration::shouldMortonOrderDonorSearch() const { return should_morton_order_donor_search; }
+bool YogaConfiguration::shouldKeepBodyFrameSearchStructures() const {
+    return should_keep_body_frame_search_structures;
+}
+int YogaConfiguration::donorSearchThreadCount() const { return donor_search_threads; }
+bool YogaConfiguration::shouldPipelineDonorSearch() const { return should_pipeline_donor_search; }
+bool YogaConfiguration::shouldDeferStatusCounts() const { return should_defer_status_counts; }
 int YogaConfiguration::rcbAgglomerationSize() const {
     return rcb_agglom_size;
 }
@@ -190,4 +230,5 @@ std::vector<int> YogaConfiguration::getComponentGridImportance() const {
     return grid_importance;
 }
 int YogaConfiguration::maxHoleMapCells() const { return max_hole_map_cells; }
+bool YogaConfiguration::shouldUseDistributedHoleMap() const { return should_use_distributed_hole_map; }
 }
\ No newline at end of file
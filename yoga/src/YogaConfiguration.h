@@ -16,9 +16,16 @@ class YogaConfiguration {
     int selectedLoadBalancer() const;
     int selectedTargetVoxelSize() const;
     int maxHoleMapCells() const;
+    bool shouldUseDistributedHoleMap() const;
     bool shouldAddExtraReceptors() const;
     bool shouldDumpStats() const;
     bool shouldUseZMQPath() const;
+    bool shouldWarmStartDonorSearch() const;
+    bool shouldMortonOrderDonorSearch() const;
+    bool shouldKeepBodyFrameSearchStructures() const;
+    int donorSearchThreadCount() const;
+    bool shouldPipelineDonorSearch() const;
+    bool shouldDeferStatusCounts() const;
     int numberOfExtraLayersForInterpBcs() const;
     int rcbAgglomerationSize() const;
     bool shouldDumpPartFile() const;
@@ -29,10 +36,17 @@ class YogaConfiguration {
     int load_balancer_algorithm;
     int target_voxel_size;
     int max_hole_map_cells;
+    bool should_use_distributed_hole_map;
     int rcb_agglom_size;
     bool use_max_donors;
     bool should_dump_stats;
     bool should_use_zmq_path;
+    bool should_warm_start_donor_search;
+    bool should_morton_order_donor_search;
+    bool should_keep_body_frame_search_structures;
+    int donor_search_threads;
+    bool should_pipeline_donor_search;
+    bool should_defer_status_counts;
     bool should_dump_part_file;
     bool should_dump_partition_extents;
     int extra_receptors_for_interp_bcs;
@@ -3,9 +3,11 @@
 #include <parfait/CellContainmentChecker.h>
 #include "CellContainmentWrapper.h"
 #include "OversetData.h"
+#include "PersistentAssembly.h"
 #include "WeightBasedInterpolator.h"
 #include "YogaMesh.h"
 #include "FUN3DAdjointData.h"
+#include "InterpolationOperator.h"
 #include <DomainConnectivityInfo.h>
 
 namespace YOGA {
@@ -28,12 +30,13 @@ class YogaInstance {
               return Parfait::CellContainmentChecker::isInCell_c(vertices, nvertices, p);
           }),
           calcWeightsForReceptor(&calcWeightsWithLeastSquares),
-          solution_at_nodes(nSolutionVariables * mesh.nodeCount()) {}
+          solution_at_nodes(nSolutionVariables * mesh.nodeCount()),
+          persistent_assembly(mp, mesh) {}
     MessagePasser mp;
     YogaMesh mesh;
     bool is_complex;
     std::shared_ptr<OversetData> oversetData = nullptr;
-    std::shared_ptr<Interpolator<double>> interpolator = nullptr;
+    std::shared_ptr<InterpolationOperator> interpolation_operator = nullptr;
     std::shared_ptr<Interpolator<std::complex<double>>> interpolator_complex = nullptr;
     std::shared_ptr<FUN3DAdjointData<double>> fun3d_adjoint_data = nullptr;
     std::shared_ptr<FUN3DAdjointData<std::complex<double>>> fun3d_adjoint_data_complex = nullptr;
@@ -45,6 +48,7 @@ class YogaInstance {
     std::vector<double> solution_at_nodes;
     std::map<int, std::vector<YOGA::InverseReceptor<double>>> inverse_receptors;
     std::map<int, std::vector<YOGA::InverseReceptor<std::complex<double>>>> inverse_receptors_complex;
+    PersistentAssembly persistent_assembly;
 
   private:
 };
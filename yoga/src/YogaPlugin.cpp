@@ -7,7 +7,7 @@
 #include <parfait/CellContainmentChecker.h>
 #include <parfait/Checkpoint.h>
 #include "DistanceFieldAdapter.h"
-#include "ParallelSurface.h"
+#include "InterpolationOperator.h"
 #include "ReceptorUpdate.h"
 #include "GraphColoring.h"
 #include "ParallelColorCombinator.h"
@@ -24,7 +24,7 @@ using namespace inf;
 using namespace YOGA;
 
 YogaPlugin::YogaPlugin(MessagePasser mp, const MeshInterface& m, int component_id, std::string bc_string)
-    : mp(mp), mesh() {
+    : mp(mp), mesh(), assembly(mp, mesh) {
     YOGA::MeshInterfaceAdapter adapter(mp, m, component_id, createBoundaryConditionVector(m, bc_string, component_id));
 
     std::set<int> available_tags;
@@ -69,15 +69,13 @@ std::vector<int> YogaPlugin::performAssembly() {
     mp.Barrier();
     std::shared_ptr<YOGA::OversetData> overset_data = nullptr;
 
-    int load_balancer_algorithm = config.selectedLoadBalancer();
-    int target_voxel_size = config.selectedTargetVoxelSize();
-    int extra_layers = config.numberOfExtraLayersForInterpBcs();
-    int rcb_agglom_ncells = config.rcbAgglomerationSize();
-    bool should_add_max_receptors = config.shouldAddExtraReceptors();
-    auto component_grid_importance = config.getComponentGridImportance();
-
     if (config.shouldUseZMQPath()) {
 #ifdef YOGA_WITH_ZMQ
+        int load_balancer_algorithm = config.selectedLoadBalancer();
+        int target_voxel_size = config.selectedTargetVoxelSize();
+        int extra_layers = config.numberOfExtraLayersForInterpBcs();
+        int rcb_agglom_ncells = config.rcbAgglomerationSize();
+        bool should_add_max_receptors = config.shouldAddExtraReceptors();
         overset_data = YOGA::assemblyViaZMQPostMan(mp,
                                                    mesh,
                                                    load_balancer_algorithm,
@@ -91,18 +89,14 @@ std::vector<int> YogaPlugin::performAssembly() {
         return {};
 #endif
     } else {
-        overset_data = YOGA::assemblyViaExchange(mp,
-                                                 mesh,
-                                                 load_balancer_algorithm,
-                                                 target_voxel_size,
-                                                 extra_layers,
-                                                 rcb_agglom_ncells,
-                                                 should_add_max_receptors,
-                                                 component_grid_importance,
-                                                 &Parfait::CellContainmentChecker::isInCell_c);
+        overset_data = assembly.assemble();
     }
     node_statuses = std::move(overset_data->statuses);
     receptors = std::move(overset_data->receptors);
+    Tracer::begin("Create inverse receptors");
+    inverse_receptors = generateInverseReceptors<double>(mp, receptors, mesh);
+    receptor_update_exchange = std::make_shared<ReceptorUpdateExchange>(mp, 5, receptors, inverse_receptors);
+    Tracer::end("Create inverse receptors");
 
     std::vector<int> ids_of_nodes_to_freeze;
     for (size_t i = 0; i < node_statuses.size(); i++) {
@@ -112,18 +106,28 @@ std::vector<int> YogaPlugin::performAssembly() {
     return ids_of_nodes_to_freeze;
 }
 
+void YogaPlugin::moveComponent(int component_id, const Parfait::MotionMatrix& motion) {
+    assembly.moveComponent(component_id, motion);
+}
+
 std::map<int, std::vector<double>> YogaPlugin::updateReceptorSolutions(
     std::function<void(int, double, double, double, double*)> getter) const {
-    int nvar = 5;
-    auto framework_getter = [&](int yoga_id, double x, double y, double z, double* solution) {
-        getter(framework_cell_ids[yoga_id], x, y, z, solution);
-    };
-    Tracer::begin("Create inverse receptors");
-    auto inverse_receptors = generateInverseReceptors<double>(mp, receptors, mesh);
-    Tracer::end("Create inverse receptors");
+    if (receptor_update_exchange == nullptr)
+        throw std::logic_error("Yoga: updateReceptorSolutions called before performAssembly");
+    int nvar = receptor_update_exchange->nvariables();
     Tracer::begin("get solutions from solver");
+    auto& exchange = *receptor_update_exchange;
+    exchange.beginReceives();
+    int row = 0;
+    for (auto& pair : inverse_receptors) {
+        for (auto& inverse_receptor : pair.second) {
+            auto& xyz = inverse_receptor.p;
+            int cell_id = framework_cell_ids[mesh.getCellIdFromOriginalMesh(inverse_receptor.donor_cell_id)];
+            getter(cell_id, xyz[0], xyz[1], xyz[2], exchange.row(row++));
+        }
+    }
     std::vector<double> solution_at_nodes(nvar * mesh.nodeCount());
-    getUpdatedSolutionsFromSolver(mp, mesh, receptors, inverse_receptors, nvar, framework_getter, solution_at_nodes);
+    exchange.finish(solution_at_nodes.data());
     std::map<int, std::vector<double>> receptor_solutions;
     for (auto& r : receptors) {
         int node_id = r.first;
@@ -173,10 +177,7 @@ std::shared_ptr<FieldInterface> YogaPlugin::field(std::string field_name) const
         std::vector<double> partition(mesh.numberOfCells() + mesh.numberOfBoundaryFaces(), mp.Rank());
         return std::make_shared<VectorFieldAdapter>(field_name, inf::FieldAttributes::Cell(), 1, partition);
     } else if ("distance" == field_name) {
-        Tracer::begin("build surfaces");
-        auto surfaces = YOGA::ParallelSurface::buildSurfaces(mp, mesh);
-        Tracer::end("build surfaces");
-        auto distanceToWallFromNode = YOGA::DistanceFieldAdapter::getNodeDistances(mesh, surfaces);
+        auto distanceToWallFromNode = YOGA::DistanceFieldAdapter::getNodeDistances(mp, mesh);
         return std::make_shared<VectorFieldAdapter>(
             field_name, inf::FieldAttributes::Node(), 1, distanceToWallFromNode);
     } else {
@@ -264,13 +265,8 @@ void YogaPlugin::verifyDonors() {
     std::vector<double> interpolated_field(mesh.nodeCount(), 0.0);
     for (int i = 0; i < mesh.nodeCount(); i++) linear_field[i] = linearTestFunction(mesh.getNode<double>(i));
 
-    auto inverse_receptors = generateInverseReceptors<double>(mp, receptors, mesh);
-    auto get_value = [&](int node_id, double* x) { *x = linear_field[node_id]; };
-
-    WeightBasedInterpolator<double> interpolator(1, inverse_receptors, mesh, &calcWeightsWithFiniteElements);
-
-    YOGA::getUpdatedSolutionsFromInterpolator(
-        mp, receptors, inverse_receptors, 1, interpolator, get_value, interpolated_field);
+    InterpolationOperator interpolator(mp, 1, mesh, receptors, inverse_receptors, &calcWeightsWithFiniteElements);
+    interpolator.apply(linear_field.data(), interpolated_field);
 
     double max_error = 0.0;
     for (int i = 0; i < mesh.nodeCount(); i++) {
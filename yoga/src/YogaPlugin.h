@@ -8,8 +8,10 @@
 #include "BoundaryConditions.h"
 #include "DruyorTypeAssignment.h"
 #include "GhostSyncPatternBuilder.h"
+#include "InterpolationOperator.h"
 #include "MeshInterfaceAdapter.h"
 #include "OversetData.h"
+#include "PersistentAssembly.h"
 
 class YogaPlugin : public inf::DomainAssemblerInterface {
   public:
@@ -19,6 +21,8 @@ class YogaPlugin : public inf::DomainAssemblerInterface {
 
     void verifyDonors();
 
+    void moveComponent(int component_id, const Parfait::MotionMatrix& motion);
+
     std::vector<int> determineGridIdsForNodes() override;
 
     virtual std::map<int, std::vector<double>> updateReceptorSolutions(
@@ -34,6 +38,9 @@ class YogaPlugin : public inf::DomainAssemblerInterface {
     std::map<int, YOGA::OversetData::DonorCell> receptors;
   private:
     std::vector<int> framework_cell_ids;
+    YOGA::PersistentAssembly assembly;
+    std::map<int, std::vector<YOGA::InverseReceptor<double>>> inverse_receptors;
+    std::shared_ptr<YOGA::ReceptorUpdateExchange> receptor_update_exchange;
 
     std::vector<YOGA::BoundaryConditions> createBoundaryConditionVector(const inf::MeshInterface& mesh,
                                                                         std::string input,
@@ -28,7 +28,7 @@ long YogaToTInfinityAdapter::calcGlobalCellIdOffset(MessagePasser mp){
     return my_offset;
 }
 
-YogaToTInfinityAdapter::YogaToTInfinityAdapter(const YogaMesh& m,const std::map<long,int>& global_to_local,
+YogaToTInfinityAdapter::YogaToTInfinityAdapter(const YogaMesh& m,const IdMap& global_to_local,
                                                MessagePasser mp)
     :m(m),
       g2l(global_to_local),
@@ -1,11 +1,12 @@
 #pragma once
 #include <t-infinity/MeshInterface.h>
+#include "IdMap.h"
 #include "YogaMesh.h"
 
 namespace YOGA{
 class YogaToTInfinityAdapter : public inf::MeshInterface{
   public:
-    YogaToTInfinityAdapter(const YogaMesh& m,const std::map<long,int>& global_to_local,MessagePasser mp);
+    YogaToTInfinityAdapter(const YogaMesh& m,const IdMap& global_to_local,MessagePasser mp);
     virtual int nodeCount() const override;
     virtual int cellCount() const override;
     virtual int partitionId() const override;
@@ -21,7 +22,7 @@ class YogaToTInfinityAdapter : public inf::MeshInterface{
     std::string tagName(int t) const override;
   private:
     const YogaMesh& m;
-    const std::map<long,int>& g2l;
+    const IdMap& g2l;
     const int rank;
     std::vector<long> global_cell_ids;
     void cell(int cell_id,std::vector<int>& cell) const;
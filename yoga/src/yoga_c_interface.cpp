@@ -123,13 +123,12 @@ void yoga_perform_domain_assembly(void* yoga_instance) {
     if (instance.mp.Rank() == 0) {
         printf("load balancer: %i target voxel size: %i\n", load_balancer, target_voxel_size);
     }
-    int extra_layers = config.numberOfExtraLayersForInterpBcs();
-    int rcb_agglom_ncells = config.rcbAgglomerationSize();
-    bool should_add_max_receptors = config.shouldAddExtraReceptors();
-    auto component_grid_importance = config.getComponentGridImportance();
     Parfait::disableFloatingPointExceptions();
     if(config.shouldUseZMQPath()) {
 #ifdef YOGA_WITH_ZMQ
+        int extra_layers = config.numberOfExtraLayersForInterpBcs();
+        int rcb_agglom_ncells = config.rcbAgglomerationSize();
+        bool should_add_max_receptors = config.shouldAddExtraReceptors();
         instance.oversetData = YOGA::assemblyViaZMQPostMan(mp, mesh, load_balancer, target_voxel_size,
                                                            extra_layers,
                                                            rcb_agglom_ncells,
@@ -140,15 +139,7 @@ void yoga_perform_domain_assembly(void* yoga_instance) {
 #endif
     }
     else{
-        instance.oversetData = YOGA::assemblyViaExchange(mp,
-                                                         mesh,
-                                                         load_balancer,
-                                                         target_voxel_size,
-                                                         extra_layers,
-                                                         rcb_agglom_ncells,
-                                                         should_add_max_receptors,
-                                                         component_grid_importance,
-                                                         instance.doesCellContainNode);
+        instance.oversetData = instance.persistent_assembly.assemble();
     }
     Tracer::begin("Generate inverse receptors");
     if(instance.is_complex) {
@@ -164,8 +155,12 @@ void yoga_perform_domain_assembly(void* yoga_instance) {
         instance.fun3d_adjoint_data = std::make_shared<FUN3DAdjointData<double>>(mp,mesh,
                                                                                  instance.oversetData->statuses,
                                                                                  instance.oversetData->receptors);
-        instance.interpolator = std::make_shared<WeightBasedInterpolator<double>>(
-            instance.nSolutionVariables, instance.inverse_receptors, mesh, instance.calcWeightsForReceptor);
+        instance.interpolation_operator = std::make_shared<InterpolationOperator>(mp,
+                                                                                  instance.nSolutionVariables,
+                                                                                  mesh,
+                                                                                  instance.oversetData->receptors,
+                                                                                  instance.inverse_receptors,
+                                                                                  instance.calcWeightsForReceptor);
     }
     Tracer::end("Generate inverse receptors");
 
@@ -173,18 +168,18 @@ void yoga_perform_domain_assembly(void* yoga_instance) {
     //Parfait::enableFloatingPointExceptions();
 }
 
+void yoga_move_component(void* yoga_instance, int component_id, double* motion_matrix) {
+    auto& instance = extractReference(yoga_instance);
+    Parfait::MotionMatrix motion;
+    motion.setMotionMatrix(motion_matrix);
+    instance.persistent_assembly.moveComponent(component_id, motion);
+}
+
 void yoga_update_receptor_solutions(void* yoga_instance) {
     auto& instance = extractReference(yoga_instance);
     Parfait::disableFloatingPointExceptions();
     Tracer::begin("Update receptor solutions");
-    int nvar = instance.nSolutionVariables;
-    getUpdatedSolutionsFromInterpolator(instance.mp,
-                                        instance.oversetData->receptors,
-                                        instance.inverse_receptors,
-                                        nvar,
-                                        *instance.interpolator.get(),
-                                        instance.getSolutionFromSolverAtNode,
-                                        instance.solution_at_nodes);
+    instance.interpolation_operator->apply(instance.getSolutionFromSolverAtNode, instance.solution_at_nodes);
     Tracer::end("Update receptor solutions");
     // just leave them off
     //Parfait::enableFloatingPointExceptions();
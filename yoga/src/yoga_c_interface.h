@@ -21,6 +21,7 @@ void* yoga_create_instance(int comm,
                            void (*getSolutionInCellAt)(int, double, double, double, double*),
                            void (*getSolutionAtNode)(int, double*));
 void yoga_perform_domain_assembly(void* yoga_instance);
+void yoga_move_component(void* yoga_instance, int component_id, double* motion_matrix);
 void yoga_update_receptor_solutions(void* yoga_instance);
 void yoga_fill_grid_ids_for_nodes(void* yoga_instance,int* grid_ids);
 int yoga_get_node_status(void* yoga_instance, int node_id);
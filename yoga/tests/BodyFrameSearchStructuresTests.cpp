@@ -0,0 +1,130 @@
+#include <RingAssertions.h>
+#include "BodyFrameSearchStructures.h"
+#include "DiagonalTetsMockMesh.h"
+
+using namespace YOGA;
+
+Parfait::MotionMatrix rotateAndTranslate() {
+    Parfait::MotionMatrix motion;
+    motion.addRotation(Parfait::Point<double>{0.3, -1.0, 0.2}, Parfait::Point<double>{1.0, 0.5, 2.0}, 37.0);
+    motion.addTranslation(Parfait::Point<double>{2.0, -1.0, 0.5}.data());
+    return motion;
+}
+
+TEST_CASE("Inverse of a rigid motion matrix moves points back") {
+    auto motion = rotateAndTranslate();
+    Parfait::Point<double> p{0.4, -3.0, 7.0};
+    auto q = p;
+    motion.movePoint(q);
+    motion.inverse().movePoint(q);
+    REQUIRE(p[0] == Approx(q[0]));
+    REQUIRE(p[1] == Approx(q[1]));
+    REQUIRE(p[2] == Approx(q[2]));
+}
+
+TEST_CASE("Body frame search structures give the same answers after rigid motion") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    auto mesh = generateDiagonalTetsMockMesh(mp.Rank());
+    PartitionInfo partition_info(mesh, mp.Rank());
+    MeshSystemInfo mesh_system_info(mp, partition_info);
+
+    BodyFrameSearchStructures body_frames;
+    body_frames.addMotion(0, rotateAndTranslate());
+    REQUIRE_FALSE(body_frames.isBuilt());
+    body_frames.build(mp, mesh, partition_info, mesh_system_info, 2000, false);
+    REQUIRE(body_frames.isBuilt());
+    REQUIRE(1 == body_frames.holeMaps().size());
+
+    double offset = mp.Rank();
+    std::vector<Parfait::Point<double>> points;
+    points.push_back({offset + 0.25, offset + 0.25, offset - 0.5});
+    points.push_back({offset + 0.2, offset + 0.2, offset + 0.2});
+    points.push_back({offset + 3.0, offset - 2.0, offset + 0.5});
+    points.push_back({-10.0, 0.5 * offset, 40.0});
+    std::vector<int> components(points.size(), 0);
+    auto distance_before = body_frames.wallDistance().calcDistances(points, components);
+    auto& hole_map = body_frames.holeMaps().front();
+    std::vector<Parfait::Point<double>> cell_centers;
+    std::vector<bool> in_hole_before;
+    for (int id = 0; id < hole_map.block.numberOfCells(); id++) {
+        auto center = hole_map.block.createExtentFromCell(id).center();
+        Parfait::Extent<double> e{center, center};
+        cell_centers.push_back(center);
+        in_hole_before.push_back(hole_map.doesOverlapHole(e));
+    }
+
+    auto motion = rotateAndTranslate();
+    mesh.setXyzForNodes([&](int, double* xyz) { motion.movePoint(xyz); });
+    body_frames.addMotion(0, motion);
+    for (auto& p : points) motion.movePoint(p);
+
+    std::vector<Parfait::Point<double>> points_in_body_frame;
+    for (auto& p : points) points_in_body_frame.push_back(body_frames.toBodyFrame(p, 0));
+    auto distance_after = body_frames.wallDistance().calcDistances(points_in_body_frame, components);
+    DistributedWallDistance rebuilt(mp, mesh);
+    auto distance_rebuilt = rebuilt.calcDistances(points, components);
+    for (size_t i = 0; i < points.size(); i++) {
+        REQUIRE(distance_before[i] == Approx(distance_after[i]));
+        REQUIRE(distance_rebuilt[i] == Approx(distance_after[i]));
+    }
+    for (size_t i = 0; i < cell_centers.size(); i++) {
+        auto p = cell_centers[i];
+        motion.movePoint(p);
+        Parfait::Extent<double> e{p, p};
+        REQUIRE(in_hole_before[i] == hole_map.doesOverlapHole(e));
+    }
+}
+
+TEST_CASE("Body frame hole map is conservative for finite extents after rotation") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    auto mesh = generateDiagonalTetsMockMesh(mp.Rank());
+    PartitionInfo partition_info(mesh, mp.Rank());
+    MeshSystemInfo mesh_system_info(mp, partition_info);
+    BodyFrameSearchStructures body_frames;
+    body_frames.build(mp, mesh, partition_info, mesh_system_info, 2000, false);
+
+    auto motion = rotateAndTranslate();
+    mesh.setXyzForNodes([&](int, double* xyz) { motion.movePoint(xyz); });
+    body_frames.addMotion(0, motion);
+    auto& hole_map = body_frames.holeMaps().front();
+
+    PartitionInfo moved_partition_info(mesh, mp.Rank());
+    MeshSystemInfo moved_mesh_system_info(mp, moved_partition_info);
+    auto rebuilt = createHoleMaps(mp, mesh, moved_partition_info, moved_mesh_system_info, 2000, false);
+    auto& rebuilt_map = rebuilt.front();
+
+    std::vector<Parfait::Point<double>> body_points;
+    for (int n = 0; n < mesh.nodeCount(); n++) body_points.push_back(mesh.getNode<double>(n));
+    body_points.push_back(0.25 * (body_points[0] + body_points[1] + body_points[2] + body_points[3]));
+
+    // The rebuilt map blanks world-axis boxes around the moved faces, which grow
+    // under rotation, so it may flag extents the body-frame map does not.  Both
+    // must flag anything touching the body, and the body-frame map must flag any
+    // extent that holds a point whose exact pull-back lands in its hole.
+    int extents_in_hole = 0;
+    for (int id = 0; id < rebuilt_map.block.numberOfCells(); id++) {
+        auto e = rebuilt_map.block.createExtentFromCell(id);
+        bool in_hole = hole_map.doesOverlapHole(e);
+        if (in_hole) extents_in_hole++;
+
+        bool touches_body = false;
+        for (auto& p : body_points) touches_body = touches_body or e.intersects(p);
+        if (touches_body) {
+            REQUIRE(in_hole);
+            REQUIRE(rebuilt_map.doesOverlapHole(e));
+        }
+
+        bool sample_in_hole = false;
+        for (int i = 0; i <= 2; i++)
+            for (int j = 0; j <= 2; j++)
+                for (int k = 0; k <= 2; k++) {
+                    Parfait::Point<double> p{e.lo[0] + 0.5 * i * (e.hi[0] - e.lo[0]),
+                                             e.lo[1] + 0.5 * j * (e.hi[1] - e.lo[1]),
+                                             e.lo[2] + 0.5 * k * (e.hi[2] - e.lo[2])};
+                    Parfait::Extent<double> point_extent{p, p};
+                    sample_in_hole = sample_in_hole or hole_map.doesOverlapHole(point_extent);
+                }
+        if (sample_in_hole) REQUIRE(in_hole);
+    }
+    REQUIRE(extents_in_hole > 0);
+}
@@ -37,4 +37,12 @@ TEST_CASE("build Yoga nbr connectivity") {
     REQUIRE(4 == n2n[2].size());
     REQUIRE(3 == n2n[3].size());
     REQUIRE(3 == n2n[4].size());
-}
\ No newline at end of file
+}
+TEST_CASE("compressed Yoga connectivity matches the nested vectors") {
+    auto mesh = generateConnectivityMockMesh();
+    REQUIRE(Connectivity::nodeToCell(mesh) == Connectivity::nodeToCellCompressed(mesh).toVectorOfVectors());
+    auto n2n = Connectivity::nodeToNodeCompressed(mesh, 2);
+    REQUIRE(5 == n2n.size());
+    REQUIRE(18 == n2n.entryCount());
+    REQUIRE(std::vector<int>{0, 1, 2} == std::vector<int>(n2n[3].begin(), n2n[3].end()));
+}
@@ -0,0 +1,106 @@
+#include <RingAssertions.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include "DcifParallelIO.h"
+#include "DcifWriter.h"
+
+using namespace YOGA;
+
+namespace {
+// Each rank owns 5 nodes with interleaved global ids and has the first node
+// of the next rank as a ghost.
+YogaMesh buildInterleavedMesh(MessagePasser mp) {
+    int nranks = mp.NumberOfProcesses();
+    int next = (mp.Rank() + 1) % nranks;
+    int owned = 5;
+    int ghosts = nranks > 1 ? 1 : 0;
+    YogaMesh mesh;
+    mesh.setNodeCount(owned + ghosts);
+    mesh.setCellCount(0);
+    mesh.setCells([](int) { return 4; }, [](int, int*) {});
+    mesh.setXyzForNodes([](int i, double* p) { p[0] = p[1] = p[2] = i; });
+    mesh.setGlobalNodeIds([=](int i) { return i < owned ? long(mp.Rank() + nranks * i) : long(next); });
+    mesh.setOwningRankForNodes([=](int i) { return i < owned ? mp.Rank() : next; });
+    mesh.setComponentIdsForNodes([=](int i) { return i < owned ? i % 2 : 0; });
+    return mesh;
+}
+
+std::vector<char> readBytes(const std::string& filename) {
+    std::ifstream f(filename, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+NodeStatus statusForGid(long gid) {
+    std::vector<NodeStatus> statuses = {InNode, OutNode, FringeNode, Orphan};
+    return statuses[gid % 4];
+}
+}
+
+TEST_CASE("dcif sections are laid out back to back") {
+    Dcif::Layout layout(100, 10, 40);
+    REQUIRE(28 == layout.fringeIds());
+    REQUIRE(28 + 80 == layout.donorCounts());
+    REQUIRE(28 + 80 + 10 == layout.donorIds());
+    REQUIRE(28 + 80 + 10 + 320 == layout.donorWeights());
+    REQUIRE(28 + 80 + 10 + 640 == layout.iblank());
+    REQUIRE(28 + 80 + 10 + 640 + 100 == layout.footer());
+}
+
+TEST_CASE("collective dcif writer matches the root writer, and each rank reads back its slice") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    int nranks = mp.NumberOfProcesses();
+    auto mesh = buildInterleavedMesh(mp);
+
+    std::vector<NodeStatus> statuses(mesh.nodeCount());
+    for (int i = 0; i < mesh.nodeCount(); i++) statuses[i] = statusForGid(mesh.globalNodeId(i));
+    DomainConnectivityInfo<double> dci(mp, mesh, statuses, {});
+    for (int i = 0; i <= mp.Rank(); i++) {
+        long gid = mp.Rank() + nranks * i;
+        int ndonors = i % 3 + 1;
+        dci.receptorGids.push_back(gid);
+        dci.donorGids.push_back(std::vector<long>(ndonors, gid + 1));
+        dci.weights.push_back(std::vector<double>(ndonors, 1.0 / ndonors));
+    }
+
+    std::string root_file = "dcif-root-writer.dcif";
+    std::string collective_file = "dcif-collective-writer.dcif";
+    DcifWriter writer(mp);
+    writer.exportDcif(root_file, mesh, dci);
+    writer.exportDcifCollectively(collective_file, mesh, dci);
+    mp.Barrier();
+    if (0 == mp.Rank()) {
+        auto expected = readBytes(root_file);
+        REQUIRE(expected.size() > 0);
+        REQUIRE(expected == readBytes(collective_file));
+    }
+
+    Dcif::SliceReader reader(mp, collective_file);
+    REQUIRE(5 * nranks == reader.globalNodeCount());
+    REQUIRE(nranks * (nranks + 1) / 2 == reader.receptorCount());
+    REQUIRE(2 == reader.gridCount());
+    auto offsets = reader.gridNodeIdOffsets();
+    REQUIRE(3 == offsets.size());
+
+    auto range = reader.nodeRange();
+    REQUIRE(range.end - range.start == long(reader.iblank().size()));
+    for (long gid = range.start; gid < range.end; gid++) {
+        int expected = statusForGid(gid) == InNode ? 1 : statusForGid(gid) == FringeNode ? -1
+                     : statusForGid(gid) == Orphan ? -2 : 0;
+        REQUIRE(expected == reader.iblank()[gid - range.start]);
+    }
+
+    long receptors_read = mp.ParallelSum(long(reader.receptors().size()));
+    REQUIRE(reader.receptorCount() == receptors_read);
+    for (auto& r : reader.receptors()) {
+        REQUIRE(r.donor_ids.size() == r.donor_weights.size());
+        for (long id : r.donor_ids) REQUIRE(r.gid + 1 == id);
+        for (double w : r.donor_weights) REQUIRE(w == Approx(1.0 / r.donor_ids.size()));
+    }
+
+    mp.Barrier();
+    if (0 == mp.Rank()) {
+        std::remove(root_file.c_str());
+        std::remove(collective_file.c_str());
+    }
+}
@@ -0,0 +1,47 @@
+#include <RingAssertions.h>
+#include <parfait/Flatten.h>
+#include "DiagonalTetsMockMesh.h"
+#include "DistributedWallDistance.h"
+
+using namespace YOGA;
+
+double bruteForceDistance(const std::vector<Parfait::Facet>& facets, const Parfait::Point<double>& p) {
+    double d = DistributedWallDistance::farAway();
+    for (auto& f : facets) d = std::min(d, (f.getClosestPoint(p) - p).magnitude());
+    return d;
+}
+
+TEST_CASE("Distributed wall distance is exact to the closest facet") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    auto mesh = generateDiagonalTetsMockMesh(mp.Rank());
+    auto local_facets = DistributedWallDistance::extractLocalWallFacets(mesh);
+    REQUIRE(4 == local_facets.size());
+    auto all_facets = Parfait::flatten(mp.Gather(local_facets));
+
+    DistributedWallDistance wall_distance(mp, mesh);
+    REQUIRE(1 == wall_distance.componentCount());
+
+    double offset = mp.Rank();
+    std::vector<Parfait::Point<double>> points;
+    points.push_back({offset + 0.25, offset + 0.25, offset - 0.5});
+    points.push_back({offset + 0.2, offset + 0.2, offset + 0.2});
+    points.push_back({offset + 3.0, offset - 2.0, offset + 0.5});
+    points.push_back({-10.0, 0.5 * offset, 40.0});
+    std::vector<int> components(points.size(), 0);
+
+    auto distance = wall_distance.calcDistances(points, components);
+    REQUIRE(points.size() == distance.size());
+    REQUIRE(0.5 == Approx(distance[0]));
+    for (size_t i = 0; i < points.size(); i++) REQUIRE(bruteForceDistance(all_facets, points[i]) == Approx(distance[i]));
+}
+
+TEST_CASE("Distributed wall distance is far away for components without walls") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    auto mesh = generateDiagonalTetsMockMesh(mp.Rank());
+    mesh.setBoundaryConditions([](int) { return YOGA::BoundaryConditions::Interpolation; }, [](int) { return 3; });
+    REQUIRE(DistributedWallDistance::extractLocalWallFacets(mesh).empty());
+    DistributedWallDistance wall_distance(mp, mesh);
+    std::vector<Parfait::Point<double>> points{{0, 0, 0}};
+    auto distance = wall_distance.calcDistances(points, {0});
+    REQUIRE(DistributedWallDistance::farAway() == distance[0]);
+}
@@ -0,0 +1,81 @@
+#include <MessagePasser/MessagePasser.h>
+#include <RingAssertions.h>
+#include "DiagonalTetsMockMesh.h"
+#include "DonorSearchHistory.h"
+#include "MeshSystemInfo.h"
+#include "PartitionInfo.h"
+
+using namespace YOGA;
+
+std::vector<Receptor> receptorsForOwnedNodes(const YogaMesh& mesh) {
+    std::vector<Receptor> receptors;
+    for (int i = 0; i < mesh.nodeCount(); i++) {
+        Receptor r;
+        r.globalId = mesh.globalNodeId(i);
+        r.owner = mesh.nodeOwner(i);
+        r.distance = 0.0;
+        r.candidateDonors.push_back(CandidateDonor(1, 7, 0, 0.0, CandidateDonor::Tet));
+        receptors.push_back(r);
+    }
+    return receptors;
+}
+
+TEST_CASE("Donor search history decides which query points must be searched again") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    auto mesh = generateDiagonalTetsMockMesh(mp.Rank());
+    mesh.setGlobalNodeIds([&](int id) { return long(4 * mp.Rank() + id); });
+    mesh.setOwningRankForNodes([&](int) { return mp.Rank(); });
+    mesh.setComponentIdsForNodes([](int) { return 0; });
+    PartitionInfo partition_info(mesh, mp.Rank());
+    MeshSystemInfo mesh_system_info(mp, partition_info);
+
+    DonorSearchHistory history;
+    Parfait::Point<double> far_away{1.0e6, 1.0e6, 1.0e6};
+
+    SECTION("Everything is searched before the first assembly") {
+        history.beginAssembly(mesh_system_info);
+        REQUIRE_FALSE(history.hasPreviousAssembly());
+        REQUIRE_FALSE(history.canReuseAllDonors());
+        REQUIRE(history.requiresSearch(far_away, 3));
+        REQUIRE(history.reusableReceptors(mesh, mp.Rank()).empty());
+    }
+
+    history.store(receptorsForOwnedNodes(mesh), mesh_system_info);
+
+    SECTION("Nothing is searched again if no component moved") {
+        history.beginAssembly(mesh_system_info);
+        REQUIRE(history.canReuseAllDonors());
+        REQUIRE_FALSE(history.requiresSearch(mesh.getNode<double>(0), 0));
+        auto reused = history.reusableReceptors(mesh, mp.Rank());
+        REQUIRE(4 == reused.size());
+        REQUIRE(mesh.globalNodeId(2) == reused[2].globalId);
+        REQUIRE(1 == reused[2].candidateDonors.size());
+    }
+
+    SECTION("Nodes of a moved component, and nodes in its swept extent, are searched again") {
+        history.markComponentMoved(0);
+        history.beginAssembly(mesh_system_info);
+        REQUIRE_FALSE(history.canReuseAllDonors());
+        REQUIRE(history.requiresSearch(far_away, 0));
+        REQUIRE(history.requiresSearch(mesh.getNode<double>(0), 1));
+        REQUIRE_FALSE(history.requiresSearch(far_away, 1));
+        REQUIRE(history.reusableReceptors(mesh, mp.Rank()).empty());
+    }
+
+    SECTION("Clearing the history forces a full search") {
+        history.clear();
+        history.beginAssembly(mesh_system_info);
+        REQUIRE(history.requiresSearch(mesh.getNode<double>(0), 0));
+    }
+}
+
+TEST_CASE("Donor search history can be disabled") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    auto mesh = generateDiagonalTetsMockMesh(mp.Rank());
+    PartitionInfo partition_info(mesh, mp.Rank());
+    MeshSystemInfo mesh_system_info(mp, partition_info);
+
+    DonorSearchHistory history(false);
+    history.store(receptorsForOwnedNodes(mesh), mesh_system_info);
+    REQUIRE_FALSE(history.hasPreviousAssembly());
+}
@@ -0,0 +1,43 @@
+#include <RingAssertions.h>
+#include "DonorValidityPlan.h"
+
+using namespace YOGA;
+
+TEST_CASE("pack donor validity as bits") {
+    std::vector<bool> bits = {true, false, false, true, true, false, true, false, true, true};
+    auto bytes = DonorValidityPlan::packBits(bits);
+    REQUIRE(2 == bytes.size());
+    for (size_t i = 0; i < bits.size(); i++) REQUIRE(bits[i] == DonorValidityPlan::unpackBit(bytes, i));
+    REQUIRE(DonorValidityPlan::packBits({}).empty());
+}
+
+TEST_CASE("update donor validity from the ranks that own the donor cells") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    int nranks = mp.NumberOfProcesses();
+    int next = (mp.Rank() + 1) % nranks;
+
+    // Every receptor has donors on this rank and the next one; the cell id
+    // encodes the owner so each owner can check it is asked about its own cells.
+    std::vector<Receptor> receptors(20);
+    for (int i = 0; i < 20; i++) {
+        receptors[i].globalId = i;
+        receptors[i].candidateDonors.push_back(CandidateDonor(0, 1000 * mp.Rank() + i, mp.Rank(), 0.1, CandidateDonor::Tet));
+        receptors[i].candidateDonors.push_back(CandidateDonor(0, 1000 * next + i, next, 0.2, CandidateDonor::Tet));
+    }
+
+    DonorValidityPlan plan(mp, receptors);
+    // itself, the next rank, and the previous rank, which asks about our cells
+    REQUIRE(plan.neighborCount() == std::min(3, nranks));
+
+    auto is_even_and_mine = [&](int cell_id) { return cell_id / 1000 == mp.Rank() and 0 == cell_id % 2; };
+    plan.update(receptors, is_even_and_mine);
+    for (int i = 0; i < 20; i++) {
+        for (auto& d : receptors[i].candidateDonors) REQUIRE((0 == i % 2) == (1 == d.isValid));
+    }
+
+    auto is_odd_and_mine = [&](int cell_id) { return cell_id / 1000 == mp.Rank() and 1 == cell_id % 2; };
+    plan.update(receptors, is_odd_and_mine);
+    for (int i = 0; i < 20; i++) {
+        for (auto& d : receptors[i].candidateDonors) REQUIRE((1 == i % 2) == (1 == d.isValid));
+    }
+}
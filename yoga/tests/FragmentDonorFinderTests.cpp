@@ -0,0 +1,179 @@
+#include <RingAssertions.h>
+#include "DonorSearchThreads.h"
+#include "ExchangeBasedAssembly.h"
+
+using namespace YOGA;
+
+VoxelFragment createRowOfHexes(int nhex, int component) {
+    VoxelFragment fragment;
+    auto node_id = [=](int i, int j, int k) { return i + (nhex + 1) * (j + 2 * k); };
+    long gid = 0;
+    for (int k = 0; k < 2; k++)
+        for (int j = 0; j < 2; j++)
+            for (int i = 0; i < nhex + 1; i++)
+                fragment.transferNodes.push_back(TransferNode(gid++, {double(i), double(j), double(k)}, 0.0, component, 0));
+    for (int i = 0; i < nhex; i++) {
+        std::array<int, 8> hex = {node_id(i, 0, 0),
+                                  node_id(i + 1, 0, 0),
+                                  node_id(i + 1, 1, 0),
+                                  node_id(i, 1, 0),
+                                  node_id(i, 0, 1),
+                                  node_id(i + 1, 0, 1),
+                                  node_id(i + 1, 1, 1),
+                                  node_id(i, 1, 1)};
+        fragment.transferHexs.push_back(TransferCell<8>(hex, 100 + i, 0));
+    }
+    return fragment;
+}
+
+TEST_CASE("Fragment donor finder warm start finds the same donor as the ADT") {
+    std::map<int, VoxelFragment> fragments;
+    fragments[0] = createRowOfHexes(10, 1);
+
+    std::vector<TransferNode> query_points;
+    query_points.push_back(TransferNode(99, {0.5, 0.5, 0.5}, 0.0, 0, 3));
+
+    DonorWarmStart warm_start;
+    warm_start.setEnabled(true);
+    FragmentDonorFinder finder(fragments, &warm_start);
+    auto receptors = finder.generateCandidateReceptors(query_points);
+    REQUIRE(1 == receptors.size());
+    REQUIRE(100 == receptors.front().candidateDonors.front().cellId);
+    REQUIRE(1 == warm_start.previousDonors(99).size());
+
+    SECTION("after a small motion the donor is found by walking from the previous one") {
+        query_points.front().xyz = {3.5, 0.5, 0.5};
+        auto warm = finder.generateCandidateReceptors(query_points);
+        FragmentDonorFinder cold_finder(fragments);
+        auto cold = cold_finder.generateCandidateReceptors(query_points);
+        REQUIRE(1 == warm.size());
+        REQUIRE(1 == warm.front().candidateDonors.size());
+        REQUIRE(cold.front().candidateDonors.front().cellId == warm.front().candidateDonors.front().cellId);
+        REQUIRE(103 == warm.front().candidateDonors.front().cellId);
+        REQUIRE(103 == warm_start.previousDonors(99).front().second);
+    }
+
+    SECTION("points that leave the component forget their previous donor") {
+        query_points.front().xyz = {30.5, 0.5, 0.5};
+        auto warm = finder.generateCandidateReceptors(query_points);
+        REQUIRE(warm.empty());
+        REQUIRE(warm_start.previousDonors(99).empty());
+    }
+}
+
+TEST_CASE("Fragment donor finder keeps receptors in query order when checking candidates in batches") {
+    std::map<int, VoxelFragment> fragments;
+    fragments[0] = createRowOfHexes(10, 1);
+
+    std::vector<TransferNode> query_points;
+    for (int i = 0; i < 2500; i++) {
+        double x = 0.5 + (i % 12);
+        query_points.push_back(TransferNode(i, {x, 0.5, 0.5}, 0.0, 0, 3));
+    }
+
+    FragmentDonorFinder finder(fragments);
+    auto receptors = finder.generateCandidateReceptors(query_points);
+    REQUIRE(2500 - 2 * (2500 / 12) == long(receptors.size()));
+    long previous_id = -1;
+    for (auto& r : receptors) {
+        REQUIRE(r.globalId > previous_id);
+        previous_id = r.globalId;
+        int i = r.globalId % 12;
+        REQUIRE(1 == r.candidateDonors.size());
+        REQUIRE(100 + i == r.candidateDonors.front().cellId);
+    }
+}
+
+TEST_CASE("Threaded donor search matches the serial search exactly") {
+    std::map<int, VoxelFragment> fragments;
+    fragments[0] = createRowOfHexes(10, 1);
+    fragments[1] = createRowOfHexes(4, 2);
+
+    std::vector<TransferNode> query_points;
+    for (int i = 0; i < 3000; i++) {
+        Parfait::Point<double> p{0.01 * (i % 1100), 0.25 + 0.0001 * (i % 5000), 0.5};
+        query_points.push_back(TransferNode(i, p, 0.0, i % 3, 0));
+    }
+
+    DonorWarmStart serial_warm_start, threaded_warm_start;
+    serial_warm_start.setEnabled(true);
+    threaded_warm_start.setEnabled(true);
+    FragmentDonorFinder serial_finder(fragments, &serial_warm_start);
+    auto serial = serial_finder.generateCandidateReceptors(query_points);
+
+    FragmentDonorFinder threaded_finder(fragments, &threaded_warm_start);
+    int thread_count = 4;
+    std::vector<FragmentDonorFinder::SearchWorkspace> workspaces(thread_count);
+    std::vector<std::vector<Receptor>> receptors_for_threads(thread_count);
+    threaded_finder.prepareForThreadedSearch();
+    forEachThreadRange(thread_count, query_points.size(), [&](int thread, long start, long end) {
+        threaded_finder.generateCandidateReceptors(
+            query_points, start, end, workspaces[thread], receptors_for_threads[thread]);
+    });
+    threaded_finder.finishSearch(workspaces);
+
+    std::vector<Receptor> threaded;
+    for (auto& receptors : receptors_for_threads) threaded.insert(threaded.end(), receptors.begin(), receptors.end());
+
+    REQUIRE(serial.size() > 0);
+    REQUIRE(serial.size() == threaded.size());
+    for (size_t i = 0; i < serial.size(); i++) {
+        REQUIRE(serial[i].globalId == threaded[i].globalId);
+        REQUIRE(serial[i].candidateDonors.size() == threaded[i].candidateDonors.size());
+        for (size_t j = 0; j < serial[i].candidateDonors.size(); j++) {
+            auto& a = serial[i].candidateDonors[j];
+            auto& b = threaded[i].candidateDonors[j];
+            REQUIRE(a.cellId == b.cellId);
+            REQUIRE(a.component == b.component);
+            REQUIRE(a.distance == b.distance);
+        }
+        REQUIRE(serial_warm_start.previousDonors(serial[i].globalId) ==
+                threaded_warm_start.previousDonors(serial[i].globalId));
+    }
+}
+
+TEST_CASE("Morton ordered donor search returns the same receptors in query order") {
+    std::map<int, VoxelFragment> fragments;
+    fragments[0] = createRowOfHexes(10, 1);
+    fragments[1] = createRowOfHexes(4, 2);
+
+    std::vector<TransferNode> query_points;
+    for (int i = 0; i < 3000; i++) {
+        Parfait::Point<double> p{0.01 * ((i * 7919) % 1100), 0.25 + 0.0001 * (i % 5000), 0.5};
+        query_points.push_back(TransferNode(i, p, 0.0, i % 3, 0));
+    }
+
+    DonorWarmStart plain_warm_start, ordered_warm_start;
+    plain_warm_start.setEnabled(true);
+    ordered_warm_start.setEnabled(true);
+    FragmentDonorFinder plain_finder(fragments, &plain_warm_start);
+    auto plain = plain_finder.generateCandidateReceptors(query_points);
+
+    FragmentDonorFinder ordered_finder(fragments, &ordered_warm_start);
+    ordered_finder.setMortonOrdering(true);
+    int thread_count = 3;
+    std::vector<FragmentDonorFinder::SearchWorkspace> workspaces(thread_count);
+    std::vector<std::vector<Receptor>> receptors_for_threads(thread_count);
+    ordered_finder.prepareForThreadedSearch();
+    forEachThreadRange(thread_count, query_points.size(), [&](int thread, long start, long end) {
+        ordered_finder.generateCandidateReceptors(
+            query_points, start, end, workspaces[thread], receptors_for_threads[thread]);
+    });
+    ordered_finder.finishSearch(workspaces);
+
+    std::vector<Receptor> ordered;
+    for (auto& receptors : receptors_for_threads) ordered.insert(ordered.end(), receptors.begin(), receptors.end());
+
+    REQUIRE(plain.size() > 0);
+    REQUIRE(plain.size() == ordered.size());
+    for (size_t i = 0; i < plain.size(); i++) {
+        REQUIRE(plain[i].globalId == ordered[i].globalId);
+        REQUIRE(plain[i].candidateDonors.size() == ordered[i].candidateDonors.size());
+        for (size_t j = 0; j < plain[i].candidateDonors.size(); j++) {
+            REQUIRE(plain[i].candidateDonors[j].cellId == ordered[i].candidateDonors[j].cellId);
+            REQUIRE(plain[i].candidateDonors[j].distance == ordered[i].candidateDonors[j].distance);
+        }
+        REQUIRE(plain_warm_start.previousDonors(plain[i].globalId) ==
+                ordered_warm_start.previousDonors(plain[i].globalId));
+    }
+}
@@ -0,0 +1,66 @@
+#include <RingAssertions.h>
+#include <limits>
+#include <map>
+#include <random>
+#include "IdMap.h"
+
+using namespace YOGA;
+
+TEST_CASE("IdMap maps global ids to local ids") {
+    IdMap g2l;
+    REQUIRE(g2l.empty());
+    g2l[92] = 0;
+    g2l[7] = 1;
+    REQUIRE(2 == g2l.size());
+    REQUIRE(0 == g2l.at(92));
+    REQUIRE(1 == g2l.at(7));
+    REQUIRE(1 == g2l.count(7));
+    REQUIRE(0 == g2l.count(8));
+    REQUIRE_THROWS(g2l.at(8));
+}
+
+TEST_CASE("IdMap insert does not overwrite an existing entry") {
+    IdMap g2l;
+    REQUIRE(g2l.insert(3, 10));
+    REQUIRE_FALSE(g2l.insert(3, 11));
+    REQUIRE(10 == g2l.at(3));
+    g2l[3] = 12;
+    REQUIRE(12 == g2l.at(3));
+    REQUIRE(1 == g2l.size());
+}
+
+TEST_CASE("IdMap handles negative and very large ids") {
+    IdMap g2l;
+    g2l[-1] = 1;
+    g2l[0] = 2;
+    g2l[std::numeric_limits<long>::max()] = 3;
+    REQUIRE(1 == g2l.at(-1));
+    REQUIRE(2 == g2l.at(0));
+    REQUIRE(3 == g2l.at(std::numeric_limits<long>::max()));
+    REQUIRE_THROWS(g2l[std::numeric_limits<long>::min()]);
+}
+
+TEST_CASE("IdMap agrees with std::map as it grows") {
+    std::mt19937_64 gen(7);
+    std::uniform_int_distribution<long> ids(0, 1l << 40);
+    std::map<long, int> expected;
+    IdMap g2l;
+    for (int i = 0; i < 50000; i++) {
+        long id = ids(gen);
+        if (expected.count(id) == 0) expected[id] = i;
+        g2l.insert(id, i);
+    }
+    for (long id = 1000000; id < 1010000; id++) g2l[id] = int(id - 1000000);
+    for (long id = 1000000; id < 1010000; id++) expected[id] = int(id - 1000000);
+
+    REQUIRE(expected.size() == g2l.size());
+    for (auto& pair : expected) REQUIRE(pair.second == g2l.at(pair.first));
+    REQUIRE(g2l.bytes() >= g2l.size() * (sizeof(long) + sizeof(int)));
+}
+
+TEST_CASE("IdMap can reserve space up front") {
+    IdMap g2l(1000);
+    size_t bytes = g2l.bytes();
+    for (int i = 0; i < 1000; i++) g2l[i] = i;
+    REQUIRE(bytes == g2l.bytes());
+}
@@ -1,7 +1,26 @@
 #include <RingAssertions.h>
 #include <YogaStatuses.h>
+#include "DruyorTypeAssignment.h"
 
 using namespace YOGA;
 
 TEST_CASE("Replacement for old convoluted type assignment"){
 }
+
+TEST_CASE("tally owned node statuses in one pass"){
+    std::vector<StatusKeeper> statuses(9);
+    std::vector<NodeStatus> values = {InNode, InNode, OutNode, FringeNode, Orphan,
+                                      ReceptorCandidate, MandatoryReceptor, Unknown, InNode};
+    for (size_t i = 0; i < values.size(); i++) statuses[i].transition(values[i]);
+    std::vector<bool> is_mine(9, true);
+    is_mine[8] = false;
+
+    auto counts = DruyorTypeAssignment::tallyStatuses(statuses, is_mine);
+    REQUIRE(2 == counts.in);
+    REQUIRE(1 == counts.out);
+    REQUIRE(1 == counts.receptor);
+    REQUIRE(1 == counts.orphan);
+    REQUIRE(1 == counts.candidate);
+    REQUIRE(1 == counts.mandatory_receptor);
+    REQUIRE(1 == counts.unknown);
+}
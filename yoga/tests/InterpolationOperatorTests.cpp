@@ -0,0 +1,61 @@
+#include <RingAssertions.h>
+#include <map>
+#include <vector>
+#include "InterpolationOperator.h"
+#include "ReceptorUpdate.h"
+
+using namespace YOGA;
+
+// One hex donor cell (nodes 0-7) and four receptor nodes inside it (8-11).
+// Receptor i is donated by rank (rank + i) % nranks.
+auto generateHexWithReceptors() {
+    YogaMesh mesh;
+    std::vector<Parfait::Point<double>> xyz = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                                               {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1},
+                                               {.2, .3, .4}, {.5, .5, .5}, {.9, .1, .7}, {.3, .8, .2}};
+    mesh.setNodeCount(xyz.size());
+    mesh.setXyzForNodes([=](int id, double* p) {
+        for (int i = 0; i < 3; i++) p[i] = xyz[id][i];
+    });
+    mesh.setCellCount(1);
+    mesh.setCells([](int) { return 8; },
+                  [](int, int* cell) {
+                      for (int i = 0; i < 8; i++) cell[i] = i;
+                  });
+    return mesh;
+}
+
+TEST_CASE("Frozen interpolation operator matches the per-receptor interpolator") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    auto mesh = generateHexWithReceptors();
+    std::map<int, OversetData::DonorCell> receptors;
+    for (int i = 0; i < 4; i++) receptors[8 + i] = {0, (mp.Rank() + i) % mp.NumberOfProcesses()};
+    auto inverse_receptors = generateInverseReceptors<double>(mp, receptors, mesh);
+
+    const int nvar = 3;
+    std::vector<double> solution(nvar * mesh.nodeCount());
+    for (size_t i = 0; i < solution.size(); i++) solution[i] = double(i) + 100.0 * mp.Rank();
+    auto get_solution = [&](int node_id, double* q) {
+        for (int j = 0; j < nvar; j++) q[j] = solution[nvar * node_id + j];
+    };
+
+    std::vector<double> expected(nvar * mesh.nodeCount(), 0.0);
+    WeightBasedInterpolator<double> interpolator(nvar, inverse_receptors, mesh, &calcWeightsWithFiniteElements);
+    getUpdatedSolutionsFromInterpolator(mp, receptors, inverse_receptors, nvar, interpolator, get_solution, expected);
+
+    InterpolationOperator op(mp, nvar, mesh, receptors, inverse_receptors, &calcWeightsWithFiniteElements);
+    int rows = 0;
+    for (auto& pair : inverse_receptors) rows += pair.second.size();
+    REQUIRE(rows == op.rowCount());
+    REQUIRE(8 == op.donorNodeCount());
+
+    for (int pass = 0; pass < 2; pass++) {
+        std::vector<double> from_getter(nvar * mesh.nodeCount(), 0.0);
+        op.apply(get_solution, from_getter);
+        REQUIRE(expected == from_getter);
+
+        std::vector<double> from_array(nvar * mesh.nodeCount(), 0.0);
+        op.apply(solution.data(), from_array);
+        REQUIRE(expected == from_array);
+    }
+}
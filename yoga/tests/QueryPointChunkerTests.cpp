@@ -1,5 +1,8 @@
 #include <RingAssertions.h>
+#include <parfait/LinearPartitioner.h>
+#include <set>
 #include "AssemblyViaExchange.h"
+#include "QueryPointPipeline.h"
 
 using namespace YOGA;
 
@@ -12,4 +15,54 @@ TEST_CASE("split query point exchanges into chunks to reduce peak memory"){
 
     // linear partitioner to divide my query points up each round, maybe just divide all evenly, even though
     // probably only a handful of ranks are overloaded
-}
\ No newline at end of file
+}
+TEST_CASE("pipelined query points are all searched and answered exactly once"){
+    MessagePasser mp(MPI_COMM_WORLD);
+    int nproc = mp.NumberOfProcesses();
+    std::map<int,std::vector<TransferNode>> query_pts_for_ranks;
+    std::map<int,long> counts_for_ranks;
+    std::set<long> expected_gids;
+    for(int target=0;target<nproc;target++){
+        int n = 7*(mp.Rank()+1) + 3*target;
+        for(int i=0;i<n;i++){
+            long gid = 1000000l*mp.Rank() + 1000l*target + i;
+            query_pts_for_ranks[target].push_back(TransferNode(gid,{0,0,0},0.0,0,mp.Rank()));
+            expected_gids.insert(gid);
+        }
+        counts_for_ranks[target] = n;
+    }
+
+    QueryPointPipeline pipeline(mp,counts_for_ranks,3);
+    REQUIRE(pipeline.roundCount() > 1);
+
+    auto pack = [&](int round,int round_count){
+        std::map<int,std::vector<TransferNode>> round_pts;
+        for(auto& pair:query_pts_for_ranks){
+            auto& pts = pair.second;
+            auto range = Parfait::LinearPartitioner::getRangeForWorker(round,pts.size(),round_count);
+            round_pts[pair.first] = std::vector<TransferNode>(pts.begin()+range.start,pts.begin()+range.end);
+        }
+        return round_pts;
+    };
+    auto search = [&](const std::vector<std::vector<TransferNode>>& query_pts_from_ranks){
+        std::map<int,ReceptorCollection> replies;
+        for(auto& pts:query_pts_from_ranks){
+            for(auto& p:pts){
+                Receptor r;
+                r.globalId = p.globalId;
+                r.owner = p.owningRank;
+                r.distance = p.distanceToWall;
+                replies[p.owningRank].insert(r);
+            }
+        }
+        return replies;
+    };
+
+    std::multiset<long> answered_gids;
+    for(auto& collection:pipeline.run(pack,search))
+        for(size_t i=0;i<collection.size();i++)
+            answered_gids.insert(collection.get(i).globalId);
+    REQUIRE(expected_gids.size() == answered_gids.size());
+    for(long gid:expected_gids)
+        REQUIRE(1 == answered_gids.count(gid));
+}
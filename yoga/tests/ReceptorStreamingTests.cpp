@@ -56,6 +56,59 @@ TEST_CASE("Stream receptors") {
             }
         }
     }
+    SECTION("Receptor collections are streamed in global id order with exact distances") {
+        ReceptorCollection collection, streamed;
+        for (long gid : {900000000000l, 5l, 70000l, 6l}) {
+            Receptor r;
+            r.globalId = gid;
+            r.owner = 2;
+            r.distance = 1.0 / 3.0 + gid;
+            for (int d = 0; d < int(gid % 3) + 1; d++)
+                r.candidateDonors.push_back(CandidateDonor(d, 100000 + d, 40 - d, 0.1 * d, CandidateDonor::Prism));
+            collection.insert(r);
+        }
+        collection.pack(msg);
+        streamed.unpack(msg);
+        REQUIRE(collection.size() == streamed.size());
+        std::vector<long> expected_order = {5, 6, 70000, 900000000000l};
+        for (size_t i = 0; i < streamed.size(); i++) {
+            auto b = streamed.get(i);
+            REQUIRE(expected_order[i] == b.globalId);
+            REQUIRE(2 == b.owner);
+            REQUIRE(1.0 / 3.0 + b.globalId == b.distance);
+            REQUIRE(int(b.globalId % 3) + 1 == int(b.candidateDonors.size()));
+            for (int d = 0; d < int(b.candidateDonors.size()); d++) {
+                auto& donor = b.candidateDonors[d];
+                REQUIRE(d == donor.component);
+                REQUIRE(100000 + d == donor.cellId);
+                REQUIRE(40 - d == donor.cellOwner);
+                REQUIRE(CandidateDonor::Prism == donor.cell_type);
+                REQUIRE(0.1 * d == donor.distance);
+            }
+        }
+    }
+    SECTION("Append one receptor collection to another") {
+        Receptor r2;
+        r2.globalId = 7;
+        r2.owner = 1;
+        r2.candidateDonors.push_back(CandidateDonor(1, 3, 2, 0.25, CandidateDonor::Hex));
+        r2.candidateDonors.push_back(CandidateDonor(2, 4, 2, 0.75, CandidateDonor::Prism));
+        ReceptorCollection appended, first, second;
+        appended.insert(r1a);
+        appended.insert(r2);
+        first.insert(r1a);
+        second.insert(r2);
+        first.append(second);
+        REQUIRE(appended.size() == first.size());
+        for(size_t i=0;i<appended.size();i++){
+            auto a = appended.get(i);
+            auto b = first.get(i);
+            REQUIRE(a.globalId == b.globalId);
+            REQUIRE(a.candidateDonors.size() == b.candidateDonors.size());
+            for(size_t j=0;j<a.candidateDonors.size();j++)
+                REQUIRE(a.candidateDonors[j].cellId == b.candidateDonors[j].cellId);
+        }
+    }
 
 }
 
@@ -47,3 +47,25 @@ TEST_CASE("Check blanking...") {
         }
     }
 }
+
+TEST_CASE("Distributed hole map matches the replicated one") {
+    MessagePasser mp(MPI_COMM_WORLD);
+    auto mesh = generateDiagonalTetsMockMesh(mp.Rank());
+    PartitionInfo partition_info(mesh, mp.Rank());
+    MeshSystemInfo meshSystemInfo(mp, partition_info);
+    ScalableHoleMap replicated(mp, mesh, partition_info, meshSystemInfo, 0, 2000);
+    ScalableHoleMap distributed(mp, mesh, partition_info, meshSystemInfo, 0, 2000, true);
+    REQUIRE(distributed.cell_statuses.empty());
+    REQUIRE(replicated.block.numberOfCells() == distributed.block.numberOfCells());
+
+    int hole_cells = 0;
+    for (int id = 0; id < replicated.block.numberOfCells(); id++) {
+        auto e = replicated.block.createExtentFromCell(id);
+        auto center = e.center();
+        Extent<double> inside_cell{center, center};
+        bool expected = replicated.doesOverlapHole(inside_cell);
+        REQUIRE(expected == distributed.doesOverlapHole(inside_cell));
+        if (expected) hole_cells++;
+    }
+    REQUIRE(hole_cells > 0);
+}
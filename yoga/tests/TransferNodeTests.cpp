@@ -1,6 +1,10 @@
 #include <parfait/Point.h>
 #include <RingAssertions.h>
+#include <algorithm>
+#include <limits>
+#include "CompactPacking.h"
 #include "TransferNode.h"
+#include "VoxelFragment.h"
 
 using namespace YOGA;
 
@@ -15,3 +19,66 @@ TEST_CASE("work node has the right stuff in it") {
     REQUIRE(owningRank == node.owningRank);
     REQUIRE(associatedComponentId == node.associatedComponentId);
 }
+
+TEST_CASE("query points are packed compactly in global id order") {
+    std::vector<TransferNode> nodes;
+    nodes.push_back(TransferNode(5000000000l, {0.1, 0.2, 0.3}, 1.5, 2, 17));
+    nodes.push_back(TransferNode(12, {1, 2, 3}, 0.0, 0, 0));
+    nodes.push_back(TransferNode(5000000001l, {-1, -2, -3}, 2.5, 1, 300));
+    nodes.push_back(TransferNode(13, {4, 5, 6}, 1e-9, 0, 3));
+
+    MessagePasser::Message msg;
+    CompactPacking::packQueryPoints(msg, nodes);
+    REQUIRE(msg.size() < nodes.size() * sizeof(TransferNode));
+
+    std::vector<TransferNode> unpacked;
+    CompactPacking::unpackQueryPoints(msg, unpacked);
+    REQUIRE(nodes.size() == unpacked.size());
+    std::vector<long> expected_order = {12, 13, 5000000000l, 5000000001l};
+    for (size_t i = 0; i < unpacked.size(); i++) {
+        REQUIRE(expected_order[i] == unpacked[i].globalId);
+        auto original = std::find_if(nodes.begin(), nodes.end(), [&](const TransferNode& n) {
+            return n.globalId == unpacked[i].globalId;
+        });
+        REQUIRE(original->xyz.approxEqual(unpacked[i].xyz));
+        REQUIRE(original->distanceToWall == unpacked[i].distanceToWall);
+        REQUIRE(original->associatedComponentId == unpacked[i].associatedComponentId);
+        REQUIRE(original->owningRank == unpacked[i].owningRank);
+    }
+}
+
+TEST_CASE("variable length integers round trip") {
+    std::vector<long> values = {0, 1, -1, 63, -64, 64, 127, 128, 300, -300, 1l << 40, -(1l << 40),
+                                std::numeric_limits<long>::max(), std::numeric_limits<long>::min()};
+    MessagePasser::Message msg;
+    for (long v : values) CompactPacking::packSigned(msg, v);
+    CompactPacking::packUnsigned(msg, std::numeric_limits<unsigned long>::max());
+    for (long v : values) REQUIRE(v == CompactPacking::unpackSigned(msg));
+    REQUIRE(std::numeric_limits<unsigned long>::max() == CompactPacking::unpackUnsigned(msg));
+}
+
+TEST_CASE("fragment nodes travel as one array per member") {
+    VoxelFragment fragment;
+    fragment.transferNodes.push_back(TransferNode(7, {0.1, 0.2, 0.3}, 1.5, 2, 17));
+    fragment.transferNodes.push_back(TransferNode(3, {1, 2, 3}, 0.25, 0, 4));
+    fragment.transferTets.push_back(TransferCell<4>({0, 1, 0, 1}, 9, 17));
+    REQUIRE(2 == fragment.transferNodes.xyz.size());
+    REQUIRE(fragment.transferNodes.xyz[1].approxEqual({1, 2, 3}));
+
+    MessagePasser::Message msg;
+    VoxelFragment::pack(msg, fragment);
+    VoxelFragment unpacked;
+    VoxelFragment::unpack(msg, unpacked);
+
+    auto& nodes = unpacked.transferNodes;
+    REQUIRE(2 == nodes.size());
+    REQUIRE(std::vector<long>{7, 3} == nodes.globalIds);
+    REQUIRE(std::vector<int>{2, 0} == nodes.associatedComponentIds);
+    REQUIRE(std::vector<int>{17, 4} == nodes.owningRanks);
+    REQUIRE(std::vector<double>{1.5, 0.25} == nodes.distancesToWall);
+    auto node = nodes[0];
+    REQUIRE(node.xyz.approxEqual({0.1, 0.2, 0.3}));
+    REQUIRE(7 == node.globalId);
+    REQUIRE(1 == unpacked.transferTets.size());
+    REQUIRE(9 == unpacked.transferTets.front().cellId);
+}
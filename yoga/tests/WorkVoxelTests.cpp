@@ -9,7 +9,7 @@ using namespace YOGA;
 TEST_CASE("Work Voxel test") {
     Parfait::Extent<double> e({0, 0, 0}, {1, 1, 1});
     WorkVoxel workVoxel(e,&Parfait::CellContainmentChecker::isInCell_c);
-    vector<TransferNode> nodes;
+    TransferNodes nodes;
     nodes.push_back(TransferNode(8, {0, 0, 0}, 0.0, 0, 0));
     nodes.push_back(TransferNode(1, {1, 0, 0}, 0.0, 0, 0));
     nodes.push_back(TransferNode(3, {0, 1, 0}, 0.0, 0, 0));
@@ -29,7 +29,7 @@ TEST_CASE("Work Voxel test") {
     REQUIRE(2 == workVoxel.tets[0].nodeIds[2]);
     REQUIRE(3 == workVoxel.tets[0].nodeIds[3]);
 
-    vector<TransferNode> moreNodes;
+    TransferNodes moreNodes;
     moreNodes.push_back(TransferNode(10, {0, 0, 1}, 0.0, 0, 0));
     moreNodes.push_back(TransferNode(11, {1, 0, 1}, 0.0, 0, 0));
     moreNodes.push_back(TransferNode(12, {0, 1, 1}, 0.0, 0, 0));
@@ -47,3 +47,27 @@ TEST_CASE("Work Voxel test") {
     REQUIRE(6 == workVoxel.tets[1].nodeIds[2]);
     REQUIRE(7 == workVoxel.tets[1].nodeIds[3]);
 }
+
+TEST_CASE("Work voxel cells can be sorted by the Morton key of their centroids") {
+    Parfait::Extent<double> e({0, 0, 0}, {4, 1, 1});
+    WorkVoxel voxel(e, &Parfait::CellContainmentChecker::isInCell_c);
+    TransferNodes nodes;
+    for (int i = 0; i < 5; i++) {
+        nodes.push_back(TransferNode(3 * i, {double(i), 0, 0}, 0.0, 0, 0));
+        nodes.push_back(TransferNode(3 * i + 1, {double(i), 1, 0}, 0.0, 0, 0));
+        nodes.push_back(TransferNode(3 * i + 2, {double(i), 0, 1}, 0.0, 0, 0));
+    }
+    vector<TransferCell<4>> tets;
+    for (int i : {3, 0, 2, 1}) tets.push_back(TransferCell<4>({3 * i, 3 * i + 1, 3 * i + 2, 3 * i + 3}, i, 0));
+
+    std::vector<int> new_local_ids;
+    voxel.addNodes(nodes, new_local_ids);
+    voxel.addTets(tets, nodes, new_local_ids);
+    voxel.sortCellsByMortonKey();
+
+    REQUIRE(4 == voxel.tets.size());
+    for (int i = 0; i < 4; i++) {
+        REQUIRE(i == voxel.tets[i].cellId);
+        REQUIRE(3 * i == voxel.tets[i].nodeIds[0]);
+    }
+}
@@ -69,3 +69,54 @@ TEST_CASE("the whole enchilada"){
     REQUIRE(1 == config.selectedLoadBalancer());
 }
 
+
+TEST_CASE("enable donor warm start"){
+    YogaConfiguration default_config("");
+    REQUIRE_FALSE(default_config.shouldWarmStartDonorSearch());
+    YogaConfiguration config("donor-warm-start");
+    REQUIRE(config.shouldWarmStartDonorSearch());
+}
+
+TEST_CASE("enable morton ordered donor search"){
+    YogaConfiguration default_config("");
+    REQUIRE_FALSE(default_config.shouldMortonOrderDonorSearch());
+    YogaConfiguration config("morton-ordered-donor-search");
+    REQUIRE(config.shouldMortonOrderDonorSearch());
+}
+
+TEST_CASE("keep search structures in body frames"){
+    YogaConfiguration default_config("");
+    REQUIRE_FALSE(default_config.shouldKeepBodyFrameSearchStructures());
+    YogaConfiguration config("body-frame-search-structures");
+    REQUIRE(config.shouldKeepBodyFrameSearchStructures());
+}
+
+TEST_CASE("set donor search thread count"){
+    YogaConfiguration default_config("");
+    REQUIRE(1 == default_config.donorSearchThreadCount());
+    YogaConfiguration config("donor-search-threads 8");
+    REQUIRE(8 == config.donorSearchThreadCount());
+    YogaConfiguration bad_config("donor-search-threads 0");
+    REQUIRE(1 == bad_config.donorSearchThreadCount());
+}
+
+TEST_CASE("select distributed hole map"){
+    YogaConfiguration default_config("");
+    REQUIRE_FALSE(default_config.shouldUseDistributedHoleMap());
+    YogaConfiguration config("distributed-hole-map");
+    REQUIRE(config.shouldUseDistributedHoleMap());
+}
+
+TEST_CASE("select pipelined donor search"){
+    YogaConfiguration default_config("");
+    REQUIRE_FALSE(default_config.shouldPipelineDonorSearch());
+    YogaConfiguration config("pipelined-donor-search");
+    REQUIRE(config.shouldPipelineDonorSearch());
+}
+
+TEST_CASE("defer status counts in quiet type assignment"){
+    YogaConfiguration default_config("");
+    REQUIRE_FALSE(default_config.shouldDeferStatusCounts());
+    YogaConfiguration config("quiet-type-assignment");
+    REQUIRE(config.shouldDeferStatusCounts());
+}
@@ -215,7 +215,7 @@ class AssembleCommand : public inf::SubCommand{
         DcifWriter dcif_writer(mp);
 
         DomainConnectivityInfo<double> dci(mp, yoga.mesh, yoga.node_statuses, yoga.receptors);
-        dcif_writer.exportDcif(filename,yoga.mesh, dci);
+        dcif_writer.exportDcifCollectively(filename,yoga.mesh, dci);
     }
 };
 
@@ -0,0 +1,87 @@
+#include <parfait/Throw.h>
+#include <parfait/Timing.h>
+#include <t-infinity/SubCommand.h>
+#include <random>
+#include <ExchangeBasedAssembly.h>
+
+class DonorSearchProfilingCommand : public inf::SubCommand {
+  public:
+    std::string description() const override {
+        return "Profile the fragment donor search with and without Morton ordered query points";
+    }
+
+    Parfait::CommandLineMenu menu() const override {
+        Parfait::CommandLineMenu m;
+        m.addParameter({"--cells", "-n"}, "hexes per side of the donor block", false, "60");
+        m.addParameter({"--queries", "-q"}, "random query points", false, "1000000");
+        return m;
+    }
+
+    void run(Parfait::CommandLineMenu m, MessagePasser mp) override {
+        int n = m.getInt("--cells");
+        std::map<int, YOGA::VoxelFragment> fragments;
+        fragments[mp.Rank()] = createHexBlock(n);
+
+        std::vector<YOGA::TransferNode> query_points(m.getInt("--queries"));
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> coordinate(0.0, 1.0);
+        for (size_t i = 0; i < query_points.size(); i++) {
+            Parfait::Point<double> p{coordinate(gen), coordinate(gen), coordinate(gen)};
+            query_points[i] = YOGA::TransferNode(long(i), p, 0.0, 0, mp.Rank());
+        }
+
+        YOGA::FragmentDonorFinder plain_finder(fragments);
+        auto start_plain = Parfait::Now();
+        auto plain = plain_finder.generateCandidateReceptors(query_points);
+        auto end_plain = Parfait::Now();
+
+        YOGA::FragmentDonorFinder ordered_finder(fragments);
+        ordered_finder.setMortonOrdering(true);
+        auto start_ordered = Parfait::Now();
+        auto ordered = ordered_finder.generateCandidateReceptors(query_points);
+        auto end_ordered = Parfait::Now();
+
+        PARFAIT_ASSERT(plain.size() == ordered.size(), "Morton ordered search found a different number of receptors");
+        for (size_t i = 0; i < plain.size(); i++)
+            PARFAIT_ASSERT(plain[i].globalId == ordered[i].globalId, "Morton ordered search changed receptor order");
+
+        mp_rootprint("Donor hexes:          %d\n", n * n * n);
+        mp_rootprint("Query points:         %lu\n", query_points.size());
+        auto report = [&](const char* name, double seconds) {
+            double max_seconds = mp.ParallelMax(seconds);
+            double avg_seconds = mp.ParallelAverage(seconds);
+            mp_rootprint("%-21s max %.3f s, avg %.3f s\n", name, max_seconds, avg_seconds);
+        };
+        report("Query order:", Parfait::elapsedTimeInSeconds(start_plain, end_plain));
+        report("Morton order:", Parfait::elapsedTimeInSeconds(start_ordered, end_ordered));
+    }
+
+  private:
+    static YOGA::VoxelFragment createHexBlock(int n) {
+        YOGA::VoxelFragment fragment;
+        auto node_id = [=](int i, int j, int k) { return i + (n + 1) * (j + (n + 1) * k); };
+        double h = 1.0 / n;
+        long gid = 0;
+        for (int k = 0; k <= n; k++)
+            for (int j = 0; j <= n; j++)
+                for (int i = 0; i <= n; i++)
+                    fragment.transferNodes.push_back(YOGA::TransferNode(gid++, {i * h, j * h, k * h}, 1.0, 1, 0));
+        int cell_id = 0;
+        for (int k = 0; k < n; k++)
+            for (int j = 0; j < n; j++)
+                for (int i = 0; i < n; i++) {
+                    std::array<int, 8> hex = {node_id(i, j, k),
+                                              node_id(i + 1, j, k),
+                                              node_id(i + 1, j + 1, k),
+                                              node_id(i, j + 1, k),
+                                              node_id(i, j, k + 1),
+                                              node_id(i + 1, j, k + 1),
+                                              node_id(i + 1, j + 1, k + 1),
+                                              node_id(i, j + 1, k + 1)};
+                    fragment.transferHexs.push_back(YOGA::TransferCell<8>(hex, cell_id++, 0));
+                }
+        return fragment;
+    }
+};
+
+CREATE_INF_SUBCOMMAND(DonorSearchProfilingCommand)
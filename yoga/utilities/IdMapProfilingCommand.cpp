@@ -0,0 +1,97 @@
+#include <parfait/Throw.h>
+#include <parfait/Timing.h>
+#include <t-infinity/CartMesh.h>
+#include <t-infinity/Shortcuts.h>
+#include <t-infinity/SubCommand.h>
+#include <Tracer.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <IdMap.h>
+
+class IdMapProfilingCommand : public inf::SubCommand {
+  public:
+    std::string description() const override {
+        return "Profile global-to-local id maps: std::map vs the flat IdMap";
+    }
+
+    Parfait::CommandLineMenu menu() const override {
+        Parfait::CommandLineMenu m;
+        m.addParameter({"--mesh", "-m"}, "use the global node ids of this mesh's partitions", false);
+        m.addParameter({"--cells", "-n"}, "cells per side of a generated cube mesh when no mesh is given", false, "100");
+        m.addParameter({"--lookups"}, "lookups per node, in random order", false, "4");
+        return m;
+    }
+
+    void run(Parfait::CommandLineMenu m, MessagePasser mp) override {
+        std::shared_ptr<inf::MeshInterface> mesh;
+        if (m.has("--mesh")) {
+            mesh = inf::shortcut::loadMesh(mp, m.get("--mesh"));
+        } else {
+            int n = m.getInt("--cells");
+            mesh = inf::CartMesh::createVolume(mp, n, n, n);
+        }
+        std::vector<long> gids(mesh->nodeCount());
+        for (int i = 0; i < mesh->nodeCount(); i++) gids[i] = mesh->globalNodeId(i);
+        mesh.reset();
+
+        std::vector<long> queries;
+        for (int pass = 0; pass < m.getInt("--lookups"); pass++) queries.insert(queries.end(), gids.begin(), gids.end());
+        std::shuffle(queries.begin(), queries.end(), std::mt19937(42));
+
+        auto tree_memory_before = Tracer::usedMemoryMB();
+        auto start_tree = Parfait::Now();
+        std::map<long, int> tree;
+        for (size_t i = 0; i < gids.size(); i++) tree[gids[i]] = int(i);
+        auto end_tree = Parfait::Now();
+        auto tree_memory = long(Tracer::usedMemoryMB()) - long(tree_memory_before);
+        long tree_sum = 0;
+        for (long gid : queries) tree_sum += tree.at(gid);
+        auto end_tree_lookups = Parfait::Now();
+
+        auto flat_memory_before = Tracer::usedMemoryMB();
+        auto start_flat = Parfait::Now();
+        YOGA::IdMap flat(gids.size());
+        for (size_t i = 0; i < gids.size(); i++) flat[gids[i]] = int(i);
+        auto end_flat = Parfait::Now();
+        auto flat_memory = long(Tracer::usedMemoryMB()) - long(flat_memory_before);
+        long flat_sum = 0;
+        for (long gid : queries) flat_sum += flat.at(gid);
+        auto end_flat_lookups = Parfait::Now();
+
+        PARFAIT_ASSERT(tree_sum == flat_sum,
+                       "Lookups differ: " + std::to_string(tree_sum) + " vs " + std::to_string(flat_sum));
+
+        long total_nodes = mp.ParallelSum(long(gids.size()));
+        mp_rootprint("Nodes:                %ld over %d ranks\n", total_nodes, mp.NumberOfProcesses());
+        mp_rootprint("Lookups per rank:     %lu\n", queries.size());
+        mp_rootprint("IdMap table bytes:    %lu on rank 0 (%.1f per node)\n",
+                     flat.bytes(),
+                     double(flat.bytes()) / std::max(size_t(1), gids.size()));
+
+        auto report = [&](const char* name, double build, double lookups, long memory_mb) {
+            double max_build = mp.ParallelMax(build);
+            double avg_build = mp.ParallelAverage(build);
+            double max_lookups = mp.ParallelMax(lookups);
+            double avg_lookups = mp.ParallelAverage(lookups);
+            long max_memory_mb = mp.ParallelMax(memory_mb);
+            mp_rootprint("%-9s build max %.3f s avg %.3f s, lookups max %.3f s avg %.3f s, ~%ld MB max\n",
+                         name,
+                         max_build,
+                         avg_build,
+                         max_lookups,
+                         avg_lookups,
+                         max_memory_mb);
+        };
+        report("std::map",
+               Parfait::elapsedTimeInSeconds(start_tree, end_tree),
+               Parfait::elapsedTimeInSeconds(end_tree, end_tree_lookups),
+               tree_memory);
+        report("IdMap",
+               Parfait::elapsedTimeInSeconds(start_flat, end_flat),
+               Parfait::elapsedTimeInSeconds(end_flat, end_flat_lookups),
+               flat_memory);
+    }
+};
+
+CREATE_INF_SUBCOMMAND(IdMapProfilingCommand)
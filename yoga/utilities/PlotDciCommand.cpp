@@ -1,7 +1,7 @@
 #include <stdio.h>
 #include <t-infinity/SubCommand.h>
 #include <t-infinity/CommonAliases.h>
-#include "DcifReader.h"
+#include "DcifParallelIO.h"
 #include "DcifChecker.h"
 #include <parfait/UgridReader.h>
 #include <t-infinity/Shortcuts.h>
@@ -31,26 +31,25 @@ class PlotDciCommand : public SubCommand {
         auto grid_filename = m.get(inf::Alias::mesh());
         auto mesh = inf::shortcut::loadMesh(mp,grid_filename);
 
-        auto fun3d_dci = std::make_shared<Dcif::FlattenedDomainConnectivity>(0);
         std::shared_ptr<SuggarDciReader> suggar_dci = nullptr;
-        std::vector<int> global_iblank_on_root;
         std::vector<long> grid_node_id_offsets;
-        long total_receptors=0;
-        std::function<std::vector<Dcif::Receptor>(long,long)> getReceptorsInRange;
+        std::vector<Dcif::Receptor> resident_receptors;
+        std::vector<int> resident_iblank;
         long global_node_count=0;
         auto filename = m.get(Alias::inputFile());
         auto extension = Parfait::StringTools::getExtension(filename);
         if("dcif" == extension) {
             importFromDcif(filename,
                            mp,
-                           fun3d_dci,
                            mesh,
-                           global_iblank_on_root,
+                           resident_iblank,
                            grid_node_id_offsets,
-                           total_receptors,
-                           getReceptorsInRange,
+                           resident_receptors,
                            global_node_count);
         }else if("dci" == extension){
+            std::vector<int> global_iblank_on_root;
+            long total_receptors=0;
+            std::function<std::vector<Dcif::Receptor>(long,long)> getReceptorsInRange;
             importFromSuggarDci(filename,
                                 mp,
                                 suggar_dci,
@@ -60,14 +59,13 @@ class PlotDciCommand : public SubCommand {
                                 total_receptors,
                                 getReceptorsInRange,
                                 global_node_count);
+            resident_receptors = naivelyPartitionReceptors(mp, getReceptorsInRange, total_receptors, global_node_count);
+            resident_iblank = naivelyPartitionNodeStatuses(mp, global_iblank_on_root, global_node_count);
         }
         else{
             throw std::logic_error("Unexpected file extension: "+extension);
         }
 
-        auto resident_receptors = naivelyPartitionReceptors(mp, getReceptorsInRange, total_receptors, global_node_count);
-        auto resident_iblank = naivelyPartitionNodeStatuses(mp, global_iblank_on_root, global_node_count);
-
         auto node_statuses = transferNodeStatusesToOwners(mp, global_node_count, resident_iblank, mesh);
 
         auto my_receptors = transferReceptorsToOwners(mp, mesh, global_node_count, resident_receptors, node_statuses);
@@ -83,33 +81,19 @@ class PlotDciCommand : public SubCommand {
     }
     void importFromDcif(const std::string& filename,
                         MessagePasser& mp,
-                        std::shared_ptr<Dcif::FlattenedDomainConnectivity>& dcif,
                         std::shared_ptr<inf::MeshInterface>& mesh,
-                        std::vector<int>& global_iblank_on_root,
+                        std::vector<int>& resident_iblank,
                         std::vector<long>& grid_node_id_offsets,
-                        long& total_receptors,
-                        std::function<std::vector<Dcif::Receptor>(long, long)>& getReceptorsInRange,
+                        std::vector<Dcif::Receptor>& resident_receptors,
                         long& global_node_count) {
         global_node_count= globalNodeCount(mp,*mesh);
-        std::shared_ptr<DcifReader> dcif_reader = nullptr;
-        if(0 == mp.Rank()) {
-            dcif_reader = std::make_shared<DcifReader>(filename);
-            dcif = std::make_shared<Dcif::FlattenedDomainConnectivity>(dcif_reader->gridCount());
-            dcif->setReceptorIds(dcif_reader->getFringeIds());
-            dcif->setDonorCounts(dcif_reader->getDonorCounts());
-            dcif->setDonorIds(dcif_reader->getDonorIds());
-            dcif->setDonorWeights(dcif_reader->getDonorWeights());
-            dcif->setIBlank(dcif_reader->getIblank());
-            global_iblank_on_root = dcif->getIblank();
-        }
-        auto header = getDcifHeader(mp,dcif_reader);
-        total_receptors = header.nfringes;
-        grid_node_id_offsets = header.grid_node_id_offsets;
-        PARFAIT_ASSERT(global_node_count == header.nnodes, "Dcif nnodes doesn't match grid");
-
-        getReceptorsInRange = [&](long a,long b){
-            return Dcif::getChunkOfReceptors(*dcif,a, b);
-        };
+        if(0 == mp.Rank())
+            printf("Reading %s in parallel\n", filename.c_str());
+        Dcif::SliceReader reader(mp, filename);
+        PARFAIT_ASSERT(global_node_count == reader.globalNodeCount(), "Dcif nnodes doesn't match grid");
+        grid_node_id_offsets = reader.gridNodeIdOffsets();
+        resident_iblank.assign(reader.iblank().begin(), reader.iblank().end());
+        resident_receptors = Dcif::redistributeReceptorsByGid(mp, reader.receptors(), global_node_count);
     }
     void importFromSuggarDci(std::string filename,
                              MessagePasser mp,
@@ -207,35 +191,6 @@ class PlotDciCommand : public SubCommand {
     }
 
   private:
-    struct DcifHeader{
-        long nnodes;
-        long nfringes;
-        long ndonors;
-        int ngrids;
-        std::vector<long> grid_node_id_offsets;
-    };
-
-    DcifHeader getDcifHeader(MessagePasser mp, std::shared_ptr<DcifReader> reader) {
-        DcifHeader header;
-        if(0 == mp.Rank()){
-            header.nnodes = reader->globalNodeCount();
-            header.nfringes = reader->receptorCount();
-            header.ndonors = reader->donorCount();
-            header.ngrids = reader->gridCount();
-            header.grid_node_id_offsets.push_back(0);
-            for(int i=0;i<header.ngrids;i++) {
-                auto previous_offset = header.grid_node_id_offsets.back();
-                header.grid_node_id_offsets.push_back(previous_offset+reader->nodeCountForComponentGrid(i));
-            }
-        }
-        mp.Broadcast(header.nnodes,0);
-        mp.Broadcast(header.nfringes,0);
-        mp.Broadcast(header.ndonors,0);
-        mp.Broadcast(header.ngrids,0);
-        mp.Broadcast(header.grid_node_id_offsets,0);
-        return header;
-    }
-
     std::vector<Dcif::Receptor> naivelyPartitionReceptors(
         const MessagePasser& mp,
         std::function<std::vector<Dcif::Receptor>(long,long)> getReceptorsInRange,